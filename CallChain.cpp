@@ -0,0 +1,134 @@
+/*
+ * CallChain.cpp
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ */
+
+#include "CallChain.h"
+
+
+
+//------------------------------------------------------------------------------------
+//-- PUBLIC METHODS IMPLEMENTATION ---------------------------------------------------
+//------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------
+CallChain::CallChain() : _head(NULL), _size(0), _epoch(0), _waits(0) {
+	_readers[0] = 0;
+	_readers[1] = 0;
+	vPortCPUInitializeMutex(&_mux);
+}
+
+
+//------------------------------------------------------------------------------------
+CallChain::~CallChain() {
+	// el propietario de la cadena garantiza que ya no se dispara
+	portENTER_CRITICAL(&_mux);
+	Link* link = _head;
+	_head = NULL;
+	_size = 0;
+	while(link){
+		Link* next = link->next;
+		link->next = NULL;
+		link->chain = NULL;
+		link = next;
+	}
+	portEXIT_CRITICAL(&_mux);
+}
+
+
+//------------------------------------------------------------------------------------
+bool CallChain::add(Link* link) {
+	MBED_ASSERT(!IS_ISR());
+	if(!link || !link->func){
+		return false;
+	}
+	portENTER_CRITICAL(&_mux);
+	if(link->chain){
+		portEXIT_CRITICAL(&_mux);
+		return false;
+	}
+	link->chain = this;
+	link->next = NULL;
+	// el eslabón se inicia antes de publicarlo: un recorrido lo encuentra completo o no lo encuentra
+	Link* volatile* last = &_head;
+	while(*last){
+		last = &(*last)->next;
+	}
+	__atomic_store_n(last, link, __ATOMIC_SEQ_CST);
+	_size = _size + 1;
+	portEXIT_CRITICAL(&_mux);
+	return true;
+}
+
+
+//------------------------------------------------------------------------------------
+bool CallChain::remove(Link* link) {
+	MBED_ASSERT(!IS_ISR());
+	portENTER_CRITICAL(&_mux);
+	if(!link || link->chain != this){
+		portEXIT_CRITICAL(&_mux);
+		return false;
+	}
+	Link* volatile* prev = &_head;
+	while(*prev != link){
+		prev = &(*prev)->next;
+	}
+	// se desenlaza manteniendo su 'next', por el que continúan los recorridos que estén sobre él
+	__atomic_store_n(prev, link->next, __ATOMIC_SEQ_CST);
+	_size = _size - 1;
+	portEXIT_CRITICAL(&_mux);
+
+	// periodo de gracia: ningún recorrido posterior lo alcanza, y se espera a los que han podido alcanzarlo
+	synchronize();
+	link->next = NULL;
+	link->chain = NULL;
+	return true;
+}
+
+
+//------------------------------------------------------------------------------------
+void CallChain::call() {
+	// el recorrido se registra en la época en curso. Un remove() que no lo vea en su contador ya había desenlazado
+	// su eslabón antes de este registro, por lo que el recorrido no lo encuentra
+	uint32_t idx = __atomic_load_n(&_epoch, __ATOMIC_SEQ_CST) & 1;
+	__atomic_add_fetch(&_readers[idx], 1, __ATOMIC_SEQ_CST);
+	for(Link* link = __atomic_load_n(&_head, __ATOMIC_SEQ_CST); link; link = __atomic_load_n(&link->next, __ATOMIC_SEQ_CST)){
+		link->func.call();
+	}
+	__atomic_sub_fetch(&_readers[idx], 1, __ATOMIC_SEQ_CST);
+}
+
+
+
+//------------------------------------------------------------------------------------
+//-- PRIVATE METHODS IMPLEMENTATION --------------------------------------------------
+//------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------
+void CallChain::synchronize() {
+	// basta con que cada contador se vacíe en algún momento posterior al desenlace. El cambio de época dirige los
+	// nuevos recorridos al otro contador, para que el que se espera no se realimente
+	uint32_t idx = __atomic_add_fetch(&_epoch, 1, __ATOMIC_SEQ_CST) & 1;
+	waitReaders(idx ^ 1);
+	waitReaders(idx);
+}
+
+
+//------------------------------------------------------------------------------------
+void CallChain::waitReaders(uint32_t idx) {
+	int spins = 0;
+	while(__atomic_load_n(&_readers[idx], __ATOMIC_SEQ_CST) != 0){
+		// los recorridos desde ISR terminan enseguida. Uno desde un thread de menor prioridad en este core
+		// necesita que se le ceda el procesador
+		if(++spins < GraceSpins || xTaskGetSchedulerState() != taskSCHEDULER_RUNNING){
+			continue;
+		}
+		_waits = _waits + 1;
+		vTaskDelay(1);
+	}
+}
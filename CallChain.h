@@ -0,0 +1,129 @@
+/*
+ * CallChain.h
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ *	Cadena intrusiva de callbacks para notificar un mismo evento a varios observadores (InterruptIn, Ticker,
+ *	RawSerial, Serial), sin reservas de memoria ni callbacks envoltorio encadenadas a mano.
+ *
+ *	Los eslabones (CallChain::Link) los aporta el observador. Se añaden y se eliminan desde threads mientras el
+ *	evento se dispara desde una ISR u otro thread: el recorrido no toma ningún lock (lectura tipo RCU) y la
+ *	eliminación espera a que terminen los recorridos en curso antes de devolver el eslabón a su propietario.
+ *
+ */
+
+#ifndef MBED_CALLCHAIN_H
+#define MBED_CALLCHAIN_H
+
+#include "mbed_api.h"
+
+
+/** The CallChain class calls, in order, a chain of callbacks linked by their owners.
+ *
+ * Links are intrusive: the observer keeps the CallChain::Link alive while it is added, so adding and removing
+ * never allocate. call() may run in an ISR or in any thread concurrently with add() and remove(): it walks the
+ * chain without locks, and remove() returns once every walk that could still reach the link has finished.
+ * @code
+ * CallChain::Link log_link(callback(&logger, &Logger::onPulse));
+ * CallChain::Link led_link(callback(&led, &Led::toggle));
+ * InterruptIn button(GPIO_NUM_0);
+ * button.rise_add(&log_link);
+ * button.rise_add(&led_link);
+ * ...
+ * button.rise_remove(&led_link);		// led_link may be destroyed now
+ * @endcode
+ *
+ * @note Synchronization level: call() is interrupt safe. add() and remove() are thread safe, must not be called
+ * 		 from an ISR, and remove() must not be called from a callback of the same chain
+ */
+class CallChain {
+public:
+
+	/** Eslabón de la cadena, propiedad del observador
+	 */
+	struct Link {
+		Callback<void()> func;		/// Callback a invocar
+		Link* volatile next;		/// Siguiente eslabón
+		CallChain* chain;			/// Cadena en la que está enlazado (NULL si no lo está)
+
+		Link() : next(NULL), chain(NULL) {}
+		Link(Callback<void()> f) : func(f), next(NULL), chain(NULL) {}
+		~Link(){ MBED_ASSERT(chain == NULL); }
+	};
+
+
+	/** Constructor
+	 */
+	CallChain();
+
+
+	/** Destructor. Desenlaza los eslabones que queden en la cadena
+	 */
+	~CallChain();
+
+
+	/** Añade un eslabón al final de la cadena. Es visible para los recorridos que comiencen a continuación
+	 *  @param link Eslabón (no enlazado en ninguna cadena)
+	 *  @return true si se ha añadido
+	 */
+	bool add(Link* link);
+
+
+	/** Elimina un eslabón de la cadena. Al retornar, ningún recorrido en curso lo invoca ni lo referencia
+	 *  @param link Eslabón
+	 *  @return true si estaba en la cadena
+	 */
+	bool remove(Link* link);
+
+
+	/** Invoca en orden las callbacks de la cadena. Apto para ISR
+	 */
+	void call();
+
+
+	/** Invoca en orden las callbacks de la cadena
+	 */
+	void operator()() { call(); }
+
+
+	/** Chequea si la cadena está vacía
+	 *  @return true si no hay eslabones
+	 */
+	bool empty() const { return (_head == NULL); }
+
+
+	/** Obtiene el número de eslabones
+	 *  @return Eslabones
+	 */
+	int size() const { return _size; }
+
+
+	/** Número de esperas de remove() que han cedido el procesador a un recorrido en curso */
+	uint32_t waits() const { return _waits; }
+
+private:
+	/** Número de sondeos activos de los recorridos en curso antes de ceder el procesador en remove() */
+	static const int GraceSpins = 64;
+
+	Link* volatile _head;				/// Primer eslabón
+	volatile int _size;					/// Eslabones enlazados
+	volatile uint32_t _epoch;			/// Época de lectura en curso (su bit 0 selecciona el contador)
+	volatile uint32_t _readers[2];		/// Recorridos en curso en cada época
+	volatile uint32_t _waits;			/// Esperas de remove() con cesión del procesador
+	portMUX_TYPE _mux;					/// Spinlock de las modificaciones de la cadena
+
+	/** Espera a que terminen todos los recorridos que han podido comenzar antes de la llamada
+	 */
+	void synchronize();
+
+	/** Espera a que se vacíe un contador de recorridos
+	 *  @param idx Índice del contador
+	 */
+	void waitReaders(uint32_t idx);
+};
+
+
+#endif
+
+/** @}*/
@@ -48,6 +48,25 @@ do {                                                     	\
 #endif
 
 
+/** Inline storage of a Callback, in pointers (2..4). Function objects up to this size (for instance lambdas capturing
+ *  up to MBED_CALLBACK_INLINE_WORDS pointers) are stored inside the Callback. The storage is never smaller than a
+ *  bound member function (member function pointer plus object pointer, 3 pointers on this ABI), so the default keeps
+ *  the size of the previous, hand-expanded Callback.
+ */
+#if !defined(MBED_CALLBACK_INLINE_WORDS)
+#define MBED_CALLBACK_INLINE_WORDS		3
+#endif
+
+/** Enables (1) storing on the heap the function objects that do not fit in the inline storage. Disabled by default,
+ *  in which case they are rejected at compile time.
+ */
+#if !defined(MBED_CALLBACK_HEAP_FALLBACK)
+#define MBED_CALLBACK_HEAP_FALLBACK		0
+#endif
+
+static_assert(MBED_CALLBACK_INLINE_WORDS >= 2 && MBED_CALLBACK_INLINE_WORDS <= 4, "MBED_CALLBACK_INLINE_WORDS debe estar entre 2 y 4");
+
+
 /** Callback class based on template specialization
  *
  * @note Synchronization level: Not protected
@@ -59,7 +78,7 @@ class Callback;
 //
 // These are used to eliminate overloads based on type attributes
 // 1. Does a function object have a call operator
-// 2. Does a function object fit in the available storage
+// 2. Is the function object a Callback itself (copy and move constructors must be used instead)
 //
 // These eliminations are handled cleanly by the compiler and avoid
 // massive and misleading error messages when confronted with an
@@ -77,25 +96,66 @@ namespace detail {
     struct is_type {
         static const bool value = true;
     };
+
+    template <typename T>
+    struct is_callback { static const bool value = false; };
+
+    template <typename F>
+    struct is_callback<Callback<F> > { static const bool value = true; };
+
+    template <bool B>
+    struct bool_type {};
+
+    // Minimal <type_traits>/<utility> subset, to keep this header cheap to include
+    template <typename T> struct remove_reference { typedef T type; };
+    template <typename T> struct remove_reference<T&> { typedef T type; };
+    template <typename T> struct remove_reference<T&&> { typedef T type; };
+
+    template <typename T> struct remove_cv { typedef T type; };
+    template <typename T> struct remove_cv<const T> { typedef T type; };
+    template <typename T> struct remove_cv<volatile T> { typedef T type; };
+    template <typename T> struct remove_cv<const volatile T> { typedef T type; };
+
+    template <typename T>
+    inline T&& forward(typename remove_reference<T>::type &t) { return static_cast<T&&>(t); }
+
+    template <typename T>
+    inline typename remove_reference<T>::type&& move(T &&t) { return static_cast<typename remove_reference<T>::type&&>(t); }
+
+    // Signature of a function object's call operator, used by callback(F)
+    template <typename M>
+    struct method_signature;
+
+    template <typename F, typename R, typename... ArgTs>
+    struct method_signature<R (F::*)(ArgTs...)> { typedef R type(ArgTs...); };
+
+    template <typename F, typename R, typename... ArgTs>
+    struct method_signature<R (F::*)(ArgTs...) const> { typedef R type(ArgTs...); };
+
+    template <typename F, typename R, typename... ArgTs>
+    struct method_signature<R (F::*)(ArgTs...) volatile> { typedef R type(ArgTs...); };
+
+    template <typename F, typename R, typename... ArgTs>
+    struct method_signature<R (F::*)(ArgTs...) const volatile> { typedef R type(ArgTs...); };
 }
 
 #define MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, M)                            \
     typename detail::enable_if<                                             \
             detail::is_type<M, &F::operator()>::value &&                    \
-            sizeof(F) <= sizeof(uintptr_t)                                  \
+            !detail::is_callback<F>::value                                  \
         >::type = detail::nil()
 
 /** Callback class based on template specialization
  *
  * @note Synchronization level: Not protected
  */
-template <typename R>
-class Callback<R()> {
+template <typename R, typename... ArgTs>
+class Callback<R(ArgTs...)> {
 public:
     /** Create a Callback with a static function
      *  @param func     Static function to attach
      */
-    Callback(R (*func)() = 0) {
+    Callback(R (*func)(ArgTs...) = 0) {
         if (!func) {
             memset(this, 0, sizeof(Callback));
         } else {
@@ -106,11 +166,24 @@ public:
     /** Attach a Callback
      *  @param func     The Callback to attach
      */
-    Callback(const Callback<R()> &func) {
+    Callback(const Callback &func) {
+        memset(this, 0, sizeof(Callback));
+        if (func._ops) {
+            func._ops->copy(&_storage, &func._storage);
+        }
+        _ops = func._ops;
+    }
+
+    /** Move a Callback. The source is left empty
+     *  @param func     The Callback to move
+     */
+    Callback(Callback &&func) {
+        memset(this, 0, sizeof(Callback));
         if (func._ops) {
-            func._ops->move(this, &func);
+            func._ops->move(&_storage, &func._storage);
         }
         _ops = func._ops;
+        func.clear();
     }
 
     /** Create a Callback with a member function
@@ -118,8 +191,8 @@ public:
      *  @param method   Member function to attach
      */
     template<typename T, typename U>
-    Callback(U *obj, R (T::*method)()) {
-        generate(method_context<T, R (T::*)()>(obj, method));
+    Callback(U *obj, R (T::*method)(ArgTs...)) {
+        generate(method_context<T, R (T::*)(ArgTs...)>(obj, method));
     }
 
     /** Create a Callback with a member function
@@ -127,8 +200,8 @@ public:
      *  @param method   Member function to attach
      */
     template<typename T, typename U>
-    Callback(const U *obj, R (T::*method)() const) {
-        generate(method_context<const T, R (T::*)() const>(obj, method));
+    Callback(const U *obj, R (T::*method)(ArgTs...) const) {
+        generate(method_context<const T, R (T::*)(ArgTs...) const>(obj, method));
     }
 
     /** Create a Callback with a member function
@@ -136,8 +209,8 @@ public:
      *  @param method   Member function to attach
      */
     template<typename T, typename U>
-    Callback(volatile U *obj, R (T::*method)() volatile) {
-        generate(method_context<volatile T, R (T::*)() volatile>(obj, method));
+    Callback(volatile U *obj, R (T::*method)(ArgTs...) volatile) {
+        generate(method_context<volatile T, R (T::*)(ArgTs...) volatile>(obj, method));
     }
 
     /** Create a Callback with a member function
@@ -145,8 +218,8 @@ public:
      *  @param method   Member function to attach
      */
     template<typename T, typename U>
-    Callback(const volatile U *obj, R (T::*method)() const volatile) {
-        generate(method_context<const volatile T, R (T::*)() const volatile>(obj, method));
+    Callback(const volatile U *obj, R (T::*method)(ArgTs...) const volatile) {
+        generate(method_context<const volatile T, R (T::*)(ArgTs...) const volatile>(obj, method));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -154,8 +227,8 @@ public:
      *  @param arg      Pointer argument to function
      */
     template<typename T, typename U>
-    Callback(R (*func)(T*), U *arg) {
-        generate(function_context<R (*)(T*), T>(func, arg));
+    Callback(R (*func)(T*, ArgTs...), U *arg) {
+        generate(function_context<R (*)(T*, ArgTs...), T>(func, arg));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -163,8 +236,8 @@ public:
      *  @param arg      Pointer argument to function
      */
     template<typename T, typename U>
-    Callback(R (*func)(const T*), const U *arg) {
-        generate(function_context<R (*)(const T*), const T>(func, arg));
+    Callback(R (*func)(const T*, ArgTs...), const U *arg) {
+        generate(function_context<R (*)(const T*, ArgTs...), const T>(func, arg));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -172,8 +245,8 @@ public:
      *  @param arg      Pointer argument to function
      */
     template<typename T, typename U>
-    Callback(R (*func)(volatile T*), volatile U *arg) {
-        generate(function_context<R (*)(volatile T*), volatile T>(func, arg));
+    Callback(R (*func)(volatile T*, ArgTs...), volatile U *arg) {
+        generate(function_context<R (*)(volatile T*, ArgTs...), volatile T>(func, arg));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -181,56 +254,54 @@ public:
      *  @param arg      Pointer argument to function
      */
     template<typename T, typename U>
-    Callback(R (*func)(const volatile T*), const volatile U *arg) {
-        generate(function_context<R (*)(const volatile T*), const volatile T>(func, arg));
+    Callback(R (*func)(const volatile T*, ArgTs...), const volatile U *arg) {
+        generate(function_context<R (*)(const volatile T*, ArgTs...), const volatile T>(func, arg));
     }
 
-    /** Create a Callback with a function object
+    /** Create a Callback with a function object, such as a capturing lambda
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is stored inline if it fits in MBED_CALLBACK_INLINE_WORDS pointers
      */
     template <typename F>
-    Callback(F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)())) {
-        generate(f);
+    Callback(F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(ArgTs...))) {
+        generate(detail::move(f));
     }
 
-    /** Create a Callback with a function object
+    /** Create a Callback with a function object, such as a capturing lambda
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is stored inline if it fits in MBED_CALLBACK_INLINE_WORDS pointers
      */
     template <typename F>
-    Callback(const F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)() const)) {
+    Callback(const F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(ArgTs...) const)) {
         generate(f);
     }
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is stored inline if it fits in MBED_CALLBACK_INLINE_WORDS pointers
      */
     template <typename F>
-    Callback(volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)() volatile)) {
+    Callback(volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(ArgTs...) volatile)) {
         generate(f);
     }
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is stored inline if it fits in MBED_CALLBACK_INLINE_WORDS pointers
      */
     template <typename F>
-    Callback(const volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)() const volatile)) {
+    Callback(const volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(ArgTs...) const volatile)) {
         generate(f);
     }
 
-
     /** Destroy a callback
      */
     ~Callback() {
         if (_ops) {
-            _ops->dtor(this);
+            _ops->dtor(&_storage);
         }
     }
 
-
     /** Assign a callback
      */
     Callback &operator=(const Callback &that) {
@@ -242,17 +313,28 @@ public:
         return *this;
     }
 
+    /** Move a callback. The source is left empty
+     */
+    Callback &operator=(Callback &&that) {
+        if (this != &that) {
+            this->~Callback();
+            new (this) Callback(detail::move(that));
+        }
+
+        return *this;
+    }
+
     /** Call the attached function
      */
-    R call() const {
+    R call(ArgTs... args) const {
         MBED_ASSERT(_ops);
-        return _ops->call(this);
+        return _ops->call(&_storage, detail::forward<ArgTs>(args)...);
     }
 
     /** Call the attached function
      */
-    R operator()() const {
-        return call();
+    R operator()(ArgTs... args) const {
+        return call(detail::forward<ArgTs>(args)...);
     }
 
     /** Test if function has been attached
@@ -261,10 +343,20 @@ public:
         return _ops;
     }
 
-    /** Test for equality
+    /** Test if the function object is stored on the heap (MBED_CALLBACK_HEAP_FALLBACK). Copying such a Callback
+     *  allocates memory, so it must not be copied from an ISR or while holding a spinlock
+     */
+    bool heap_allocated() const {
+        return _ops && _ops->heap;
+    }
+
+    /** Test for equality. Function objects stored on the heap are compared by content, so copies compare equal
      */
     friend bool operator==(const Callback &l, const Callback &r) {
-        return memcmp(&l, &r, sizeof(Callback)) == 0;
+        if (l._ops != r._ops) {
+            return false;
+        }
+        return !l._ops || l._ops->equal(&l._storage, &r._storage);
     }
 
     /** Test for inequality
@@ -275,339 +367,144 @@ public:
 
     /** Static thunk for passing as C-style function
      *  @param func Callback to call passed as void pointer
+     *  @param args Arguments to be called with function func
      *  @return the value as determined by func which is of
-     *      type and determined by the signiture of func
+     *      type and determined by the signature of func
      */
-    static R thunk(void *func) {
-        return static_cast<Callback*>(func)->call();
+    static R thunk(void *func, ArgTs... args) {
+        return static_cast<Callback*>(func)->call(detail::forward<ArgTs>(args)...);
     }
 
 private:
-    // Stored as pointer to function and pointer to optional object
-    // Function pointer is stored as union of possible function types
-    // to garuntee proper size and alignment
+    // Inline storage for the function object. The union of the possible function types guarantees proper size and
+    // alignment for plain and bound functions, member functions and small function objects
     struct _class;
-    union {
-        void (*_staticfunc)();
-        void (*_boundfunc)(_class*);
-        void (_class::*_methodfunc)();
-    } _func;
-    void *_obj;
+    union Storage {
+        void (*_staticfunc)(ArgTs...);
+        void (*_boundfunc)(_class*, ArgTs...);
+        struct {
+            void (_class::*_methodfunc)(ArgTs...);
+            void *_obj;
+        } _method;
+        void *_words[MBED_CALLBACK_INLINE_WORDS];
+    } _storage;
 
     // Dynamically dispatched operations
     const struct ops {
-        R (*call)(const void*);
-        void (*move)(void*, const void*);
+        R (*call)(const void*, ArgTs...);
+        void (*copy)(void*, const void*);
+        void (*move)(void*, void*);
         void (*dtor)(void*);
+        bool (*equal)(const void*, const void*);
+        bool heap;
     } *_ops;
 
-    // Generate operations for function object
-    template <typename F>
-    void generate(const F &f) {
-        static const ops ops = {
-            &Callback::function_call<F>,
-            &Callback::function_move<F>,
-            &Callback::function_dtor<F>,
-        };
-
-        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) >= sizeof(F),
-                "Type F must not exceed the size of the Callback class");
+    // Destroy the function object (or what is left of it after a move) and leave the Callback empty
+    void clear() {
+        if (_ops) {
+            _ops->dtor(&_storage);
+        }
         memset(this, 0, sizeof(Callback));
-        new (this) F(f);
-        _ops = &ops;
-    }
-
-    // Function attributes
-    template <typename F>
-    static R function_call(const void *p) {
-        return (*(F*)p)();
-    }
-
-    template <typename F>
-    static void function_move(void *d, const void *p) {
-        new (d) F(*(F*)p);
     }
 
+    // Does the function object fit in the inline storage
     template <typename F>
-    static void function_dtor(void *p) {
-        ((F*)p)->~F();
-    }
-
-    // Wrappers for functions with context
-    template <typename O, typename M>
-    struct method_context {
-        M method;
-        O *obj;
-
-        method_context(O *obj, M method)
-            : method(method), obj(obj) {}
-
-        R operator()() const {
-            return (obj->*method)();
-        }
-    };
-
-    template <typename F, typename A>
-    struct function_context {
-        F func;
-        A *arg;
-
-        function_context(F func, A *arg)
-            : func(func), arg(arg) {}
-
-        R operator()() const {
-            return func(arg);
-        }
+    struct fits_inline {
+        static const bool value = sizeof(F) <= sizeof(Storage) && (alignof(Storage) % alignof(F)) == 0;
     };
-};
-
-/** Callback class based on template specialization
- *
- * @note Synchronization level: Not protected
- */
-template <typename R, typename A0>
-class Callback<R(A0)> {
-public:
-    /** Create a Callback with a static function
-     *  @param func     Static function to attach
-     */
-    Callback(R (*func)(A0) = 0) {
-        if (!func) {
-            memset(this, 0, sizeof(Callback));
-        } else {
-            generate(func);
-        }
-    }
-
-    /** Attach a Callback
-     *  @param func     The Callback to attach
-     */
-    Callback(const Callback<R(A0)> &func) {
-        if (func._ops) {
-            func._ops->move(this, &func);
-        }
-        _ops = func._ops;
-    }
-
-    /** Create a Callback with a member function
-     *  @param obj      Pointer to object to invoke member function on
-     *  @param method   Member function to attach
-     */
-    template<typename T, typename U>
-    Callback(U *obj, R (T::*method)(A0)) {
-        generate(method_context<T, R (T::*)(A0)>(obj, method));
-    }
-
-    /** Create a Callback with a member function
-     *  @param obj      Pointer to object to invoke member function on
-     *  @param method   Member function to attach
-     */
-    template<typename T, typename U>
-    Callback(const U *obj, R (T::*method)(A0) const) {
-        generate(method_context<const T, R (T::*)(A0) const>(obj, method));
-    }
-
-    /** Create a Callback with a member function
-     *  @param obj      Pointer to object to invoke member function on
-     *  @param method   Member function to attach
-     */
-    template<typename T, typename U>
-    Callback(volatile U *obj, R (T::*method)(A0) volatile) {
-        generate(method_context<volatile T, R (T::*)(A0) volatile>(obj, method));
-    }
-
-    /** Create a Callback with a member function
-     *  @param obj      Pointer to object to invoke member function on
-     *  @param method   Member function to attach
-     */
-    template<typename T, typename U>
-    Callback(const volatile U *obj, R (T::*method)(A0) const volatile) {
-        generate(method_context<const volatile T, R (T::*)(A0) const volatile>(obj, method));
-    }
-
-    /** Create a Callback with a static function and bound pointer
-     *  @param func     Static function to attach
-     *  @param arg      Pointer argument to function
-     */
-    template<typename T, typename U>
-    Callback(R (*func)(T*, A0), U *arg) {
-        generate(function_context<R (*)(T*, A0), T>(func, arg));
-    }
 
-    /** Create a Callback with a static function and bound pointer
-     *  @param func     Static function to attach
-     *  @param arg      Pointer argument to function
-     */
-    template<typename T, typename U>
-    Callback(R (*func)(const T*, A0), const U *arg) {
-        generate(function_context<R (*)(const T*, A0), const T>(func, arg));
+    // Generate operations for function object
+    template <typename F>
+    void generate(F &&f) {
+        typedef typename detail::remove_cv<typename detail::remove_reference<F>::type>::type T;
+        memset(this, 0, sizeof(Callback));
+        store<T>(detail::forward<F>(f), detail::bool_type<fits_inline<T>::value>());
     }
 
-    /** Create a Callback with a static function and bound pointer
-     *  @param func     Static function to attach
-     *  @param arg      Pointer argument to function
-     */
-    template<typename T, typename U>
-    Callback(R (*func)(volatile T*, A0), volatile U *arg) {
-        generate(function_context<R (*)(volatile T*, A0), volatile T>(func, arg));
+    // Function object stored inline
+    template <typename T, typename F>
+    void store(F &&f, detail::bool_type<true>) {
+        static const ops ops = {
+            &Callback::function_call<T>,
+            &Callback::function_copy<T>,
+            &Callback::function_move<T>,
+            &Callback::function_dtor<T>,
+            &Callback::function_equal<T>,
+            false,
+        };
+        new (&_storage) T(detail::forward<F>(f));
+        _ops = &ops;
     }
 
-    /** Create a Callback with a static function and bound pointer
-     *  @param func     Static function to attach
-     *  @param arg      Pointer argument to function
-     */
-    template<typename T, typename U>
-    Callback(R (*func)(const volatile T*, A0), const volatile U *arg) {
-        generate(function_context<R (*)(const volatile T*, A0), const volatile T>(func, arg));
+    // Function object stored on the heap
+    template <typename T, typename F>
+    void store(F &&f, detail::bool_type<false>) {
+        static_assert(MBED_CALLBACK_HEAP_FALLBACK && sizeof(F) > 0,
+                "Type F must not exceed MBED_CALLBACK_INLINE_WORDS pointers (or enable MBED_CALLBACK_HEAP_FALLBACK)");
+        static const ops ops = {
+            &Callback::heap_call<T>,
+            &Callback::heap_copy<T>,
+            &Callback::heap_move<T>,
+            &Callback::heap_dtor<T>,
+            &Callback::heap_equal<T>,
+            true,
+        };
+        _storage._words[0] = new T(detail::forward<F>(f));
+        _ops = &ops;
     }
 
-    /** Create a Callback with a function object
-     *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
-     */
+    // Function attributes
     template <typename F>
-    Callback(F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(A0))) {
-        generate(f);
+    static R function_call(const void *p, ArgTs... args) {
+        return (*(F*)p)(detail::forward<ArgTs>(args)...);
     }
 
-    /** Create a Callback with a function object
-     *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
-     */
     template <typename F>
-    Callback(const F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(A0) const)) {
-        generate(f);
+    static void function_copy(void *d, const void *p) {
+        new (d) F(*(const F*)p);
     }
 
-    /** Create a Callback with a function object
-     *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
-     */
     template <typename F>
-    Callback(volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(A0) volatile)) {
-        generate(f);
+    static void function_move(void *d, void *p) {
+        new (d) F(detail::move(*(F*)p));
     }
 
-    /** Create a Callback with a function object
-     *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
-     */
     template <typename F>
-    Callback(const volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(A0) const volatile)) {
-        generate(f);
-    }
-
-
-    /** Destroy a callback
-     */
-    ~Callback() {
-        if (_ops) {
-            _ops->dtor(this);
-        }
-    }
-
-
-    /** Assign a callback
-     */
-    Callback &operator=(const Callback &that) {
-        if (this != &that) {
-            this->~Callback();
-            new (this) Callback(that);
-        }
-
-        return *this;
-    }
-
-    /** Call the attached function
-     */
-    R call(A0 a0) const {
-        MBED_ASSERT(_ops);
-        return _ops->call(this, a0);
-    }
-
-    /** Call the attached function
-     */
-    R operator()(A0 a0) const {
-        return call(a0);
-    }
-
-    /** Test if function has been attached
-     */
-    operator bool() const {
-        return _ops;
-    }
-
-    /** Test for equality
-     */
-    friend bool operator==(const Callback &l, const Callback &r) {
-        return memcmp(&l, &r, sizeof(Callback)) == 0;
+    static void function_dtor(void *p) {
+        ((F*)p)->~F();
     }
 
-    /** Test for inequality
-     */
-    friend bool operator!=(const Callback &l, const Callback &r) {
-        return !(l == r);
+    // la reserva interna se pone a cero antes de construir el objeto, por lo que se compara completa
+    template <typename F>
+    static bool function_equal(const void *p, const void *q) {
+        return memcmp(p, q, sizeof(Storage)) == 0;
     }
 
-    /** Static thunk for passing as C-style function
-     *  @param func Callback to call passed as void pointer
-     *  @param a0 An argument to be called with function func
-     *  @return the value as determined by func which is of
-     *      type and determined by the signiture of func
-     */
-    static R thunk(void *func, A0 a0) {
-        return static_cast<Callback*>(func)->call(a0);
+    template <typename F>
+    static R heap_call(const void *p, ArgTs... args) {
+        return (**(F* const*)p)(detail::forward<ArgTs>(args)...);
     }
 
-private:
-    // Stored as pointer to function and pointer to optional object
-    // Function pointer is stored as union of possible function types
-    // to garuntee proper size and alignment
-    struct _class;
-    union {
-        void (*_staticfunc)(A0);
-        void (*_boundfunc)(_class*, A0);
-        void (_class::*_methodfunc)(A0);
-    } _func;
-    void *_obj;
-
-    // Dynamically dispatched operations
-    const struct ops {
-        R (*call)(const void*, A0);
-        void (*move)(void*, const void*);
-        void (*dtor)(void*);
-    } *_ops;
-
-    // Generate operations for function object
     template <typename F>
-    void generate(const F &f) {
-        static const ops ops = {
-            &Callback::function_call<F>,
-            &Callback::function_move<F>,
-            &Callback::function_dtor<F>,
-        };
-
-        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) >= sizeof(F),
-                "Type F must not exceed the size of the Callback class");
-        memset(this, 0, sizeof(Callback));
-        new (this) F(f);
-        _ops = &ops;
+    static void heap_copy(void *d, const void *p) {
+        *(F**)d = new F(**(F* const*)p);
     }
 
-    // Function attributes
     template <typename F>
-    static R function_call(const void *p, A0 a0) {
-        return (*(F*)p)(a0);
+    static void heap_move(void *d, void *p) {
+        // el objeto no se mueve: se transfiere su propiedad
+        *(F**)d = *(F**)p;
+        *(F**)p = 0;
     }
 
     template <typename F>
-    static void function_move(void *d, const void *p) {
-        new (d) F(*(F*)p);
+    static void heap_dtor(void *p) {
+        delete *(F**)p;
     }
 
     template <typename F>
-    static void function_dtor(void *p) {
-        ((F*)p)->~F();
+    static bool heap_equal(const void *p, const void *q) {
+        return memcmp(*(F* const*)p, *(F* const*)q, sizeof(F)) == 0;
     }
 
     // Wrappers for functions with context
@@ -619,8 +516,8 @@ private:
         method_context(O *obj, M method)
             : method(method), obj(obj) {}
 
-        R operator()(A0 a0) const {
-            return (obj->*method)(a0);
+        R operator()(ArgTs... args) const {
+            return (obj->*method)(detail::forward<ArgTs>(args)...);
         }
     };
 
@@ -632,1950 +529,14 @@ private:
         function_context(F func, A *arg)
             : func(func), arg(arg) {}
 
-        R operator()(A0 a0) const {
-            return func(arg, a0);
+        R operator()(ArgTs... args) const {
+            return func(arg, detail::forward<ArgTs>(args)...);
         }
     };
 };
 
-/** Callback class based on template specialization
- *
- * @note Synchronization level: Not protected
- */
-template <typename R, typename A0, typename A1>
-class Callback<R(A0, A1)> {
-public:
-    /** Create a Callback with a static function
-     *  @param func     Static function to attach
-     */
-    Callback(R (*func)(A0, A1) = 0) {
-        if (!func) {
-            memset(this, 0, sizeof(Callback));
-        } else {
-            generate(func);
-        }
-    }
-
-    /** Attach a Callback
-     *  @param func     The Callback to attach
-     */
-    Callback(const Callback<R(A0, A1)> &func) {
-        if (func._ops) {
-            func._ops->move(this, &func);
-        }
-        _ops = func._ops;
-    }
-
-    /** Create a Callback with a member function
-     *  @param obj      Pointer to object to invoke member function on
-     *  @param method   Member function to attach
-     */
-    template<typename T, typename U>
-    Callback(U *obj, R (T::*method)(A0, A1)) {
-        generate(method_context<T, R (T::*)(A0, A1)>(obj, method));
-    }
-
-    /** Create a Callback with a member function
-     *  @param obj      Pointer to object to invoke member function on
-     *  @param method   Member function to attach
-     */
-    template<typename T, typename U>
-    Callback(const U *obj, R (T::*method)(A0, A1) const) {
-        generate(method_context<const T, R (T::*)(A0, A1) const>(obj, method));
-    }
-
-    /** Create a Callback with a member function
-     *  @param obj      Pointer to object to invoke member function on
-     *  @param method   Member function to attach
-     */
-    template<typename T, typename U>
-    Callback(volatile U *obj, R (T::*method)(A0, A1) volatile) {
-        generate(method_context<volatile T, R (T::*)(A0, A1) volatile>(obj, method));
-    }
-
-    /** Create a Callback with a member function
-     *  @param obj      Pointer to object to invoke member function on
-     *  @param method   Member function to attach
-     */
-    template<typename T, typename U>
-    Callback(const volatile U *obj, R (T::*method)(A0, A1) const volatile) {
-        generate(method_context<const volatile T, R (T::*)(A0, A1) const volatile>(obj, method));
-    }
-
-    /** Create a Callback with a static function and bound pointer
-     *  @param func     Static function to attach
-     *  @param arg      Pointer argument to function
-     */
-    template<typename T, typename U>
-    Callback(R (*func)(T*, A0, A1), U *arg) {
-        generate(function_context<R (*)(T*, A0, A1), T>(func, arg));
-    }
-
-    /** Create a Callback with a static function and bound pointer
-     *  @param func     Static function to attach
-     *  @param arg      Pointer argument to function
-     */
-    template<typename T, typename U>
-    Callback(R (*func)(const T*, A0, A1), const U *arg) {
-        generate(function_context<R (*)(const T*, A0, A1), const T>(func, arg));
-    }
-
-    /** Create a Callback with a static function and bound pointer
-     *  @param func     Static function to attach
-     *  @param arg      Pointer argument to function
-     */
-    template<typename T, typename U>
-    Callback(R (*func)(volatile T*, A0, A1), volatile U *arg) {
-        generate(function_context<R (*)(volatile T*, A0, A1), volatile T>(func, arg));
-    }
-
-    /** Create a Callback with a static function and bound pointer
-     *  @param func     Static function to attach
-     *  @param arg      Pointer argument to function
-     */
-    template<typename T, typename U>
-    Callback(R (*func)(const volatile T*, A0, A1), const volatile U *arg) {
-        generate(function_context<R (*)(const volatile T*, A0, A1), const volatile T>(func, arg));
-    }
-
-    /** Create a Callback with a function object
-     *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
-     */
-    template <typename F>
-    Callback(F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(A0, A1))) {
-        generate(f);
-    }
-
-    /** Create a Callback with a function object
-     *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
-     */
-    template <typename F>
-    Callback(const F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(A0, A1) const)) {
-        generate(f);
-    }
-
-    /** Create a Callback with a function object
-     *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
-     */
-    template <typename F>
-    Callback(volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(A0, A1) volatile)) {
-        generate(f);
-    }
-
-    /** Create a Callback with a function object
-     *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
-     */
-    template <typename F>
-    Callback(const volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(A0, A1) const volatile)) {
-        generate(f);
-    }
-
-    /** Destroy a callback
-     */
-    ~Callback() {
-        if (_ops) {
-            _ops->dtor(this);
-        }
-    }
-
-    /** Assign a callback
-     */
-    Callback &operator=(const Callback &that) {
-        if (this != &that) {
-            this->~Callback();
-            new (this) Callback(that);
-        }
-
-        return *this;
-    }
-
-    /** Call the attached function
-     */
-    R call(A0 a0, A1 a1) const {
-        MBED_ASSERT(_ops);
-        return _ops->call(this, a0, a1);
-    }
-
-    /** Call the attached function
-     */
-    R operator()(A0 a0, A1 a1) const {
-        return call(a0, a1);
-    }
-
-    /** Test if function has been attached
-     */
-    operator bool() const {
-        return _ops;
-    }
-
-    /** Test for equality
-     */
-    friend bool operator==(const Callback &l, const Callback &r) {
-        return memcmp(&l, &r, sizeof(Callback)) == 0;
-    }
-
-    /** Test for inequality
-     */
-    friend bool operator!=(const Callback &l, const Callback &r) {
-        return !(l == r);
-    }
-
-    /** Static thunk for passing as C-style function
-     *  @param func Callback to call passed as void pointer
-     *  @param a0 An argument to be called with function func
-     *  @param a1 An argument to be called with function func
-     *  @return the value as determined by func which is of
-     *      type and determined by the signiture of func
-     */
-    static R thunk(void *func, A0 a0, A1 a1) {
-        return static_cast<Callback*>(func)->call(a0, a1);
-    }
-
-private:
-    // Stored as pointer to function and pointer to optional object
-    // Function pointer is stored as union of possible function types
-    // to garuntee proper size and alignment
-    struct _class;
-    union {
-        void (*_staticfunc)(A0, A1);
-        void (*_boundfunc)(_class*, A0, A1);
-        void (_class::*_methodfunc)(A0, A1);
-    } _func;
-    void *_obj;
-
-    // Dynamically dispatched operations
-    const struct ops {
-        R (*call)(const void*, A0, A1);
-        void (*move)(void*, const void*);
-        void (*dtor)(void*);
-    } *_ops;
-
-    // Generate operations for function object
-    template <typename F>
-    void generate(const F &f) {
-        static const ops ops = {
-            &Callback::function_call<F>,
-            &Callback::function_move<F>,
-            &Callback::function_dtor<F>,
-        };
-
-        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) >= sizeof(F),
-                "Type F must not exceed the size of the Callback class");
-        memset(this, 0, sizeof(Callback));
-        new (this) F(f);
-        _ops = &ops;
-    }
-
-    // Function attributes
-    template <typename F>
-    static R function_call(const void *p, A0 a0, A1 a1) {
-        return (*(F*)p)(a0, a1);
-    }
-
-    template <typename F>
-    static void function_move(void *d, const void *p) {
-        new (d) F(*(F*)p);
-    }
-
-    template <typename F>
-    static void function_dtor(void *p) {
-        ((F*)p)->~F();
-    }
-
-    // Wrappers for functions with context
-    template <typename O, typename M>
-    struct method_context {
-        M method;
-        O *obj;
-
-        method_context(O *obj, M method)
-            : method(method), obj(obj) {}
-
-        R operator()(A0 a0, A1 a1) const {
-            return (obj->*method)(a0, a1);
-        }
-    };
-
-    template <typename F, typename A>
-    struct function_context {
-        F func;
-        A *arg;
-
-        function_context(F func, A *arg)
-            : func(func), arg(arg) {}
-
-        R operator()(A0 a0, A1 a1) const {
-            return func(arg, a0, a1);
-        }
-    };
-};
-
-/** Callback class based on template specialization
- *
- * @note Synchronization level: Not protected
- */
-template <typename R, typename A0, typename A1, typename A2>
-class Callback<R(A0, A1, A2)> {
-public:
-    /** Create a Callback with a static function
-     *  @param func     Static function to attach
-     */
-    Callback(R (*func)(A0, A1, A2) = 0) {
-        if (!func) {
-            memset(this, 0, sizeof(Callback));
-        } else {
-            generate(func);
-        }
-    }
-
-    /** Attach a Callback
-     *  @param func     The Callback to attach
-     */
-    Callback(const Callback<R(A0, A1, A2)> &func) {
-        if (func._ops) {
-            func._ops->move(this, &func);
-        }
-        _ops = func._ops;
-    }
-
-    /** Create a Callback with a member function
-     *  @param obj      Pointer to object to invoke member function on
-     *  @param method   Member function to attach
-     */
-    template<typename T, typename U>
-    Callback(U *obj, R (T::*method)(A0, A1, A2)) {
-        generate(method_context<T, R (T::*)(A0, A1, A2)>(obj, method));
-    }
-
-    /** Create a Callback with a member function
-     *  @param obj      Pointer to object to invoke member function on
-     *  @param method   Member function to attach
-     */
-    template<typename T, typename U>
-    Callback(const U *obj, R (T::*method)(A0, A1, A2) const) {
-        generate(method_context<const T, R (T::*)(A0, A1, A2) const>(obj, method));
-    }
-
-    /** Create a Callback with a member function
-     *  @param obj      Pointer to object to invoke member function on
-     *  @param method   Member function to attach
-     */
-    template<typename T, typename U>
-    Callback(volatile U *obj, R (T::*method)(A0, A1, A2) volatile) {
-        generate(method_context<volatile T, R (T::*)(A0, A1, A2) volatile>(obj, method));
-    }
-
-    /** Create a Callback with a member function
-     *  @param obj      Pointer to object to invoke member function on
-     *  @param method   Member function to attach
-     */
-    template<typename T, typename U>
-    Callback(const volatile U *obj, R (T::*method)(A0, A1, A2) const volatile) {
-        generate(method_context<const volatile T, R (T::*)(A0, A1, A2) const volatile>(obj, method));
-    }
-
-    /** Create a Callback with a static function and bound pointer
-     *  @param func     Static function to attach
-     *  @param arg      Pointer argument to function
-     */
-    template<typename T, typename U>
-    Callback(R (*func)(T*, A0, A1, A2), U *arg) {
-        generate(function_context<R (*)(T*, A0, A1, A2), T>(func, arg));
-    }
-
-    /** Create a Callback with a static function and bound pointer
-     *  @param func     Static function to attach
-     *  @param arg      Pointer argument to function
-     */
-    template<typename T, typename U>
-    Callback(R (*func)(const T*, A0, A1, A2), const U *arg) {
-        generate(function_context<R (*)(const T*, A0, A1, A2), const T>(func, arg));
-    }
-
-    /** Create a Callback with a static function and bound pointer
-     *  @param func     Static function to attach
-     *  @param arg      Pointer argument to function
-     */
-    template<typename T, typename U>
-    Callback(R (*func)(volatile T*, A0, A1, A2), volatile U *arg) {
-        generate(function_context<R (*)(volatile T*, A0, A1, A2), volatile T>(func, arg));
-    }
-
-    /** Create a Callback with a static function and bound pointer
-     *  @param func     Static function to attach
-     *  @param arg      Pointer argument to function
-     */
-    template<typename T, typename U>
-    Callback(R (*func)(const volatile T*, A0, A1, A2), const volatile U *arg) {
-        generate(function_context<R (*)(const volatile T*, A0, A1, A2), const volatile T>(func, arg));
-    }
-
-    /** Create a Callback with a function object
-     *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
-     */
-    template <typename F>
-    Callback(F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(A0, A1, A2))) {
-        generate(f);
-    }
-
-    /** Create a Callback with a function object
-     *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
-     */
-    template <typename F>
-    Callback(const F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(A0, A1, A2) const)) {
-        generate(f);
-    }
-
-    /** Create a Callback with a function object
-     *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
-     */
-    template <typename F>
-    Callback(volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(A0, A1, A2) volatile)) {
-        generate(f);
-    }
-
-    /** Create a Callback with a function object
-     *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
-     */
-    template <typename F>
-    Callback(const volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(A0, A1, A2) const volatile)) {
-        generate(f);
-    }
-
-    /** Destroy a callback
-     */
-    ~Callback() {
-        if (_ops) {
-            _ops->dtor(this);
-        }
-    }
-
-    /** Assign a callback
-     */
-    Callback &operator=(const Callback &that) {
-        if (this != &that) {
-            this->~Callback();
-            new (this) Callback(that);
-        }
-
-        return *this;
-    }
-
-    /** Call the attached function
-     */
-    R call(A0 a0, A1 a1, A2 a2) const {
-        MBED_ASSERT(_ops);
-        return _ops->call(this, a0, a1, a2);
-    }
-
-    /** Call the attached function
-     */
-    R operator()(A0 a0, A1 a1, A2 a2) const {
-        return call(a0, a1, a2);
-    }
-
-    /** Test if function has been attached
-     */
-    operator bool() const {
-        return _ops;
-    }
-
-    /** Test for equality
-     */
-    friend bool operator==(const Callback &l, const Callback &r) {
-        return memcmp(&l, &r, sizeof(Callback)) == 0;
-    }
-
-    /** Test for inequality
-     */
-    friend bool operator!=(const Callback &l, const Callback &r) {
-        return !(l == r);
-    }
-
-    /** Static thunk for passing as C-style function
-     *  @param func Callback to call passed as void pointer
-     *  @param a0 An argument to be called with function func
-     *  @param a1 An argument to be called with function func
-     *  @param a2 An argument to be called with function func
-     *  @return the value as determined by func which is of
-     *      type and determined by the signiture of func
-     */
-    static R thunk(void *func, A0 a0, A1 a1, A2 a2) {
-        return static_cast<Callback*>(func)->call(a0, a1, a2);
-    }
-
-private:
-    // Stored as pointer to function and pointer to optional object
-    // Function pointer is stored as union of possible function types
-    // to garuntee proper size and alignment
-    struct _class;
-    union {
-        void (*_staticfunc)(A0, A1, A2);
-        void (*_boundfunc)(_class*, A0, A1, A2);
-        void (_class::*_methodfunc)(A0, A1, A2);
-    } _func;
-    void *_obj;
-
-    // Dynamically dispatched operations
-    const struct ops {
-        R (*call)(const void*, A0, A1, A2);
-        void (*move)(void*, const void*);
-        void (*dtor)(void*);
-    } *_ops;
-
-    // Generate operations for function object
-    template <typename F>
-    void generate(const F &f) {
-        static const ops ops = {
-            &Callback::function_call<F>,
-            &Callback::function_move<F>,
-            &Callback::function_dtor<F>,
-        };
-
-        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) >= sizeof(F),
-                "Type F must not exceed the size of the Callback class");
-        memset(this, 0, sizeof(Callback));
-        new (this) F(f);
-        _ops = &ops;
-    }
-
-    // Function attributes
-    template <typename F>
-    static R function_call(const void *p, A0 a0, A1 a1, A2 a2) {
-        return (*(F*)p)(a0, a1, a2);
-    }
-
-    template <typename F>
-    static void function_move(void *d, const void *p) {
-        new (d) F(*(F*)p);
-    }
-
-    template <typename F>
-    static void function_dtor(void *p) {
-        ((F*)p)->~F();
-    }
-
-    // Wrappers for functions with context
-    template <typename O, typename M>
-    struct method_context {
-        M method;
-        O *obj;
-
-        method_context(O *obj, M method)
-            : method(method), obj(obj) {}
-
-        R operator()(A0 a0, A1 a1, A2 a2) const {
-            return (obj->*method)(a0, a1, a2);
-        }
-    };
-
-    template <typename F, typename A>
-    struct function_context {
-        F func;
-        A *arg;
-
-        function_context(F func, A *arg)
-            : func(func), arg(arg) {}
-
-        R operator()(A0 a0, A1 a1, A2 a2) const {
-            return func(arg, a0, a1, a2);
-        }
-    };
-};
-
-/** Callback class based on template specialization
- *
- * @note Synchronization level: Not protected
- */
-template <typename R, typename A0, typename A1, typename A2, typename A3>
-class Callback<R(A0, A1, A2, A3)> {
-public:
-    /** Create a Callback with a static function
-     *  @param func     Static function to attach
-     */
-    Callback(R (*func)(A0, A1, A2, A3) = 0) {
-        if (!func) {
-            memset(this, 0, sizeof(Callback));
-        } else {
-            generate(func);
-        }
-    }
-
-    /** Attach a Callback
-     *  @param func     The Callback to attach
-     */
-    Callback(const Callback<R(A0, A1, A2, A3)> &func) {
-        if (func._ops) {
-            func._ops->move(this, &func);
-        }
-        _ops = func._ops;
-    }
-
-    /** Create a Callback with a member function
-     *  @param obj      Pointer to object to invoke member function on
-     *  @param method   Member function to attach
-     */
-    template<typename T, typename U>
-    Callback(U *obj, R (T::*method)(A0, A1, A2, A3)) {
-        generate(method_context<T, R (T::*)(A0, A1, A2, A3)>(obj, method));
-    }
-
-    /** Create a Callback with a member function
-     *  @param obj      Pointer to object to invoke member function on
-     *  @param method   Member function to attach
-     */
-    template<typename T, typename U>
-    Callback(const U *obj, R (T::*method)(A0, A1, A2, A3) const) {
-        generate(method_context<const T, R (T::*)(A0, A1, A2, A3) const>(obj, method));
-    }
-
-    /** Create a Callback with a member function
-     *  @param obj      Pointer to object to invoke member function on
-     *  @param method   Member function to attach
-     */
-    template<typename T, typename U>
-    Callback(volatile U *obj, R (T::*method)(A0, A1, A2, A3) volatile) {
-        generate(method_context<volatile T, R (T::*)(A0, A1, A2, A3) volatile>(obj, method));
-    }
-
-    /** Create a Callback with a member function
-     *  @param obj      Pointer to object to invoke member function on
-     *  @param method   Member function to attach
-     */
-    template<typename T, typename U>
-    Callback(const volatile U *obj, R (T::*method)(A0, A1, A2, A3) const volatile) {
-        generate(method_context<const volatile T, R (T::*)(A0, A1, A2, A3) const volatile>(obj, method));
-    }
-
-    /** Create a Callback with a static function and bound pointer
-     *  @param func     Static function to attach
-     *  @param arg      Pointer argument to function
-     */
-    template<typename T, typename U>
-    Callback(R (*func)(T*, A0, A1, A2, A3), U *arg) {
-        generate(function_context<R (*)(T*, A0, A1, A2, A3), T>(func, arg));
-    }
-
-    /** Create a Callback with a static function and bound pointer
-     *  @param func     Static function to attach
-     *  @param arg      Pointer argument to function
-     */
-    template<typename T, typename U>
-    Callback(R (*func)(const T*, A0, A1, A2, A3), const U *arg) {
-        generate(function_context<R (*)(const T*, A0, A1, A2, A3), const T>(func, arg));
-    }
-
-    /** Create a Callback with a static function and bound pointer
-     *  @param func     Static function to attach
-     *  @param arg      Pointer argument to function
-     */
-    template<typename T, typename U>
-    Callback(R (*func)(volatile T*, A0, A1, A2, A3), volatile U *arg) {
-        generate(function_context<R (*)(volatile T*, A0, A1, A2, A3), volatile T>(func, arg));
-    }
-
-    /** Create a Callback with a static function and bound pointer
-     *  @param func     Static function to attach
-     *  @param arg      Pointer argument to function
-     */
-    template<typename T, typename U>
-    Callback(R (*func)(const volatile T*, A0, A1, A2, A3), const volatile U *arg) {
-        generate(function_context<R (*)(const volatile T*, A0, A1, A2, A3), const volatile T>(func, arg));
-    }
-
-    /** Create a Callback with a function object
-     *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
-     */
-    template <typename F>
-    Callback(F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(A0, A1, A2, A3))) {
-        generate(f);
-    }
-
-    /** Create a Callback with a function object
-     *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
-     */
-    template <typename F>
-    Callback(const F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(A0, A1, A2, A3) const)) {
-        generate(f);
-    }
-
-    /** Create a Callback with a function object
-     *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
-     */
-    template <typename F>
-    Callback(volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(A0, A1, A2, A3) volatile)) {
-        generate(f);
-    }
-
-    /** Create a Callback with a function object
-     *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
-     */
-    template <typename F>
-    Callback(const volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(A0, A1, A2, A3) const volatile)) {
-        generate(f);
-    }
-
-    /** Destroy a callback
-     */
-    ~Callback() {
-        if (_ops) {
-            _ops->dtor(this);
-        }
-    }
-
-    /** Assign a callback
-     */
-    Callback &operator=(const Callback &that) {
-        if (this != &that) {
-            this->~Callback();
-            new (this) Callback(that);
-        }
-
-        return *this;
-    }
-
-    /** Call the attached function
-     */
-    R call(A0 a0, A1 a1, A2 a2, A3 a3) const {
-        MBED_ASSERT(_ops);
-        return _ops->call(this, a0, a1, a2, a3);
-    }
-
-    /** Call the attached function
-     */
-    R operator()(A0 a0, A1 a1, A2 a2, A3 a3) const {
-        return call(a0, a1, a2, a3);
-    }
-
-    /** Test if function has been attached
-     */
-    operator bool() const {
-        return _ops;
-    }
-
-    /** Test for equality
-     */
-    friend bool operator==(const Callback &l, const Callback &r) {
-        return memcmp(&l, &r, sizeof(Callback)) == 0;
-    }
-
-    /** Test for inequality
-     */
-    friend bool operator!=(const Callback &l, const Callback &r) {
-        return !(l == r);
-    }
-
-    /** Static thunk for passing as C-style function
-     *  @param func Callback to call passed as void pointer
-     *  @param a0 An argument to be called with function func
-     *  @param a1 An argument to be called with function func
-     *  @param a2 An argument to be called with function func
-     *  @param a3 An argument to be called with function func
-     *  @return the value as determined by func which is of
-     *      type and determined by the signiture of func
-     */
-    static R thunk(void *func, A0 a0, A1 a1, A2 a2, A3 a3) {
-        return static_cast<Callback*>(func)->call(a0, a1, a2, a3);
-    }
-
-private:
-    // Stored as pointer to function and pointer to optional object
-    // Function pointer is stored as union of possible function types
-    // to garuntee proper size and alignment
-    struct _class;
-    union {
-        void (*_staticfunc)(A0, A1, A2, A3);
-        void (*_boundfunc)(_class*, A0, A1, A2, A3);
-        void (_class::*_methodfunc)(A0, A1, A2, A3);
-    } _func;
-    void *_obj;
-
-    // Dynamically dispatched operations
-    const struct ops {
-        R (*call)(const void*, A0, A1, A2, A3);
-        void (*move)(void*, const void*);
-        void (*dtor)(void*);
-    } *_ops;
-
-    // Generate operations for function object
-    template <typename F>
-    void generate(const F &f) {
-        static const ops ops = {
-            &Callback::function_call<F>,
-            &Callback::function_move<F>,
-            &Callback::function_dtor<F>,
-        };
-
-        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) >= sizeof(F),
-                "Type F must not exceed the size of the Callback class");
-        memset(this, 0, sizeof(Callback));
-        new (this) F(f);
-        _ops = &ops;
-    }
-
-    // Function attributes
-    template <typename F>
-    static R function_call(const void *p, A0 a0, A1 a1, A2 a2, A3 a3) {
-        return (*(F*)p)(a0, a1, a2, a3);
-    }
-
-    template <typename F>
-    static void function_move(void *d, const void *p) {
-        new (d) F(*(F*)p);
-    }
-
-    template <typename F>
-    static void function_dtor(void *p) {
-        ((F*)p)->~F();
-    }
-
-    // Wrappers for functions with context
-    template <typename O, typename M>
-    struct method_context {
-        M method;
-        O *obj;
-
-        method_context(O *obj, M method)
-            : method(method), obj(obj) {}
-
-        R operator()(A0 a0, A1 a1, A2 a2, A3 a3) const {
-            return (obj->*method)(a0, a1, a2, a3);
-        }
-    };
-
-    template <typename F, typename A>
-    struct function_context {
-        F func;
-        A *arg;
-
-        function_context(F func, A *arg)
-            : func(func), arg(arg) {}
-
-        R operator()(A0 a0, A1 a1, A2 a2, A3 a3) const {
-            return func(arg, a0, a1, a2, a3);
-        }
-    };
-};
-
-/** Callback class based on template specialization
- *
- * @note Synchronization level: Not protected
- */
-template <typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
-class Callback<R(A0, A1, A2, A3, A4)> {
-public:
-    /** Create a Callback with a static function
-     *  @param func     Static function to attach
-     */
-    Callback(R (*func)(A0, A1, A2, A3, A4) = 0) {
-        if (!func) {
-            memset(this, 0, sizeof(Callback));
-        } else {
-            generate(func);
-        }
-    }
-
-    /** Attach a Callback
-     *  @param func     The Callback to attach
-     */
-    Callback(const Callback<R(A0, A1, A2, A3, A4)> &func) {
-        if (func._ops) {
-            func._ops->move(this, &func);
-        }
-        _ops = func._ops;
-    }
-
-    /** Create a Callback with a member function
-     *  @param obj      Pointer to object to invoke member function on
-     *  @param method   Member function to attach
-     */
-    template<typename T, typename U>
-    Callback(U *obj, R (T::*method)(A0, A1, A2, A3, A4)) {
-        generate(method_context<T, R (T::*)(A0, A1, A2, A3, A4)>(obj, method));
-    }
-
-    /** Create a Callback with a member function
-     *  @param obj      Pointer to object to invoke member function on
-     *  @param method   Member function to attach
-     */
-    template<typename T, typename U>
-    Callback(const U *obj, R (T::*method)(A0, A1, A2, A3, A4) const) {
-        generate(method_context<const T, R (T::*)(A0, A1, A2, A3, A4) const>(obj, method));
-    }
-
-    /** Create a Callback with a member function
-     *  @param obj      Pointer to object to invoke member function on
-     *  @param method   Member function to attach
-     */
-    template<typename T, typename U>
-    Callback(volatile U *obj, R (T::*method)(A0, A1, A2, A3, A4) volatile) {
-        generate(method_context<volatile T, R (T::*)(A0, A1, A2, A3, A4) volatile>(obj, method));
-    }
-
-    /** Create a Callback with a member function
-     *  @param obj      Pointer to object to invoke member function on
-     *  @param method   Member function to attach
-     */
-    template<typename T, typename U>
-    Callback(const volatile U *obj, R (T::*method)(A0, A1, A2, A3, A4) const volatile) {
-        generate(method_context<const volatile T, R (T::*)(A0, A1, A2, A3, A4) const volatile>(obj, method));
-    }
-
-    /** Create a Callback with a static function and bound pointer
-     *  @param func     Static function to attach
-     *  @param arg      Pointer argument to function
-     */
-    template<typename T, typename U>
-    Callback(R (*func)(T*, A0, A1, A2, A3, A4), U *arg) {
-        generate(function_context<R (*)(T*, A0, A1, A2, A3, A4), T>(func, arg));
-    }
-
-    /** Create a Callback with a static function and bound pointer
-     *  @param func     Static function to attach
-     *  @param arg      Pointer argument to function
-     */
-    template<typename T, typename U>
-    Callback(R (*func)(const T*, A0, A1, A2, A3, A4), const U *arg) {
-        generate(function_context<R (*)(const T*, A0, A1, A2, A3, A4), const T>(func, arg));
-    }
-
-    /** Create a Callback with a static function and bound pointer
-     *  @param func     Static function to attach
-     *  @param arg      Pointer argument to function
-     */
-    template<typename T, typename U>
-    Callback(R (*func)(volatile T*, A0, A1, A2, A3, A4), volatile U *arg) {
-        generate(function_context<R (*)(volatile T*, A0, A1, A2, A3, A4), volatile T>(func, arg));
-    }
-
-    /** Create a Callback with a static function and bound pointer
-     *  @param func     Static function to attach
-     *  @param arg      Pointer argument to function
-     */
-    template<typename T, typename U>
-    Callback(R (*func)(const volatile T*, A0, A1, A2, A3, A4), const volatile U *arg) {
-        generate(function_context<R (*)(const volatile T*, A0, A1, A2, A3, A4), const volatile T>(func, arg));
-    }
-
-    /** Create a Callback with a function object
-     *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
-     */
-    template <typename F>
-    Callback(F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(A0, A1, A2, A3, A4))) {
-        generate(f);
-    }
-
-    /** Create a Callback with a function object
-     *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
-     */
-    template <typename F>
-    Callback(const F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(A0, A1, A2, A3, A4) const)) {
-        generate(f);
-    }
-
-    /** Create a Callback with a function object
-     *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
-     */
-    template <typename F>
-    Callback(volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(A0, A1, A2, A3, A4) volatile)) {
-        generate(f);
-    }
-
-    /** Create a Callback with a function object
-     *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
-     */
-    template <typename F>
-    Callback(const volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(A0, A1, A2, A3, A4) const volatile)) {
-        generate(f);
-    }
-
-    /** Destroy a callback
-     */
-    ~Callback() {
-        if (_ops) {
-            _ops->dtor(this);
-        }
-    }
-
-    /** Assign a callback
-     */
-    Callback &operator=(const Callback &that) {
-        if (this != &that) {
-            this->~Callback();
-            new (this) Callback(that);
-        }
-
-        return *this;
-    }
-
-    /** Call the attached function
-     */
-    R call(A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) const {
-        MBED_ASSERT(_ops);
-        return _ops->call(this, a0, a1, a2, a3, a4);
-    }
-
-    /** Call the attached function
-     */
-    R operator()(A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) const {
-        return call(a0, a1, a2, a3, a4);
-    }
-
-    /** Test if function has been attached
-     */
-    operator bool() const {
-        return _ops;
-    }
-
-    /** Test for equality
-     */
-    friend bool operator==(const Callback &l, const Callback &r) {
-        return memcmp(&l, &r, sizeof(Callback)) == 0;
-    }
-
-    /** Test for inequality
-     */
-    friend bool operator!=(const Callback &l, const Callback &r) {
-        return !(l == r);
-    }
-
-    /** Static thunk for passing as C-style function
-     *  @param func Callback to call passed as void pointer
-     *  @param a0 An argument to be called with function func
-     *  @param a1 An argument to be called with function func
-     *  @param a2 An argument to be called with function func
-     *  @param a3 An argument to be called with function func
-     *  @param a4 An argument to be called with function func
-     *  @return the value as determined by func which is of
-     *      type and determined by the signiture of func
-     */
-    static R thunk(void *func, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-        return static_cast<Callback*>(func)->call(a0, a1, a2, a3, a4);
-    }
-
-private:
-    // Stored as pointer to function and pointer to optional object
-    // Function pointer is stored as union of possible function types
-    // to garuntee proper size and alignment
-    struct _class;
-    union {
-        void (*_staticfunc)(A0, A1, A2, A3, A4);
-        void (*_boundfunc)(_class*, A0, A1, A2, A3, A4);
-        void (_class::*_methodfunc)(A0, A1, A2, A3, A4);
-    } _func;
-    void *_obj;
-
-    // Dynamically dispatched operations
-    const struct ops {
-        R (*call)(const void*, A0, A1, A2, A3, A4);
-        void (*move)(void*, const void*);
-        void (*dtor)(void*);
-    } *_ops;
-
-    // Generate operations for function object
-    template <typename F>
-    void generate(const F &f) {
-        static const ops ops = {
-            &Callback::function_call<F>,
-            &Callback::function_move<F>,
-            &Callback::function_dtor<F>,
-        };
-
-        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) >= sizeof(F),
-                "Type F must not exceed the size of the Callback class");
-        memset(this, 0, sizeof(Callback));
-        new (this) F(f);
-        _ops = &ops;
-    }
-
-    // Function attributes
-    template <typename F>
-    static R function_call(const void *p, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-        return (*(F*)p)(a0, a1, a2, a3, a4);
-    }
-
-    template <typename F>
-    static void function_move(void *d, const void *p) {
-        new (d) F(*(F*)p);
-    }
-
-    template <typename F>
-    static void function_dtor(void *p) {
-        ((F*)p)->~F();
-    }
-
-    // Wrappers for functions with context
-    template <typename O, typename M>
-    struct method_context {
-        M method;
-        O *obj;
-
-        method_context(O *obj, M method)
-            : method(method), obj(obj) {}
-
-        R operator()(A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) const {
-            return (obj->*method)(a0, a1, a2, a3, a4);
-        }
-    };
-
-    template <typename F, typename A>
-    struct function_context {
-        F func;
-        A *arg;
-
-        function_context(F func, A *arg)
-            : func(func), arg(arg) {}
-
-        R operator()(A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) const {
-            return func(arg, a0, a1, a2, a3, a4);
-        }
-    };
-};
-
-
-/** Callback class based on template specialization
- *
- * @note Synchronization level: Not protected
- * @ingroup platform
- */
-template <typename R, typename A0, typename A1, typename A2, typename A3, typename A4, typename A5>
-class Callback<R(A0, A1, A2, A3, A4, A5)> {
-public:
-    /** Create a Callback with a static function
-     *  @param func     Static function to attach
-     */
-    Callback(R (*func)(A0, A1, A2, A3, A4, A5) = 0) {
-        if (!func) {
-            _ops = 0;
-        } else {
-            generate(func);
-        }
-    }
-
-    /** Attach a Callback
-     *  @param func     The Callback to attach
-     */
-    Callback(const Callback<R(A0, A1, A2, A3, A4, A5)> &func) {
-        if (func._ops) {
-            func._ops->move(this, &func);
-        }
-        _ops = func._ops;
-    }
-
-    /** Create a Callback with a member function
-     *  @param obj      Pointer to object to invoke member function on
-     *  @param method   Member function to attach
-     */
-    template<typename T, typename U>
-    Callback(U *obj, R (T::*method)(A0, A1, A2, A3, A4, A5)) {
-        generate(method_context<T, R (T::*)(A0, A1, A2, A3, A4, A5)>(obj, method));
-    }
-
-    /** Create a Callback with a member function
-     *  @param obj      Pointer to object to invoke member function on
-     *  @param method   Member function to attach
-     */
-    template<typename T, typename U>
-    Callback(const U *obj, R (T::*method)(A0, A1, A2, A3, A4, A5) const) {
-        generate(method_context<const T, R (T::*)(A0, A1, A2, A3, A4, A5) const>(obj, method));
-    }
-
-    /** Create a Callback with a member function
-     *  @param obj      Pointer to object to invoke member function on
-     *  @param method   Member function to attach
-     */
-    template<typename T, typename U>
-    Callback(volatile U *obj, R (T::*method)(A0, A1, A2, A3, A4, A5) volatile) {
-        generate(method_context<volatile T, R (T::*)(A0, A1, A2, A3, A4, A5) volatile>(obj, method));
-    }
-
-    /** Create a Callback with a member function
-     *  @param obj      Pointer to object to invoke member function on
-     *  @param method   Member function to attach
-     */
-    template<typename T, typename U>
-    Callback(const volatile U *obj, R (T::*method)(A0, A1, A2, A3, A4, A5) const volatile) {
-        generate(method_context<const volatile T, R (T::*)(A0, A1, A2, A3, A4, A5) const volatile>(obj, method));
-    }
-
-    /** Create a Callback with a static function and bound pointer
-     *  @param func     Static function to attach
-     *  @param arg      Pointer argument to function
-     */
-    template<typename T, typename U>
-    Callback(R (*func)(T*, A0, A1, A2, A3, A4, A5), U *arg) {
-        generate(function_context<R (*)(T*, A0, A1, A2, A3, A4, A5), T>(func, arg));
-    }
-
-    /** Create a Callback with a static function and bound pointer
-     *  @param func     Static function to attach
-     *  @param arg      Pointer argument to function
-     */
-    template<typename T, typename U>
-    Callback(R (*func)(const T*, A0, A1, A2, A3, A4, A5), const U *arg) {
-        generate(function_context<R (*)(const T*, A0, A1, A2, A3, A4, A5), const T>(func, arg));
-    }
-
-    /** Create a Callback with a static function and bound pointer
-     *  @param func     Static function to attach
-     *  @param arg      Pointer argument to function
-     */
-    template<typename T, typename U>
-    Callback(R (*func)(volatile T*, A0, A1, A2, A3, A4, A5), volatile U *arg) {
-        generate(function_context<R (*)(volatile T*, A0, A1, A2, A3, A4, A5), volatile T>(func, arg));
-    }
-
-    /** Create a Callback with a static function and bound pointer
-     *  @param func     Static function to attach
-     *  @param arg      Pointer argument to function
-     */
-    template<typename T, typename U>
-    Callback(R (*func)(const volatile T*, A0, A1, A2, A3, A4, A5), const volatile U *arg) {
-        generate(function_context<R (*)(const volatile T*, A0, A1, A2, A3, A4, A5), const volatile T>(func, arg));
-    }
-
-    /** Create a Callback with a function object
-     *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
-     */
-    template <typename F>
-    Callback(F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(A0, A1, A2, A3, A4, A5))) {
-        generate(f);
-    }
-
-    /** Create a Callback with a function object
-     *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
-     */
-    template <typename F>
-    Callback(const F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(A0, A1, A2, A3, A4, A5) const)) {
-        generate(f);
-    }
-
-    /** Create a Callback with a function object
-     *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
-     */
-    template <typename F>
-    Callback(volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(A0, A1, A2, A3, A4, A5) volatile)) {
-        generate(f);
-    }
-
-    /** Create a Callback with a function object
-     *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
-     */
-    template <typename F>
-    Callback(const volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R (F::*)(A0, A1, A2, A3, A4, A5) const volatile)) {
-        generate(f);
-    }
-
-    /** Destroy a callback
-     */
-    ~Callback() {
-        if (_ops) {
-            _ops->dtor(this);
-        }
-    }
-
-    /** Assign a callback
-     */
-    Callback &operator=(const Callback &that) {
-        if (this != &that) {
-            this->~Callback();
-            new (this) Callback(that);
-        }
-
-        return *this;
-    }
-
-    /** Call the attached function
-     */
-    R call(A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5) const {
-        MBED_ASSERT(_ops);
-        return _ops->call(this, a0, a1, a2, a3, a4, a5);
-    }
-
-    /** Call the attached function
-     */
-    R operator()(A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5) const {
-        return call(a0, a1, a2, a3, a4, a5);
-    }
-
-    /** Test if function has been attached
-     */
-    operator bool() const {
-        return _ops;
-    }
-
-    /** Test for equality
-     */
-    friend bool operator==(const Callback &l, const Callback &r) {
-        return memcmp(&l, &r, sizeof(Callback)) == 0;
-    }
-
-    /** Test for inequality
-     */
-    friend bool operator!=(const Callback &l, const Callback &r) {
-        return !(l == r);
-    }
-
-    /** Static thunk for passing as C-style function
-     *  @param func Callback to call passed as void pointer
-     *  @param a0 An argument to be called with function func
-     *  @param a1 An argument to be called with function func
-     *  @param a2 An argument to be called with function func
-     *  @param a3 An argument to be called with function func
-     *  @param a4 An argument to be called with function func
-     *  @param a5 An argument to be called with function func
-     *  @return the value as determined by func which is of
-     *      type and determined by the signiture of func
-     */
-    static R thunk(void *func, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5) {
-        return static_cast<Callback*>(func)->call(a0, a1, a2, a3, a4, a5);
-    }
-
-private:
-    // Stored as pointer to function and pointer to optional object
-    // Function pointer is stored as union of possible function types
-    // to garuntee proper size and alignment
-    struct _class;
-    union {
-        void (*_staticfunc)(A0, A1, A2, A3, A4, A5);
-        void (*_boundfunc)(_class*, A0, A1, A2, A3, A4, A5);
-        void (_class::*_methodfunc)(A0, A1, A2, A3, A4, A5);
-    } _func;
-    void *_obj;
-
-    // Dynamically dispatched operations
-    const struct ops {
-        R (*call)(const void*, A0, A1, A2, A3, A4, A5);
-        void (*move)(void*, const void*);
-        void (*dtor)(void*);
-    } *_ops;
-
-    // Generate operations for function object
-    template <typename F>
-    void generate(const F &f) {
-        static const ops ops = {
-            &Callback::function_call<F>,
-            &Callback::function_move<F>,
-            &Callback::function_dtor<F>,
-        };
-
-        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) >= sizeof(F),
-                "Type F must not exceed the size of the Callback class");
-        new (this) F(f);
-        _ops = &ops;
-    }
-
-    // Function attributes
-    template <typename F>
-    static R function_call(const void *p, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5) {
-        return (*(F*)p)(a0, a1, a2, a3, a4, a5);
-    }
-
-    template <typename F>
-    static void function_move(void *d, const void *p) {
-        new (d) F(*(F*)p);
-    }
-
-    template <typename F>
-    static void function_dtor(void *p) {
-        ((F*)p)->~F();
-    }
-
-    // Wrappers for functions with context
-    template <typename O, typename M>
-    struct method_context {
-        M method;
-        O *obj;
-
-        method_context(O *obj, M method)
-            : method(method), obj(obj) {}
-
-        R operator()(A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5) const {
-            return (obj->*method)(a0, a1, a2, a3, a4, a5);
-        }
-    };
-
-    template <typename F, typename A>
-    struct function_context {
-        F func;
-        A *arg;
-
-        function_context(F func, A *arg)
-            : func(func), arg(arg) {}
-
-        R operator()(A0 a0, A1 a1, A2 a2, A3 a3, A4 a4, A5 a5) const {
-            return func(arg, a0, a1, a2, a3, a4, a5);
-        }
-    };
-};
-
-// Internally used event type
-typedef Callback<void(int)> event_callback_t;
-
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @return         Callback with infered type
- */
-template <typename R>
-Callback<R()> callback(R (*func)() = 0) {
-    return Callback<R()>(func);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @return         Callback with infered type
- */
-template <typename R>
-Callback<R()> callback(const Callback<R()> &func) {
-    return Callback<R()>(func);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param obj      Optional pointer to object to bind to function
- *  @param method   Member function to attach
- *  @return         Callback with infered type
- */
-template<typename T, typename U, typename R>
-Callback<R()> callback(U *obj, R (T::*method)()) {
-    return Callback<R()>(obj, method);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param obj      Optional pointer to object to bind to function
- *  @param method   Member function to attach
- *  @return         Callback with infered type
- */
-template<typename T, typename U, typename R>
-Callback<R()> callback(const U *obj, R (T::*method)() const) {
-    return Callback<R()>(obj, method);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param obj      Optional pointer to object to bind to function
- *  @param method   Member function to attach
- *  @return         Callback with infered type
- */
-template<typename T, typename U, typename R>
-Callback<R()> callback(volatile U *obj, R (T::*method)() volatile) {
-    return Callback<R()>(obj, method);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param obj      Optional pointer to object to bind to function
- *  @param method   Member function to attach
- *  @return         Callback with infered type
- */
-template<typename T, typename U, typename R>
-Callback<R()> callback(const volatile U *obj, R (T::*method)() const volatile) {
-    return Callback<R()>(obj, method);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @param arg      Pointer argument to function
- *  @return         Callback with infered type
- */
-template <typename T, typename U, typename R>
-Callback<R()> callback(R (*func)(T*), U *arg) {
-    return Callback<R()>(func, arg);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @param arg      Pointer argument to function
- *  @return         Callback with infered type
- */
-template <typename T, typename U, typename R>
-Callback<R()> callback(R (*func)(const T*), const U *arg) {
-    return Callback<R()>(func, arg);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @param arg      Pointer argument to function
- *  @return         Callback with infered type
- */
-template <typename T, typename U, typename R>
-Callback<R()> callback(R (*func)(volatile T*), volatile U *arg) {
-    return Callback<R()>(func, arg);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @param arg      Pointer argument to function
- *  @return         Callback with infered type
- */
-template <typename T, typename U, typename R>
-Callback<R()> callback(R (*func)(const volatile T*), const volatile U *arg) {
-    return Callback<R()>(func, arg);
-}
-
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @return         Callback with infered type
- */
-template <typename R, typename A0>
-Callback<R(A0)> callback(R (*func)(A0) = 0) {
-    return Callback<R(A0)>(func);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @return         Callback with infered type
- */
-template <typename R, typename A0>
-Callback<R(A0)> callback(const Callback<R(A0)> &func) {
-    return Callback<R(A0)>(func);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param obj      Optional pointer to object to bind to function
- *  @param method   Member function to attach
- *  @return         Callback with infered type
- */
-template<typename T, typename U, typename R, typename A0>
-Callback<R(A0)> callback(U *obj, R (T::*method)(A0)) {
-    return Callback<R(A0)>(obj, method);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param obj      Optional pointer to object to bind to function
- *  @param method   Member function to attach
- *  @return         Callback with infered type
- */
-template<typename T, typename U, typename R, typename A0>
-Callback<R(A0)> callback(const U *obj, R (T::*method)(A0) const) {
-    return Callback<R(A0)>(obj, method);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param obj      Optional pointer to object to bind to function
- *  @param method   Member function to attach
- *  @return         Callback with infered type
- */
-template<typename T, typename U, typename R, typename A0>
-Callback<R(A0)> callback(volatile U *obj, R (T::*method)(A0) volatile) {
-    return Callback<R(A0)>(obj, method);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param obj      Optional pointer to object to bind to function
- *  @param method   Member function to attach
- *  @return         Callback with infered type
- */
-template<typename T, typename U, typename R, typename A0>
-Callback<R(A0)> callback(const volatile U *obj, R (T::*method)(A0) const volatile) {
-    return Callback<R(A0)>(obj, method);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @param arg      Pointer argument to function
- *  @return         Callback with infered type
- */
-template <typename T, typename U, typename R, typename A0>
-Callback<R(A0)> callback(R (*func)(T*, A0), U *arg) {
-    return Callback<R(A0)>(func, arg);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @param arg      Pointer argument to function
- *  @return         Callback with infered type
- */
-template <typename T, typename U, typename R, typename A0>
-Callback<R(A0)> callback(R (*func)(const T*, A0), const U *arg) {
-    return Callback<R(A0)>(func, arg);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @param arg      Pointer argument to function
- *  @return         Callback with infered type
- */
-template <typename T, typename U, typename R, typename A0>
-Callback<R(A0)> callback(R (*func)(volatile T*, A0), volatile U *arg) {
-    return Callback<R(A0)>(func, arg);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @param arg      Pointer argument to function
- *  @return         Callback with infered type
- */
-template <typename T, typename U, typename R, typename A0>
-Callback<R(A0)> callback(R (*func)(const volatile T*, A0), const volatile U *arg) {
-    return Callback<R(A0)>(func, arg);
-}
-
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @return         Callback with infered type
- */
-template <typename R, typename A0, typename A1>
-Callback<R(A0, A1)> callback(R (*func)(A0, A1) = 0) {
-    return Callback<R(A0, A1)>(func);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @return         Callback with infered type
- */
-template <typename R, typename A0, typename A1>
-Callback<R(A0, A1)> callback(const Callback<R(A0, A1)> &func) {
-    return Callback<R(A0, A1)>(func);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param obj      Optional pointer to object to bind to function
- *  @param method   Member function to attach
- *  @return         Callback with infered type
- */
-template<typename T, typename U, typename R, typename A0, typename A1>
-Callback<R(A0, A1)> callback(U *obj, R (T::*method)(A0, A1)) {
-    return Callback<R(A0, A1)>(obj, method);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param obj      Optional pointer to object to bind to function
- *  @param method   Member function to attach
- *  @return         Callback with infered type
- */
-template<typename T, typename U, typename R, typename A0, typename A1>
-Callback<R(A0, A1)> callback(const U *obj, R (T::*method)(A0, A1) const) {
-    return Callback<R(A0, A1)>(obj, method);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param obj      Optional pointer to object to bind to function
- *  @param method   Member function to attach
- *  @return         Callback with infered type
- */
-template<typename T, typename U, typename R, typename A0, typename A1>
-Callback<R(A0, A1)> callback(volatile U *obj, R (T::*method)(A0, A1) volatile) {
-    return Callback<R(A0, A1)>(obj, method);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param obj      Optional pointer to object to bind to function
- *  @param method   Member function to attach
- *  @return         Callback with infered type
- */
-template<typename T, typename U, typename R, typename A0, typename A1>
-Callback<R(A0, A1)> callback(const volatile U *obj, R (T::*method)(A0, A1) const volatile) {
-    return Callback<R(A0, A1)>(obj, method);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @param arg      Pointer argument to function
- *  @return         Callback with infered type
- */
-template <typename T, typename U, typename R, typename A0, typename A1>
-Callback<R(A0, A1)> callback(R (*func)(T*, A0, A1), U *arg) {
-    return Callback<R(A0, A1)>(func, arg);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @param arg      Pointer argument to function
- *  @return         Callback with infered type
- */
-template <typename T, typename U, typename R, typename A0, typename A1>
-Callback<R(A0, A1)> callback(R (*func)(const T*, A0, A1), const U *arg) {
-    return Callback<R(A0, A1)>(func, arg);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @param arg      Pointer argument to function
- *  @return         Callback with infered type
- */
-template <typename T, typename U, typename R, typename A0, typename A1>
-Callback<R(A0, A1)> callback(R (*func)(volatile T*, A0, A1), volatile U *arg) {
-    return Callback<R(A0, A1)>(func, arg);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @param arg      Pointer argument to function
- *  @return         Callback with infered type
- */
-template <typename T, typename U, typename R, typename A0, typename A1>
-Callback<R(A0, A1)> callback(R (*func)(const volatile T*, A0, A1), const volatile U *arg) {
-    return Callback<R(A0, A1)>(func, arg);
-}
-
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @return         Callback with infered type
- */
-template <typename R, typename A0, typename A1, typename A2>
-Callback<R(A0, A1, A2)> callback(R (*func)(A0, A1, A2) = 0) {
-    return Callback<R(A0, A1, A2)>(func);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @return         Callback with infered type
- */
-template <typename R, typename A0, typename A1, typename A2>
-Callback<R(A0, A1, A2)> callback(const Callback<R(A0, A1, A2)> &func) {
-    return Callback<R(A0, A1, A2)>(func);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param obj      Optional pointer to object to bind to function
- *  @param method   Member function to attach
- *  @return         Callback with infered type
- */
-template<typename T, typename U, typename R, typename A0, typename A1, typename A2>
-Callback<R(A0, A1, A2)> callback(U *obj, R (T::*method)(A0, A1, A2)) {
-    return Callback<R(A0, A1, A2)>(obj, method);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param obj      Optional pointer to object to bind to function
- *  @param method   Member function to attach
- *  @return         Callback with infered type
- */
-template<typename T, typename U, typename R, typename A0, typename A1, typename A2>
-Callback<R(A0, A1, A2)> callback(const U *obj, R (T::*method)(A0, A1, A2) const) {
-    return Callback<R(A0, A1, A2)>(obj, method);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param obj      Optional pointer to object to bind to function
- *  @param method   Member function to attach
- *  @return         Callback with infered type
- */
-template<typename T, typename U, typename R, typename A0, typename A1, typename A2>
-Callback<R(A0, A1, A2)> callback(volatile U *obj, R (T::*method)(A0, A1, A2) volatile) {
-    return Callback<R(A0, A1, A2)>(obj, method);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param obj      Optional pointer to object to bind to function
- *  @param method   Member function to attach
- *  @return         Callback with infered type
- */
-template<typename T, typename U, typename R, typename A0, typename A1, typename A2>
-Callback<R(A0, A1, A2)> callback(const volatile U *obj, R (T::*method)(A0, A1, A2) const volatile) {
-    return Callback<R(A0, A1, A2)>(obj, method);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @param arg      Pointer argument to function
- *  @return         Callback with infered type
- */
-template <typename T, typename U, typename R, typename A0, typename A1, typename A2>
-Callback<R(A0, A1, A2)> callback(R (*func)(T*, A0, A1, A2), U *arg) {
-    return Callback<R(A0, A1, A2)>(func, arg);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @param arg      Pointer argument to function
- *  @return         Callback with infered type
- */
-template <typename T, typename U, typename R, typename A0, typename A1, typename A2>
-Callback<R(A0, A1, A2)> callback(R (*func)(const T*, A0, A1, A2), const U *arg) {
-    return Callback<R(A0, A1, A2)>(func, arg);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @param arg      Pointer argument to function
- *  @return         Callback with infered type
- */
-template <typename T, typename U, typename R, typename A0, typename A1, typename A2>
-Callback<R(A0, A1, A2)> callback(R (*func)(volatile T*, A0, A1, A2), volatile U *arg) {
-    return Callback<R(A0, A1, A2)>(func, arg);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @param arg      Pointer argument to function
- *  @return         Callback with infered type
- */
-template <typename T, typename U, typename R, typename A0, typename A1, typename A2>
-Callback<R(A0, A1, A2)> callback(R (*func)(const volatile T*, A0, A1, A2), const volatile U *arg) {
-    return Callback<R(A0, A1, A2)>(func, arg);
-}
-
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @return         Callback with infered type
- */
-template <typename R, typename A0, typename A1, typename A2, typename A3>
-Callback<R(A0, A1, A2, A3)> callback(R (*func)(A0, A1, A2, A3) = 0) {
-    return Callback<R(A0, A1, A2, A3)>(func);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @return         Callback with infered type
- */
-template <typename R, typename A0, typename A1, typename A2, typename A3>
-Callback<R(A0, A1, A2, A3)> callback(const Callback<R(A0, A1, A2, A3)> &func) {
-    return Callback<R(A0, A1, A2, A3)>(func);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param obj      Optional pointer to object to bind to function
- *  @param method   Member function to attach
- *  @return         Callback with infered type
- */
-template<typename T, typename U, typename R, typename A0, typename A1, typename A2, typename A3>
-Callback<R(A0, A1, A2, A3)> callback(U *obj, R (T::*method)(A0, A1, A2, A3)) {
-    return Callback<R(A0, A1, A2, A3)>(obj, method);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param obj      Optional pointer to object to bind to function
- *  @param method   Member function to attach
- *  @return         Callback with infered type
- */
-template<typename T, typename U, typename R, typename A0, typename A1, typename A2, typename A3>
-Callback<R(A0, A1, A2, A3)> callback(const U *obj, R (T::*method)(A0, A1, A2, A3) const) {
-    return Callback<R(A0, A1, A2, A3)>(obj, method);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param obj      Optional pointer to object to bind to function
- *  @param method   Member function to attach
- *  @return         Callback with infered type
- */
-template<typename T, typename U, typename R, typename A0, typename A1, typename A2, typename A3>
-Callback<R(A0, A1, A2, A3)> callback(volatile U *obj, R (T::*method)(A0, A1, A2, A3) volatile) {
-    return Callback<R(A0, A1, A2, A3)>(obj, method);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param obj      Optional pointer to object to bind to function
- *  @param method   Member function to attach
- *  @return         Callback with infered type
- */
-template<typename T, typename U, typename R, typename A0, typename A1, typename A2, typename A3>
-Callback<R(A0, A1, A2, A3)> callback(const volatile U *obj, R (T::*method)(A0, A1, A2, A3) const volatile) {
-    return Callback<R(A0, A1, A2, A3)>(obj, method);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @param arg      Pointer argument to function
- *  @return         Callback with infered type
- */
-template <typename T, typename U, typename R, typename A0, typename A1, typename A2, typename A3>
-Callback<R(A0, A1, A2, A3)> callback(R (*func)(T*, A0, A1, A2, A3), U *arg) {
-    return Callback<R(A0, A1, A2, A3)>(func, arg);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @param arg      Pointer argument to function
- *  @return         Callback with infered type
- */
-template <typename T, typename U, typename R, typename A0, typename A1, typename A2, typename A3>
-Callback<R(A0, A1, A2, A3)> callback(R (*func)(const T*, A0, A1, A2, A3), const U *arg) {
-    return Callback<R(A0, A1, A2, A3)>(func, arg);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @param arg      Pointer argument to function
- *  @return         Callback with infered type
- */
-template <typename T, typename U, typename R, typename A0, typename A1, typename A2, typename A3>
-Callback<R(A0, A1, A2, A3)> callback(R (*func)(volatile T*, A0, A1, A2, A3), volatile U *arg) {
-    return Callback<R(A0, A1, A2, A3)>(func, arg);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @param arg      Pointer argument to function
- *  @return         Callback with infered type
- */
-template <typename T, typename U, typename R, typename A0, typename A1, typename A2, typename A3>
-Callback<R(A0, A1, A2, A3)> callback(R (*func)(const volatile T*, A0, A1, A2, A3), const volatile U *arg) {
-    return Callback<R(A0, A1, A2, A3)>(func, arg);
-}
+// Internally used event type
+typedef Callback<void(int)> event_callback_t;
 
 
 /** Create a callback class with type infered from the arguments
@@ -2583,9 +544,9 @@ Callback<R(A0, A1, A2, A3)> callback(R (*func)(const volatile T*, A0, A1, A2, A3
  *  @param func     Static function to attach
  *  @return         Callback with infered type
  */
-template <typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
-Callback<R(A0, A1, A2, A3, A4)> callback(R (*func)(A0, A1, A2, A3, A4) = 0) {
-    return Callback<R(A0, A1, A2, A3, A4)>(func);
+template <typename R, typename... ArgTs>
+Callback<R(ArgTs...)> callback(R (*func)(ArgTs...) = 0) {
+    return Callback<R(ArgTs...)>(func);
 }
 
 /** Create a callback class with type infered from the arguments
@@ -2593,9 +554,9 @@ Callback<R(A0, A1, A2, A3, A4)> callback(R (*func)(A0, A1, A2, A3, A4) = 0) {
  *  @param func     Static function to attach
  *  @return         Callback with infered type
  */
-template <typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
-Callback<R(A0, A1, A2, A3, A4)> callback(const Callback<R(A0, A1, A2, A3, A4)> &func) {
-    return Callback<R(A0, A1, A2, A3, A4)>(func);
+template <typename R, typename... ArgTs>
+Callback<R(ArgTs...)> callback(const Callback<R(ArgTs...)> &func) {
+    return Callback<R(ArgTs...)>(func);
 }
 
 /** Create a callback class with type infered from the arguments
@@ -2604,9 +565,9 @@ Callback<R(A0, A1, A2, A3, A4)> callback(const Callback<R(A0, A1, A2, A3, A4)> &
  *  @param method   Member function to attach
  *  @return         Callback with infered type
  */
-template<typename T, typename U, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
-Callback<R(A0, A1, A2, A3, A4)> callback(U *obj, R (T::*method)(A0, A1, A2, A3, A4)) {
-    return Callback<R(A0, A1, A2, A3, A4)>(obj, method);
+template<typename T, typename U, typename R, typename... ArgTs>
+Callback<R(ArgTs...)> callback(U *obj, R (T::*method)(ArgTs...)) {
+    return Callback<R(ArgTs...)>(obj, method);
 }
 
 /** Create a callback class with type infered from the arguments
@@ -2615,9 +576,9 @@ Callback<R(A0, A1, A2, A3, A4)> callback(U *obj, R (T::*method)(A0, A1, A2, A3,
  *  @param method   Member function to attach
  *  @return         Callback with infered type
  */
-template<typename T, typename U, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
-Callback<R(A0, A1, A2, A3, A4)> callback(const U *obj, R (T::*method)(A0, A1, A2, A3, A4) const) {
-    return Callback<R(A0, A1, A2, A3, A4)>(obj, method);
+template<typename T, typename U, typename R, typename... ArgTs>
+Callback<R(ArgTs...)> callback(const U *obj, R (T::*method)(ArgTs...) const) {
+    return Callback<R(ArgTs...)>(obj, method);
 }
 
 /** Create a callback class with type infered from the arguments
@@ -2626,9 +587,9 @@ Callback<R(A0, A1, A2, A3, A4)> callback(const U *obj, R (T::*method)(A0, A1, A2
  *  @param method   Member function to attach
  *  @return         Callback with infered type
  */
-template<typename T, typename U, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
-Callback<R(A0, A1, A2, A3, A4)> callback(volatile U *obj, R (T::*method)(A0, A1, A2, A3, A4) volatile) {
-    return Callback<R(A0, A1, A2, A3, A4)>(obj, method);
+template<typename T, typename U, typename R, typename... ArgTs>
+Callback<R(ArgTs...)> callback(volatile U *obj, R (T::*method)(ArgTs...) volatile) {
+    return Callback<R(ArgTs...)>(obj, method);
 }
 
 /** Create a callback class with type infered from the arguments
@@ -2637,42 +598,9 @@ Callback<R(A0, A1, A2, A3, A4)> callback(volatile U *obj, R (T::*method)(A0, A1,
  *  @param method   Member function to attach
  *  @return         Callback with infered type
  */
-template<typename T, typename U, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
-Callback<R(A0, A1, A2, A3, A4)> callback(const volatile U *obj, R (T::*method)(A0, A1, A2, A3, A4) const volatile) {
-    return Callback<R(A0, A1, A2, A3, A4)>(obj, method);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @param arg      Pointer argument to function
- *  @return         Callback with infered type
- */
-template <typename T, typename U, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
-Callback<R(A0, A1, A2, A3, A4)> callback(R (*func)(T*, A0, A1, A2, A3, A4), U *arg) {
-    return Callback<R(A0, A1, A2, A3, A4)>(func, arg);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @param arg      Pointer argument to function
- *  @return         Callback with infered type
- */
-template <typename T, typename U, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
-Callback<R(A0, A1, A2, A3, A4)> callback(R (*func)(const T*, A0, A1, A2, A3, A4), const U *arg) {
-    return Callback<R(A0, A1, A2, A3, A4)>(func, arg);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @param arg      Pointer argument to function
- *  @return         Callback with infered type
- */
-template <typename T, typename U, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
-Callback<R(A0, A1, A2, A3, A4)> callback(R (*func)(volatile T*, A0, A1, A2, A3, A4), volatile U *arg) {
-    return Callback<R(A0, A1, A2, A3, A4)>(func, arg);
+template<typename T, typename U, typename R, typename... ArgTs>
+Callback<R(ArgTs...)> callback(const volatile U *obj, R (T::*method)(ArgTs...) const volatile) {
+    return Callback<R(ArgTs...)>(obj, method);
 }
 
 /** Create a callback class with type infered from the arguments
@@ -2681,75 +609,9 @@ Callback<R(A0, A1, A2, A3, A4)> callback(R (*func)(volatile T*, A0, A1, A2, A3,
  *  @param arg      Pointer argument to function
  *  @return         Callback with infered type
  */
-template <typename T, typename U, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
-Callback<R(A0, A1, A2, A3, A4)> callback(R (*func)(const volatile T*, A0, A1, A2, A3, A4), const volatile U *arg) {
-    return Callback<R(A0, A1, A2, A3, A4)>(func, arg);
-}
-
-
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @return         Callback with infered type
- */
-template <typename R, typename A0, typename A1, typename A2, typename A3, typename A4, typename A5>
-Callback<R(A0, A1, A2, A3, A4, A5)> callback(R (*func)(A0, A1, A2, A3, A4, A5) = 0) {
-    return Callback<R(A0, A1, A2, A3, A4, A5)>(func);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param func     Static function to attach
- *  @return         Callback with infered type
- */
-template <typename R, typename A0, typename A1, typename A2, typename A3, typename A4, typename A5>
-Callback<R(A0, A1, A2, A3, A4, A5)> callback(const Callback<R(A0, A1, A2, A3, A4, A5)> &func) {
-    return Callback<R(A0, A1, A2, A3, A4, A5)>(func);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param obj      Optional pointer to object to bind to function
- *  @param method   Member function to attach
- *  @return         Callback with infered type
- */
-template<typename T, typename U, typename R, typename A0, typename A1, typename A2, typename A3, typename A4, typename A5>
-Callback<R(A0, A1, A2, A3, A4, A5)> callback(U *obj, R (T::*method)(A0, A1, A2, A3, A4, A5)) {
-    return Callback<R(A0, A1, A2, A3, A4, A5)>(obj, method);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param obj      Optional pointer to object to bind to function
- *  @param method   Member function to attach
- *  @return         Callback with infered type
- */
-template<typename T, typename U, typename R, typename A0, typename A1, typename A2, typename A3, typename A4, typename A5>
-Callback<R(A0, A1, A2, A3, A4, A5)> callback(const U *obj, R (T::*method)(A0, A1, A2, A3, A4, A5) const) {
-    return Callback<R(A0, A1, A2, A3, A4, A5)>(obj, method);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param obj      Optional pointer to object to bind to function
- *  @param method   Member function to attach
- *  @return         Callback with infered type
- */
-template<typename T, typename U, typename R, typename A0, typename A1, typename A2, typename A3, typename A4, typename A5>
-Callback<R(A0, A1, A2, A3, A4, A5)> callback(volatile U *obj, R (T::*method)(A0, A1, A2, A3, A4, A5) volatile) {
-    return Callback<R(A0, A1, A2, A3, A4, A5)>(obj, method);
-}
-
-/** Create a callback class with type infered from the arguments
- *
- *  @param obj      Optional pointer to object to bind to function
- *  @param method   Member function to attach
- *  @return         Callback with infered type
- */
-template<typename T, typename U, typename R, typename A0, typename A1, typename A2, typename A3, typename A4, typename A5>
-Callback<R(A0, A1, A2, A3, A4, A5)> callback(const volatile U *obj, R (T::*method)(A0, A1, A2, A3, A4, A5) const volatile) {
-    return Callback<R(A0, A1, A2, A3, A4, A5)>(obj, method);
+template <typename T, typename U, typename R, typename... ArgTs>
+Callback<R(ArgTs...)> callback(R (*func)(T*, ArgTs...), U *arg) {
+    return Callback<R(ArgTs...)>(func, arg);
 }
 
 /** Create a callback class with type infered from the arguments
@@ -2758,9 +620,9 @@ Callback<R(A0, A1, A2, A3, A4, A5)> callback(const volatile U *obj, R (T::*metho
  *  @param arg      Pointer argument to function
  *  @return         Callback with infered type
  */
-template <typename T, typename U, typename R, typename A0, typename A1, typename A2, typename A3, typename A4, typename A5>
-Callback<R(A0, A1, A2, A3, A4, A5)> callback(R (*func)(T*, A0, A1, A2, A3, A4, A5), U *arg) {
-    return Callback<R(A0, A1, A2, A3, A4, A5)>(func, arg);
+template <typename T, typename U, typename R, typename... ArgTs>
+Callback<R(ArgTs...)> callback(R (*func)(const T*, ArgTs...), const U *arg) {
+    return Callback<R(ArgTs...)>(func, arg);
 }
 
 /** Create a callback class with type infered from the arguments
@@ -2769,9 +631,9 @@ Callback<R(A0, A1, A2, A3, A4, A5)> callback(R (*func)(T*, A0, A1, A2, A3, A4, A
  *  @param arg      Pointer argument to function
  *  @return         Callback with infered type
  */
-template <typename T, typename U, typename R, typename A0, typename A1, typename A2, typename A3, typename A4, typename A5>
-Callback<R(A0, A1, A2, A3, A4, A5)> callback(R (*func)(const T*, A0, A1, A2, A3, A4, A5), const U *arg) {
-    return Callback<R(A0, A1, A2, A3, A4, A5)>(func, arg);
+template <typename T, typename U, typename R, typename... ArgTs>
+Callback<R(ArgTs...)> callback(R (*func)(volatile T*, ArgTs...), volatile U *arg) {
+    return Callback<R(ArgTs...)>(func, arg);
 }
 
 /** Create a callback class with type infered from the arguments
@@ -2780,22 +642,20 @@ Callback<R(A0, A1, A2, A3, A4, A5)> callback(R (*func)(const T*, A0, A1, A2, A3,
  *  @param arg      Pointer argument to function
  *  @return         Callback with infered type
  */
-template <typename T, typename U, typename R, typename A0, typename A1, typename A2, typename A3, typename A4, typename A5>
-Callback<R(A0, A1, A2, A3, A4, A5)> callback(R (*func)(volatile T*, A0, A1, A2, A3, A4, A5), volatile U *arg) {
-    return Callback<R(A0, A1, A2, A3, A4, A5)>(func, arg);
+template <typename T, typename U, typename R, typename... ArgTs>
+Callback<R(ArgTs...)> callback(R (*func)(const volatile T*, ArgTs...), const volatile U *arg) {
+    return Callback<R(ArgTs...)>(func, arg);
 }
 
-/** Create a callback class with type infered from the arguments
+/** Create a callback class with type infered from a function object, such as a capturing lambda
  *
- *  @param func     Static function to attach
- *  @param arg      Pointer argument to function
+ *  @param f        Function object to attach (with a single, non-template call operator)
  *  @return         Callback with infered type
  */
-template <typename T, typename U, typename R, typename A0, typename A1, typename A2, typename A3, typename A4, typename A5>
-Callback<R(A0, A1, A2, A3, A4, A5)> callback(R (*func)(const volatile T*, A0, A1, A2, A3, A4, A5), const volatile U *arg) {
-    return Callback<R(A0, A1, A2, A3, A4, A5)>(func, arg);
+template <typename F>
+Callback<typename detail::method_signature<decltype(&F::operator())>::type> callback(F f) {
+    return Callback<typename detail::method_signature<decltype(&F::operator())>::type>(detail::move(f));
 }
 
 
-
 #endif
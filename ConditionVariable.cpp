@@ -0,0 +1,95 @@
+/*
+ * ConditionVariable.cpp
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ */
+
+#include "ConditionVariable.h"
+
+
+
+//------------------------------------------------------------------------------------
+//-- PUBLIC METHODS IMPLEMENTATION ---------------------------------------------------
+//------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------
+ConditionVariable::ConditionVariable(Mutex &mutex) : _mutex(mutex) {
+	vPortCPUInitializeMutex(&_mux);
+}
+
+
+//------------------------------------------------------------------------------------
+void ConditionVariable::wait() {
+	wait_for(osWaitForever);
+}
+
+
+//------------------------------------------------------------------------------------
+bool ConditionVariable::wait_for(uint32_t millisec) {
+	MBED_ASSERT(!IS_ISR());
+	WaitList::Node node;
+
+	// se registra antes de liberar el mutex para no perder notificaciones intermedias
+	WaitList::enter(&_mux);
+	_waiters.enqueue(&node);
+	WaitList::exit(&_mux);
+	_mutex.unlock();
+
+	bool timedout = false;
+	TickType_t ticks = MBED_MILLIS_TO_TICK(millisec);
+	TickType_t start = xTaskGetTickCount();
+	bool signals = false;
+	for(;;){
+		TickType_t left = WaitList::remaining(start, ticks);
+		if(left > 0){
+			WaitList::block(left, &signals);
+		}
+		WaitList::enter(&_mux);
+		if(node.signaled){
+			WaitList::exit(&_mux);
+			break;
+		}
+		if(WaitList::remaining(start, ticks) == 0){
+			_waiters.remove(&node);
+			WaitList::exit(&_mux);
+			timedout = true;
+			break;
+		}
+		WaitList::exit(&_mux);
+	}
+	WaitList::rearm(signals);
+
+	_mutex.lock();
+	return timedout;
+}
+
+
+//------------------------------------------------------------------------------------
+void ConditionVariable::notify_one() {
+	BaseType_t woken = pdFALSE;
+	WaitList::enter(&_mux);
+	if(!_waiters.empty()){
+		_waiters.wake(_waiters.first(), &woken);
+	}
+	WaitList::exit(&_mux, woken);
+}
+
+
+//------------------------------------------------------------------------------------
+void ConditionVariable::notify_all() {
+	BaseType_t woken = pdFALSE;
+	WaitList::enter(&_mux);
+	while(!_waiters.empty()){
+		_waiters.wake(_waiters.first(), &woken);
+	}
+	WaitList::exit(&_mux, woken);
+}
+
+
+//------------------------------------------------------------------------------------
+ConditionVariable::~ConditionVariable() {
+	MBED_ASSERT(_waiters.empty());
+}
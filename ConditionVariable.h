@@ -0,0 +1,73 @@
+/*
+ * ConditionVariable.h
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ *	Portabilidad de la clase ConditionVariable de mbed-os v5x a ESP-IDF|FreeRtos, implementada sobre task notifications
+ *
+ */
+
+#ifndef MBED_CONDITIONVARIABLE_H
+#define MBED_CONDITIONVARIABLE_H
+
+#include "mbed_api.h"
+#include "Mutex.h"
+#include "WaitList.h"
+
+
+/** The ConditionVariable class is a synchronization primitive that allows threads to wait until a particular
+ * condition occurs.
+ *
+ * The mutex passed on construction must be locked by the caller before calling wait() or wait_for(). It is
+ * released while waiting and locked again before returning. Spurious wakeups are possible, so the condition
+ * must be checked in a loop:
+ * @code
+ * mutex.lock();
+ * while(!ready){
+ *     cond.wait();
+ * }
+ * mutex.unlock();
+ * @endcode
+ *
+ * @note
+ * Memory considerations: no heap is used. Waiting threads are linked through nodes on their own stack and
+ * woken with task notifications (@a osFlagsWakeup).
+ */
+class ConditionVariable  {
+public:
+    /** Create and Initialize a ConditionVariable object
+      @param  mutex     mutex protecting the condition
+    */
+    ConditionVariable(Mutex &mutex);
+
+    /** Wait for a notification. The mutex must be locked by the caller.
+     */
+    void wait();
+
+    /** Wait for a notification or timeout. The mutex must be locked by the caller.
+      @param   millisec  timeout value.
+      @return  true if the wait timed out, false if a notification was received.
+    */
+    bool wait_for(uint32_t millisec);
+
+    /** Notify one waiting thread (the oldest one). Can be called from interrupt context.
+     */
+    void notify_one();
+
+    /** Notify all waiting threads. Can be called from interrupt context.
+     */
+    void notify_all();
+
+    ~ConditionVariable();
+
+private:
+    Mutex& _mutex;				/// Mutex asociado a la condición
+    portMUX_TYPE _mux;			/// Spinlock de acceso a la lista de espera
+    WaitList _waiters;			/// Threads en espera
+};
+
+
+#endif
+
+/** @}*/
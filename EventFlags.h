@@ -17,6 +17,9 @@
  @note 
  EventFlags support 31 flags so the MSB flag is ignored, it is used to return an error code (@a osFlagsError)
  @note
+ set() from ISR is deferred through the timer daemon queue. Use TaskEventFlags when ISR-to-thread latency
+ matters or more than 24 flags are required.
+ @note
  Memory considerations: The EventFlags control structures will be created on current thread's stack, both for the mbed OS
  and underlying RTOS objects (static or dynamic RTOS memory pools are not being used).
 */
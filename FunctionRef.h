@@ -0,0 +1,240 @@
+/*
+ * FunctionRef.h
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ *	Referencias a funciones sin propiedad (FunctionRef) y callbacks ligadas en tiempo de compilación
+ *	(BoundCallback), para los caminos de ISR en los que la tabla de operaciones de Callback es demasiado costosa.
+ *
+ */
+
+#ifndef MBED_FUNCTIONREF_H
+#define MBED_FUNCTIONREF_H
+
+#include "Callback.h"
+
+
+template <typename F>
+class FunctionRef;
+
+template <typename M, M Method>
+class BoundCallback;
+
+namespace detail {
+    template <typename T>
+    struct is_function_ref { static const bool value = false; };
+
+    template <typename F>
+    struct is_function_ref<FunctionRef<F> > { static const bool value = true; };
+
+    template <typename T>
+    struct is_bound_callback { static const bool value = false; };
+
+    template <typename M, M Method>
+    struct is_bound_callback<BoundCallback<M, Method> > { static const bool value = true; };
+}
+
+
+/** FunctionRef class: a non-owning reference to a callable (function, function object or bound method).
+ *
+ * It is just an object pointer and a function pointer, so it is copied without any table of operations, and a call
+ * is a single indirect call. The referenced callable is not copied: it must outlive the FunctionRef.
+ *
+ * Construction from functions and function objects is explicit, so overloads taking a Callback or a FunctionRef are
+ * never ambiguous, and the owning Callback is kept as the implicit choice:
+ * @code
+ * Handler h;
+ * ticker.attach_us(FunctionRef<void()>(h), 1000);           // references h
+ * ticker.attach_us(MBED_BOUND_CALLBACK(&obj, &Obj::tick), 1000);
+ * @endcode
+ *
+ * @note Synchronization level: Not protected
+ */
+template <typename R, typename... ArgTs>
+class FunctionRef<R(ArgTs...)> {
+public:
+    /** Create an empty FunctionRef
+     */
+    FunctionRef() : _fn(0) {
+        _target._obj = 0;
+    }
+
+    /** Create a FunctionRef with an object and a function receiving it
+     *  @param obj      Object passed to fn
+     *  @param fn       Function to call
+     */
+    FunctionRef(void *obj, R (*fn)(void*, ArgTs...)) : _fn(fn) {
+        _target._obj = obj;
+    }
+
+    /** Create a FunctionRef with a static function
+     *  @param func     Static function to reference
+     */
+    explicit FunctionRef(R (*func)(ArgTs...)) : _fn((func)? &FunctionRef::static_call : 0) {
+        _target._func = func;
+    }
+
+    /** Create a FunctionRef with a function object, such as a lambda or a Callback
+     *  @param f        Function object to reference. It must outlive the FunctionRef
+     */
+    template <typename F>
+    explicit FunctionRef(F &f, typename detail::enable_if<
+            !detail::is_function_ref<typename detail::remove_cv<F>::type>::value &&
+            !detail::is_bound_callback<typename detail::remove_cv<F>::type>::value
+        >::type = detail::nil()) : _fn(&FunctionRef::functor_call<F>) {
+        _target._obj = (void*)&f;
+    }
+
+    /** Call the referenced function
+     */
+    R call(ArgTs... args) const {
+        MBED_ASSERT(_fn);
+        return _fn(_target._obj, detail::forward<ArgTs>(args)...);
+    }
+
+    /** Call the referenced function
+     */
+    R operator()(ArgTs... args) const {
+        return call(detail::forward<ArgTs>(args)...);
+    }
+
+    /** Test if a function is referenced
+     */
+    operator bool() const {
+        return _fn;
+    }
+
+    /** Test for equality
+     */
+    friend bool operator==(const FunctionRef &l, const FunctionRef &r) {
+        return l._fn == r._fn && l._target._obj == r._target._obj;
+    }
+
+    /** Test for inequality
+     */
+    friend bool operator!=(const FunctionRef &l, const FunctionRef &r) {
+        return !(l == r);
+    }
+
+private:
+    // Object or static function passed to _fn. Both are stored in the same word
+    union {
+        void *_obj;
+        R (*_func)(ArgTs...);
+    } _target;
+    R (*_fn)(void*, ArgTs...);
+
+    static R static_call(void *p, ArgTs... args) {
+        // el puntero a función se almacena en la misma palabra que el objeto
+        union {
+            void *_obj;
+            R (*_func)(ArgTs...);
+        } target;
+        target._obj = p;
+        return target._func(detail::forward<ArgTs>(args)...);
+    }
+
+    template <typename F>
+    static R functor_call(void *p, ArgTs... args) {
+        return (*(F*)p)(detail::forward<ArgTs>(args)...);
+    }
+};
+
+
+/** BoundCallback class: a member function bound at compile time to an object.
+ *
+ * The method is a template parameter, so calling a BoundCallback (or its static thunk) is a direct call to the method,
+ * which the compiler can inline. It converts to a FunctionRef with a single indirect call to that thunk, and it can
+ * be passed to the InterruptIn and Ticker overloads that dispatch without Callback's table of operations.
+ * @code
+ * BoundCallback<void (Led::*)(), &Led::toggle> bound(&led);
+ * button.rise(bound);
+ * button.fall(MBED_BOUND_CALLBACK(&led, &Led::toggle));
+ * @endcode
+ *
+ * @note Synchronization level: Not protected
+ */
+template <typename T, typename R, typename... ArgTs, R (T::*Method)(ArgTs...)>
+class BoundCallback<R (T::*)(ArgTs...), Method> {
+public:
+    /** Bind the method to an object
+     *  @param obj      Object to invoke the method on. It must outlive the BoundCallback and its FunctionRef
+     */
+    explicit BoundCallback(T *obj) : _obj(obj) {}
+
+    /** Call the bound method
+     */
+    R call(ArgTs... args) const {
+        return (_obj->*Method)(detail::forward<ArgTs>(args)...);
+    }
+
+    /** Call the bound method
+     */
+    R operator()(ArgTs... args) const {
+        return call(detail::forward<ArgTs>(args)...);
+    }
+
+    /** Static thunk for passing as C-style function
+     *  @param obj      Object passed as void pointer
+     */
+    static R thunk(void *obj, ArgTs... args) {
+        return (static_cast<T*>(obj)->*Method)(detail::forward<ArgTs>(args)...);
+    }
+
+    /** Reference the bound method without Callback's table of operations
+     */
+    operator FunctionRef<R(ArgTs...)>() const {
+        return FunctionRef<R(ArgTs...)>((void*)_obj, &BoundCallback::thunk);
+    }
+
+    /** Get the bound object
+     */
+    T *object() const {
+        return _obj;
+    }
+
+private:
+    T *_obj;
+};
+
+
+/** BoundCallback class for const member functions
+ */
+template <typename T, typename R, typename... ArgTs, R (T::*Method)(ArgTs...) const>
+class BoundCallback<R (T::*)(ArgTs...) const, Method> {
+public:
+    explicit BoundCallback(const T *obj) : _obj(obj) {}
+
+    R call(ArgTs... args) const {
+        return (_obj->*Method)(detail::forward<ArgTs>(args)...);
+    }
+
+    R operator()(ArgTs... args) const {
+        return call(detail::forward<ArgTs>(args)...);
+    }
+
+    static R thunk(void *obj, ArgTs... args) {
+        return (static_cast<const T*>(obj)->*Method)(detail::forward<ArgTs>(args)...);
+    }
+
+    operator FunctionRef<R(ArgTs...)>() const {
+        return FunctionRef<R(ArgTs...)>((void*)_obj, &BoundCallback::thunk);
+    }
+
+    const T *object() const {
+        return _obj;
+    }
+
+private:
+    const T *_obj;
+};
+
+
+/** Create a BoundCallback with the type infered from the method: MBED_BOUND_CALLBACK(&obj, &Class::method) */
+#define MBED_BOUND_CALLBACK(obj, method)		BoundCallback<decltype(method), method>(obj)
+
+
+#endif
+
+/** @}*/
@@ -0,0 +1,170 @@
+/*
+ * HighResTimer.cpp
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ */
+
+#include "HighResTimer.h"
+#include "esp_freertos_hooks.h"
+#include <xtensa/hal.h>
+
+
+
+//------------------------------------------------------------------------------------
+//---- STATIC ------------------------------------------------------------------------
+//------------------------------------------------------------------------------------
+
+uint32_t HighResTimer::_cc_offset[portNUM_PROCESSORS];
+bool HighResTimer::_cc_ready[portNUM_PROCESSORS] = {false};
+uint32_t HighResTimer::_cc_last[portNUM_PROCESSORS];
+uint32_t HighResTimer::_cc_high[portNUM_PROCESSORS];
+bool HighResTimer::_cc_hooked[portNUM_PROCESSORS] = {false};
+volatile uint32_t HighResTimer::_cc_hooks = 0;
+
+/** Frecuencia de CPU en MHz (constante: no se admite escalado dinámico de frecuencia) */
+static const uint32_t CpuMHz = CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ;
+
+static const char* _MODULE_ = "[HighResTimer]";
+#define _EXPR_	(!IS_ISR())
+#if !defined(MBED_TRACE_LEVEL_HIGHRESTIMER)
+#define MBED_TRACE_LEVEL_HIGHRESTIMER	MBED_TRACE_LEVEL
+#endif
+#define _LEVEL_	MBED_TRACE_LEVEL_HIGHRESTIMER
+
+
+
+//------------------------------------------------------------------------------------
+//-- PUBLIC METHODS IMPLEMENTATION ---------------------------------------------------
+//------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------
+HighResTimer::HighResTimer(Source source) : _source(source), _running(false), _start(0), _stopped(0), _lap(0), _split(0), _laps(0) {
+	Ticker_HAL::start();
+	installHooks();
+	// factores de conversión en coma fija, calculados una única vez. Ambas fuentes son múltiplos de 1MHz
+	uint32_t mhz = (_source == SourceCycles)? CpuMHz : (Ticker_HAL::TimerScale / 1000000);
+	_freq = mhz * 1000000;
+	_us_mult = (UINT64_MAX / mhz) + 1;
+	_ns_int = 1000 / mhz;
+	_ns_frac = (uint64_t)(1000 % mhz) * _us_mult;
+}
+
+
+//------------------------------------------------------------------------------------
+void HighResTimer::start() {
+	if(!_running){
+		// reanuda descontando el tiempo acumulado hasta la parada
+		_start = now(_source) - _stopped;
+		_running = true;
+	}
+}
+
+
+//------------------------------------------------------------------------------------
+void HighResTimer::stop() {
+	if(_running){
+		_stopped = now(_source) - _start;
+		_running = false;
+	}
+}
+
+
+//------------------------------------------------------------------------------------
+void HighResTimer::reset() {
+	_start = now(_source);
+	_stopped = 0;
+	_lap = 0;
+	_split = 0;
+	_laps = 0;
+}
+
+
+//------------------------------------------------------------------------------------
+uint64_t HighResTimer::elapsed_ticks() {
+	return (_running)? (now(_source) - _start) : _stopped;
+}
+
+
+//------------------------------------------------------------------------------------
+uint64_t HighResTimer::lap() {
+	uint64_t elapsed = elapsed_ticks();
+	uint64_t result = elapsed - _lap;
+	_lap = elapsed;
+	_laps++;
+	return result;
+}
+
+
+//------------------------------------------------------------------------------------
+uint64_t HighResTimer::split() {
+	_split = elapsed_ticks();
+	return _split;
+}
+
+
+//------------------------------------------------------------------------------------
+uint64_t IRAM_ATTR HighResTimer::cycles() {
+	// el estado de cada core sólo se modifica desde ese core y con sus interrupciones deshabilitadas
+	uint32_t state = portENTER_CRITICAL_NESTED();
+	uint32_t core = xPortGetCoreID();
+	uint32_t ccount = xthal_get_ccount();
+	// la primera lectura en cada core calibra su corrección respecto de la base común
+	if(!_cc_ready[core]){
+		_cc_offset[core] = (uint32_t)(Ticker_HAL::now_ticks() * Ticker_HAL::CyclesPerTick) - ccount;
+		_cc_ready[core] = true;
+		resync(core, ccount + _cc_offset[core]);
+	}
+	uint32_t fine = ccount + _cc_offset[core];
+	// la base común sólo se consulta al desbordar CCOUNT si el hook del tick asegura que no pasa un desbordamiento
+	// completo sin lecturas. Sin él, se consulta en cada lectura
+	if(fine < _cc_last[core] || !_cc_hooked[core]){
+		resync(core, fine);
+	}
+	_cc_last[core] = fine;
+	uint64_t result = ((uint64_t)_cc_high[core] << 32) | fine;
+	portEXIT_CRITICAL_NESTED(state);
+	return result;
+}
+
+
+
+//------------------------------------------------------------------------------------
+//-- PRIVATE METHODS IMPLEMENTATION --------------------------------------------------
+//------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------
+void IRAM_ATTR HighResTimer::resync(uint32_t core, uint32_t fine) {
+	// CCOUNT corregido aporta los 32 bits bajos con resolución de ciclo y la base común, la parte alta. Ambos
+	// difieren en menos de 2^31 ciclos, por lo que la diferencia con signo resuelve los desbordamientos de CCOUNT
+	uint64_t coarse = Ticker_HAL::now_ticks() * Ticker_HAL::CyclesPerTick;
+	uint64_t value = coarse + (int64_t)(int32_t)(fine - (uint32_t)coarse);
+	_cc_high[core] = (uint32_t)(value >> 32);
+}
+
+
+//------------------------------------------------------------------------------------
+void IRAM_ATTR HighResTimer::tickHook() {
+	cycles();
+}
+
+
+//------------------------------------------------------------------------------------
+void HighResTimer::installHooks() {
+	uint32_t expected = 0;
+	if(!__atomic_compare_exchange_n(&_cc_hooks, &expected, 1, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)){
+		return;
+	}
+	// si no quedan hooks libres en un core, sus lecturas siguen consultando la base común
+	for(int core = 0; core < portNUM_PROCESSORS; core++){
+		if(esp_register_freertos_tick_hook_for_cpu(&HighResTimer::tickHook, core) == ESP_OK){
+			__atomic_store_n(&_cc_hooked[core], true, __ATOMIC_RELEASE);
+		}
+		else{
+			DEBUG_TRACE_E(_EXPR_, _MODULE_, "Sin hook del tick en el core %d, se consulta la base común en cada lectura", core);
+		}
+	}
+}
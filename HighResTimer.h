@@ -0,0 +1,182 @@
+/*
+ * HighResTimer.h
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ *	Cronómetro de alta resolución con cuenta de 64 bits, vueltas (lap) y tiempos parciales (split), para medir
+ *	bucles críticos sin pasar por el driver del timer ni realizar divisiones de 64 bits en cada lectura.
+ *
+ */
+
+#ifndef MBED_HIGHRESTIMER_H
+#define MBED_HIGHRESTIMER_H
+
+#include "mbed_api.h"
+#include "Ticker_HAL.h"
+
+
+/** The HighResTimer class measures elapsed time with 64-bit ticks and sub-microsecond resolution.
+ *
+ * Two time sources are available:
+ * - SourceTimer: the common Ticker_HAL time base (TimerScale, 0.2us), read directly from its registers.
+ * - SourceCycles: the CPU cycle counter (CCOUNT, 1/CPU_FREQ). CCOUNT is a 32-bit counter local to each core, so it
+ *   is corrected with a per-core offset calibrated against the common time base and extended to 64 bits in
+ *   software with a per-core high word. The time base is only read again when CCOUNT wraps (every 2^32 cycles), and
+ *   a FreeRTOS tick hook on each core, registered by the first HighResTimer constructed, guarantees that no wrap goes
+ *   unnoticed. Until then, or on a core with no free tick hook slot, every read falls back to the time base, which
+ *   is slower but never loses a wrap. Timestamps taken on different cores are therefore comparable and a task may
+ *   migrate between reads. It assumes a fixed CPU frequency (no dynamic frequency scaling).
+ *
+ * Conversions to ns and us use fixed-point factors computed on construction, so there is no division on reads.
+ *
+ * @code
+ * HighResTimer t;
+ * t.start();
+ * for(...){
+ *     work();
+ *     uint64_t lap = t.lap();			// ticks of this iteration
+ * }
+ * uint64_t total_ns = t.ticks_to_ns(t.elapsed_ticks());
+ * @endcode
+ */
+class HighResTimer  {
+public:
+
+	/** Fuente de tiempo
+	 */
+	enum Source {
+		SourceTimer = 0,			/// Base de tiempos de Ticker_HAL (TimerScale)
+		SourceCycles,				/// Contador de ciclos de CPU (CCOUNT) con corrección entre cores
+	};
+
+    /** Create a stopped HighResTimer
+      @param source time source. (default: SourceCycles)
+    */
+    HighResTimer(Source source = SourceCycles);
+
+    /** Start (or resume) the timer
+     */
+    void start();
+
+    /** Stop the timer. Elapsed time is kept
+     */
+    void stop();
+
+    /** Reset elapsed time, laps and splits to 0. If it was counting, it continues
+     */
+    void reset();
+
+    /** Get the elapsed time
+      @return elapsed ticks of the selected source
+     */
+    uint64_t elapsed_ticks();
+
+    /** Close the current lap and start a new one
+      @return ticks elapsed since the previous lap (or since start)
+     */
+    uint64_t lap();
+
+    /** Take a split time without closing the current lap
+      @return ticks elapsed since start, also kept in last_split()
+     */
+    uint64_t split();
+
+    /** Get the last split time
+      @return ticks of the last split()
+     */
+    uint64_t last_split() const { return _split; }
+
+    /** Get the number of closed laps
+      @return laps
+     */
+    uint32_t laps() const { return _laps; }
+
+    /** Get the elapsed time in nanoseconds
+      @return elapsed ns
+     */
+    uint64_t elapsed_ns() { return ticks_to_ns(elapsed_ticks()); }
+
+    /** Get the elapsed time in microseconds
+      @return elapsed us
+     */
+    uint64_t elapsed_us() { return ticks_to_us(elapsed_ticks()); }
+
+    /** Convert ticks of the selected source to nanoseconds, without division
+      @param ticks ticks
+      @return ns
+     */
+    uint64_t ticks_to_ns(uint64_t ticks) const {
+    	return (ticks * _ns_int) + Ticker_HAL::mulhi64(ticks, _ns_frac);
+    }
+
+    /** Convert ticks of the selected source to microseconds, without division
+      @param ticks ticks
+      @return us
+     */
+    uint64_t ticks_to_us(uint64_t ticks) const {
+    	return Ticker_HAL::mulhi64(ticks, _us_mult);
+    }
+
+    /** Get the frequency of the selected source
+      @return ticks per second
+     */
+    uint32_t frequency() const { return _freq; }
+
+    /** Get the selected source
+      @return source
+     */
+    Source source() const { return _source; }
+
+    /** Read the current value of a time source
+      @param source time source
+      @return ticks
+     */
+    static inline uint64_t now(Source source) {
+    	return (source == SourceCycles)? cycles() : Ticker_HAL::now_ticks();
+    }
+
+    /** Read the CPU cycle counter extended to 64 bits and aligned between cores
+      @return cycles since the common time base was started
+     */
+    static uint64_t cycles();
+
+private:
+    Source _source;					/// Fuente de tiempo
+    uint32_t _freq;					/// Frecuencia de la fuente
+    uint32_t _ns_int;				/// Parte entera de ns por tick
+    uint64_t _ns_frac;				/// Parte fraccionaria de ns por tick (coma fija 0.64)
+    uint64_t _us_mult;				/// us por tick (coma fija 0.64)
+    bool _running;					/// Cronómetro en marcha
+    uint64_t _start;				/// Instante de arranque (descontadas las paradas)
+    uint64_t _stopped;				/// Tiempo acumulado al detenerse
+    uint64_t _lap;					/// Tiempo transcurrido al cerrar la última vuelta
+    uint64_t _split;				/// Último tiempo parcial
+    uint32_t _laps;					/// Vueltas cerradas
+
+    static uint32_t _cc_offset[portNUM_PROCESSORS];		/// Corrección de CCOUNT de cada core respecto de la base común
+    static bool _cc_ready[portNUM_PROCESSORS];			/// Corrección calibrada
+    static uint32_t _cc_last[portNUM_PROCESSORS];		/// Última lectura corregida de cada core (32 bits bajos)
+    static uint32_t _cc_high[portNUM_PROCESSORS];		/// 32 bits altos de la última lectura de cada core
+    static bool _cc_hooked[portNUM_PROCESSORS];			/// Hook del tick registrado (sin él, se resincroniza en cada lectura)
+    static volatile uint32_t _cc_hooks;					/// Registro de los hooks iniciado
+
+    /** Recalcula la parte alta de un core a partir de la base común. Se llama con las interrupciones deshabilitadas
+      @param core core actual
+      @param fine lectura corregida de CCOUNT
+     */
+    static void resync(uint32_t core, uint32_t fine);
+
+    /** Hook del tick de FreeRTOS de cada core: lee el contador para detectar todos sus desbordamientos
+     */
+    static void tickHook();
+
+    /** Registra el hook del tick en cada core. Sólo lo hace el primer llamante, desde tarea
+     */
+    static void installHooks();
+};
+
+
+#endif
+
+/** @}*/
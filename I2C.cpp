@@ -7,6 +7,7 @@
  */
 
 #include "I2C.h"
+#include "Profile.h"
 
 
 
@@ -15,6 +16,10 @@
 //------------------------------------------------------------------------------------
 static const char* _MODULE_ = "[I2C]...........";
 #define _EXPR_	(_debug && !IS_ISR())
+#if !defined(MBED_TRACE_LEVEL_I2C)
+#define MBED_TRACE_LEVEL_I2C	MBED_TRACE_LEVEL
+#endif
+#define _LEVEL_	MBED_TRACE_LEVEL_I2C
 
 
 
@@ -75,6 +80,7 @@ void I2C::frequency(int hz) {
 //------------------------------------------------------------------------------------
 // write - Master Transmitter Mode
 int I2C::write(int address, const char* data, int length, bool repeated) {
+	PROFILE_SCOPE("I2C::write");
     lock();
 	DEBUG_TRACE_D(_EXPR_, _MODULE_, "Escribiendo %d bytes: ", length);
     DEBUG_TRACE_D(_EXPR_, _MODULE_, "creando comando, ");
@@ -120,6 +126,7 @@ int I2C::write(int data) {
 //------------------------------------------------------------------------------------
 // read - Master Reciever Mode
 int I2C::read(int address, char* data, int length, bool repeated) {
+	PROFILE_SCOPE("I2C::read");
 	DEBUG_TRACE_D(_EXPR_, _MODULE_, "Leyendo %d bytes: ", length);
     lock();
     DEBUG_TRACE_D(_EXPR_, _MODULE_, "creando comando, ");
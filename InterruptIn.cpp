@@ -21,6 +21,10 @@
  */
 static const char* _MODULE_ = "[InterruptIn]...";
 #define _EXPR_	(_defdbg && !IS_ISR())
+#if !defined(MBED_TRACE_LEVEL_INTERRUPTIN)
+#define MBED_TRACE_LEVEL_INTERRUPTIN	MBED_TRACE_LEVEL
+#endif
+#define _LEVEL_	MBED_TRACE_LEVEL_INTERRUPTIN
 
 
 
@@ -57,6 +61,13 @@ static void defaultIsrHandler(){
 }
 
 
+//------------------------------------------------------------------------------------
+/** Comprueba si un flanco tiene destino propio: una referencia directa o una Callback distinta de la por defecto */
+static inline bool installed(const Callback<void()>& func, const FunctionRef<void()>& ref){
+	return ref || (func != callback(&defaultIsrHandler));
+}
+
+
 
 //------------------------------------------------------------------------------------
 //-- PUBLIC METHODS IMPLEMENTATION ---------------------------------------------------
@@ -151,45 +162,95 @@ void InterruptIn::mode(PinMode pull) {
 
 //------------------------------------------------------------------------------------
 void InterruptIn::rise(Callback<void()> func) {
-	if(func){
-		_rise = func;
-		_gpio.intr_type = (gpio_int_type_t)(_gpio.intr_type | GPIO_INTR_POSEDGE);
-		DEBUG_TRACE_D(_EXPR_, _MODULE_, "Activando isr-rise intr_type = %d", _gpio.intr_type);
+	// la interrupcin se desactiva mientras se cambia su destino
+	setEdge(GPIO_INTR_POSEDGE, false);
+	_rise = (func)? func : callback(&defaultIsrHandler);
+	_rise_ref = FunctionRef<void()>();
+	// los observadores de la cadena mantienen la interrupcin activa
+	if(func || !_rise_chain.empty()){
+		setEdge(GPIO_INTR_POSEDGE, true);
 	}
-	else{
-		_rise = callback(&defaultIsrHandler);
-		_gpio.intr_type = (gpio_int_type_t)(_gpio.intr_type & (~GPIO_INTR_POSEDGE));
-		DEBUG_TRACE_D(_EXPR_, _MODULE_, "Desactivando isr-rise intr_type = %d", _gpio.intr_type);
+}
+
+
+//------------------------------------------------------------------------------------
+void InterruptIn::rise(FunctionRef<void()> func) {
+	setEdge(GPIO_INTR_POSEDGE, false);
+	_rise = callback(&defaultIsrHandler);
+	_rise_ref = func;
+	if(_rise_ref || !_rise_chain.empty()){
+		setEdge(GPIO_INTR_POSEDGE, true);
 	}
-	DEBUG_CHECK(gpio_set_intr_type(_pin, _gpio.intr_type));
-	if(_gpio.intr_type != GPIO_INTR_DISABLE){
-		DEBUG_CHECK(gpio_isr_handler_add(_pin, gpio_isr_handler, (void*)this));
+}
+
+
+//------------------------------------------------------------------------------------
+bool InterruptIn::rise_add(CallChain::Link* link) {
+	if(!_rise_chain.add(link)){
+		return false;
 	}
-	else{
-		DEBUG_CHECK(gpio_isr_handler_remove(_pin));
+	if(!(_gpio.intr_type & GPIO_INTR_POSEDGE)){
+		setEdge(GPIO_INTR_POSEDGE, true);
 	}
+	return true;
+}
+
+
+//------------------------------------------------------------------------------------
+bool InterruptIn::rise_remove(CallChain::Link* link) {
+	if(!_rise_chain.remove(link)){
+		return false;
+	}
+	if(!installed(_rise, _rise_ref) && _rise_chain.empty()){
+		setEdge(GPIO_INTR_POSEDGE, false);
+	}
+	return true;
 }
 
 
 //------------------------------------------------------------------------------------
 void InterruptIn::fall(Callback<void()> func) {
-	if(func){
-		_fall = func;
-		_gpio.intr_type = (gpio_int_type_t)(_gpio.intr_type | GPIO_INTR_NEGEDGE);
-		DEBUG_TRACE_D(_EXPR_, _MODULE_, "Activando isr-fall intr_type = %d", _gpio.intr_type);
+	setEdge(GPIO_INTR_NEGEDGE, false);
+	_fall = (func)? func : callback(&defaultIsrHandler);
+	_fall_ref = FunctionRef<void()>();
+	if(func || !_fall_chain.empty()){
+		setEdge(GPIO_INTR_NEGEDGE, true);
 	}
-	else{
-		_fall = callback(&defaultIsrHandler);
-		_gpio.intr_type = (gpio_int_type_t)(_gpio.intr_type & (~GPIO_INTR_NEGEDGE));
-		DEBUG_TRACE_D(_EXPR_, _MODULE_, "Desactivando isr-fall intr_type = %d", _gpio.intr_type);
+}
+
+
+//------------------------------------------------------------------------------------
+void InterruptIn::fall(FunctionRef<void()> func) {
+	setEdge(GPIO_INTR_NEGEDGE, false);
+	_fall = callback(&defaultIsrHandler);
+	_fall_ref = func;
+	if(_fall_ref || !_fall_chain.empty()){
+		setEdge(GPIO_INTR_NEGEDGE, true);
 	}
-	DEBUG_CHECK(gpio_set_intr_type(_pin, _gpio.intr_type));
-	if(_gpio.intr_type != GPIO_INTR_DISABLE){
-		DEBUG_CHECK(gpio_isr_handler_add(_pin, gpio_isr_handler, (void*)this));
+}
+
+
+//------------------------------------------------------------------------------------
+bool InterruptIn::fall_add(CallChain::Link* link) {
+	if(!_fall_chain.add(link)){
+		return false;
 	}
-	else{
-		DEBUG_CHECK(gpio_isr_handler_remove(_pin));
+	if(!(_gpio.intr_type & GPIO_INTR_NEGEDGE)){
+		setEdge(GPIO_INTR_NEGEDGE, true);
+	}
+	return true;
+}
+
+
+//------------------------------------------------------------------------------------
+bool InterruptIn::fall_remove(CallChain::Link* link) {
+	if(!_fall_chain.remove(link)){
+		return false;
 	}
+	if(!installed(_fall, _fall_ref) && _fall_chain.empty()){
+		setEdge(GPIO_INTR_NEGEDGE, false);
+	}
+	return true;
 }
 
 
@@ -219,10 +280,27 @@ void InterruptIn::_irq_handler(uint32_t id, gpio_irq_event event) {
     InterruptIn *handler = (InterruptIn*)id;
     switch (event) {
         case IRQ_RISE:
-            handler->_rise.call();
+            // la Callback se invoca directamente; la referencia slo si se instal una
+            if(handler->_rise_ref){
+                handler->_rise_ref.call();
+            }
+            else{
+                handler->_rise.call();
+            }
+            if(!handler->_rise_chain.empty()){
+                handler->_rise_chain.call();
+            }
             break;
         case IRQ_FALL:
-            handler->_fall.call();
+            if(handler->_fall_ref){
+                handler->_fall_ref.call();
+            }
+            else{
+                handler->_fall.call();
+            }
+            if(!handler->_fall_chain.empty()){
+                handler->_fall_chain.call();
+            }
             break;
         case IRQ_NONE: break;
     }
@@ -233,4 +311,24 @@ void InterruptIn::_irq_handler(uint32_t id, gpio_irq_event event) {
 //------------------------------------------------------------------------------------
 
 
+//------------------------------------------------------------------------------------
+void InterruptIn::setEdge(gpio_int_type_t edge, bool enable) {
+	if(enable){
+		_gpio.intr_type = (gpio_int_type_t)(_gpio.intr_type | edge);
+		DEBUG_TRACE_D(_EXPR_, _MODULE_, "Activando isr %s intr_type = %d", (edge == GPIO_INTR_POSEDGE)? "rise" : "fall", _gpio.intr_type);
+	}
+	else{
+		_gpio.intr_type = (gpio_int_type_t)(_gpio.intr_type & (~edge));
+		DEBUG_TRACE_D(_EXPR_, _MODULE_, "Desactivando isr %s intr_type = %d", (edge == GPIO_INTR_POSEDGE)? "rise" : "fall", _gpio.intr_type);
+	}
+	DEBUG_CHECK(gpio_set_intr_type(_pin, _gpio.intr_type));
+	if(_gpio.intr_type != GPIO_INTR_DISABLE){
+		DEBUG_CHECK(gpio_isr_handler_add(_pin, gpio_isr_handler, (void*)this));
+	}
+	else{
+		DEBUG_CHECK(gpio_isr_handler_remove(_pin));
+	}
+}
+
+
 
@@ -12,6 +12,7 @@
 #define INTERRUPTIN_H
 
 #include "mbed_api.h"
+#include "CallChain.h"
 
 
 class InterruptIn  {
@@ -46,6 +47,41 @@ public:
     void rise(Callback<void()> func);
 
 
+    /** Attach a function reference to call when a rising edge occurs on the input. The interrupt calls it directly,
+     *  without Callback's table of operations
+     *
+     *  @param func A reference to a function (it must outlive the attachment), or an empty one to set as none
+     */
+    void rise(FunctionRef<void()> func);
+
+
+    /** Attach a member function bound at compile time to call when a rising edge occurs on the input
+     *
+     *  @param func Bound member function (see MBED_BOUND_CALLBACK)
+     */
+    template <typename M, M Method>
+    void rise(const BoundCallback<M, Method> &func) {
+        rise(FunctionRef<void()>(func));
+    }
+
+
+    /** Add a link to the chain of observers called on each rising edge, after the attached function. It can be
+     *  used together with rise(), and by several components at once
+     *
+     *  @param link Link to add. It must stay alive until it is removed
+     *  @returns true if added, false if the link is empty or already in a chain
+     */
+    bool rise_add(CallChain::Link* link);
+
+
+    /** Remove a link from the chain of rising edge observers. On return the interrupt no longer uses it
+     *
+     *  @param link Link to remove
+     *  @returns true if it was in the chain
+     */
+    bool rise_remove(CallChain::Link* link);
+
+
     /** Attach a function to call when a falling edge occurs on the input
      *
      *  @param func A pointer to a void function, or 0 to set as none
@@ -53,6 +89,40 @@ public:
     void fall(Callback<void()> func);
 
 
+    /** Attach a function reference to call when a falling edge occurs on the input. The interrupt calls it directly,
+     *  without Callback's table of operations
+     *
+     *  @param func A reference to a function (it must outlive the attachment), or an empty one to set as none
+     */
+    void fall(FunctionRef<void()> func);
+
+
+    /** Attach a member function bound at compile time to call when a falling edge occurs on the input
+     *
+     *  @param func Bound member function (see MBED_BOUND_CALLBACK)
+     */
+    template <typename M, M Method>
+    void fall(const BoundCallback<M, Method> &func) {
+        fall(FunctionRef<void()>(func));
+    }
+
+
+    /** Add a link to the chain of observers called on each falling edge, after the attached function
+     *
+     *  @param link Link to add. It must stay alive until it is removed
+     *  @returns true if added, false if the link is empty or already in a chain
+     */
+    bool fall_add(CallChain::Link* link);
+
+
+    /** Remove a link from the chain of falling edge observers. On return the interrupt no longer uses it
+     *
+     *  @param link Link to remove
+     *  @returns true if it was in the chain
+     */
+    bool fall_remove(CallChain::Link* link);
+
+
     /** Set the input pin mode
      *
      *  @param pull PullUp, PullDown, PullNone
@@ -77,6 +147,16 @@ private:
     bool _defdbg;
     Callback<void()> _rise;
     Callback<void()> _fall;
+    FunctionRef<void()> _rise_ref;		/// Referencia directa instalada con rise(FunctionRef). Vaca si el destino es _rise
+    FunctionRef<void()> _fall_ref;		/// Referencia directa instalada con fall(FunctionRef). Vaca si el destino es _fall
+    CallChain _rise_chain;				/// Observadores del flanco de subida
+    CallChain _fall_chain;				/// Observadores del flanco de bajada
+
+    /** Activa o desactiva la interrupcin de un flanco
+     *  @param edge Flanco (GPIO_INTR_POSEDGE, GPIO_INTR_NEGEDGE)
+     *  @param enable Activar
+     */
+    void setEdge(gpio_int_type_t edge, bool enable);
 };
 
 
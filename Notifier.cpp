@@ -0,0 +1,134 @@
+/*
+ * Notifier.cpp
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ */
+
+#include "Notifier.h"
+#include "WaitList.h"
+
+
+
+//------------------------------------------------------------------------------------
+//-- PUBLIC METHODS IMPLEMENTATION ---------------------------------------------------
+//------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------
+Notifier::Notifier(Thread* thread) : _thread(thread), _tid(NULL), _pending(0) {
+	MBED_ASSERT(_thread);
+}
+
+
+//------------------------------------------------------------------------------------
+Notifier::Notifier(osThreadId tid) : _thread(NULL), _tid(tid), _pending(0) {
+}
+
+
+//------------------------------------------------------------------------------------
+void Notifier::bind(osThreadId tid) {
+	_thread = NULL;
+	_tid = tid;
+	__atomic_store_n(&_pending, 0, __ATOMIC_SEQ_CST);
+}
+
+
+//------------------------------------------------------------------------------------
+osStatus Notifier::give() {
+	if(IS_ISR()){
+		return give_from_isr(NULL);
+	}
+	osThreadId tid = _target();
+	if(!tid){
+		return osErrorParameter;
+	}
+	// si ya estaba pendiente, el consumidor la verá sin necesidad de notificarle de nuevo
+	if(__atomic_exchange_n(&_pending, 1, __ATOMIC_SEQ_CST) != 0){
+		return osErrorResource;
+	}
+	xTaskNotify(tid, osFlagsWakeup, eSetBits);
+	return osOK;
+}
+
+
+//------------------------------------------------------------------------------------
+osStatus Notifier::give_from_isr(BaseType_t* higher_priority_task_woken) {
+	osThreadId tid = _target();
+	if(!tid){
+		return osErrorParameter;
+	}
+	if(__atomic_exchange_n(&_pending, 1, __ATOMIC_SEQ_CST) != 0){
+		return osErrorResource;
+	}
+	BaseType_t woken = pdFALSE;
+	xTaskNotifyFromISR(tid, osFlagsWakeup, eSetBits, &woken);
+	if(higher_priority_task_woken){
+		*higher_priority_task_woken |= woken;
+	}
+	else if(woken == pdTRUE){
+		portYIELD_FROM_ISR();
+	}
+	return osOK;
+}
+
+
+//------------------------------------------------------------------------------------
+bool Notifier::take(uint32_t millisec) {
+	// camino rápido: la señal ya está pendiente
+	if(__atomic_exchange_n(&_pending, 0, __ATOMIC_SEQ_CST) != 0){
+		return true;
+	}
+	if(IS_ISR() || millisec == 0){
+		return false;
+	}
+
+	osThreadId self = xTaskGetCurrentTaskHandle();
+	if(!_thread && !_tid){
+		_tid = self;
+	}
+	MBED_ASSERT(_target() == self);
+
+	TickType_t timeout = MBED_MILLIS_TO_TICK(millisec);
+	TickType_t start = xTaskGetTickCount();
+	bool signals = false;
+	for(;;){
+		TickType_t ticks = timeout;
+		if(timeout != portMAX_DELAY){
+			TickType_t elapsed = xTaskGetTickCount() - start;
+			ticks = (elapsed >= timeout)? 0 : (timeout - elapsed);
+		}
+		// la notificación puede venir de otra primitiva que comparte osFlagsWakeup, por eso se
+		// comprueba siempre el flag propio antes de decidir. Si viene de Thread::signal_set se restaura
+		// al salir (ver WaitList::block)
+		bool notified = WaitList::block(ticks, &signals);
+		if(__atomic_exchange_n(&_pending, 0, __ATOMIC_SEQ_CST) != 0){
+			WaitList::rearm(signals);
+			return true;
+		}
+		if(!notified || ticks == 0){
+			WaitList::rearm(signals);
+			return false;
+		}
+	}
+}
+
+
+//------------------------------------------------------------------------------------
+Notifier::~Notifier() {
+}
+
+
+//------------------------------------------------------------------------------------
+//-- PRIVATE METHODS IMPLEMENTATION --------------------------------------------------
+//------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------
+osThreadId Notifier::_target() {
+	if(_thread){
+		return _thread->get_id();
+	}
+	return _tid;
+}
@@ -0,0 +1,90 @@
+/*
+ * Notifier.h
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ *	Señal binaria ligera basada en las task notifications de FreeRTOS. Sustituye a Semaphore{0,1} cuando
+ *	existe un único consumidor conocido (el thread destino) y uno o varios productores (threads o ISRs).
+ *
+ */
+
+#ifndef MBED_NOTIFIER_H
+#define MBED_NOTIFIER_H
+
+#include "mbed_api.h"
+#include "Thread.h"
+
+
+/** The Notifier class is a binary signal bound to a single target thread.
+ *
+ * It is built on FreeRTOS direct task notifications, so give() wakes the target thread without going
+ * through a queue-backed semaphore. Only the target thread can take() the signal.
+ *
+ * @note
+ * Memory considerations: no heap is used, the Notifier control structure lives wherever the object is
+ * allocated. The target thread notification value shares the reserved bit @a osFlagsWakeup with other
+ * notification-based primitives, so a thread can wait on one of them at a time while keeping its
+ * Thread::signal_wait flags untouched.
+ */
+class Notifier  {
+public:
+    /** Create a Notifier bound to a Thread object. The thread may be started later.
+      @param  thread    target thread, the only one allowed to call take().
+    */
+    Notifier(Thread* thread);
+
+    /** Create a Notifier bound to a thread id.
+      @param  tid       target thread id. If NULL, the first thread calling take() becomes the target.
+    */
+    Notifier(osThreadId tid = NULL);
+
+    /** Bind the Notifier to another target thread id. Any pending signal is discarded.
+      @param  tid       target thread id
+    */
+    void bind(osThreadId tid);
+
+    /** Signal the target thread. Can be called from thread or interrupt context.
+      @return status code that indicates the execution status of the function:
+              @a osOK the signal has been given.
+              @a osErrorResource the signal was already pending (same as a Semaphore with max_count=1).
+              @a osErrorParameter the target thread is unknown or not started.
+    */
+    osStatus give();
+
+    /** Signal the target thread from an interrupt service routine that does not use ENTER_ISR/EXIT_ISR.
+      @param  higher_priority_task_woken  set to pdTRUE if a context switch is required. If NULL, the yield
+                                          is requested from inside this call.
+      @return status code, same as give().
+    */
+    osStatus give_from_isr(BaseType_t* higher_priority_task_woken = NULL);
+
+    /** Wait until the signal is given. Must be called from the target thread.
+      @param   millisec  timeout value or 0 in case of no time-out. (default: osWaitForever).
+      @return  true if the signal was taken, false on timeout.
+      @note from interrupt context it only probes and consumes a pending signal without blocking.
+    */
+    bool take(uint32_t millisec=osWaitForever);
+
+    /** Check if there is a pending signal without consuming it
+      @return  true if the signal is pending
+    */
+    bool pending() const { return (_pending != 0); }
+
+    ~Notifier();
+
+private:
+    Thread* _thread;					/// Thread destino (si se creó a partir de un objeto Thread)
+    volatile osThreadId _tid;			/// Identificador del thread destino
+    volatile uint32_t _pending;			/// Flag de señal pendiente
+
+    /** Obtiene el identificador del thread destino
+     *  @return thread id o NULL si aún no se conoce
+     */
+    osThreadId _target();
+};
+
+
+#endif
+
+/** @}*/
@@ -0,0 +1,163 @@
+/*
+ * Profile.cpp
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ */
+
+#include "Profile.h"
+#include "esp_ipc.h"
+
+
+
+//------------------------------------------------------------------------------------
+//---- STATIC ------------------------------------------------------------------------
+//------------------------------------------------------------------------------------
+
+Profile::Probe_t Profile::_probes[Profile::MaxProbes];
+volatile int Profile::_count = 0;
+portMUX_TYPE Profile::_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static const char* _MODULE_ = "[Profile]";
+#define _EXPR_	(!IS_ISR())
+#if !defined(MBED_TRACE_LEVEL_PROFILE)
+#define MBED_TRACE_LEVEL_PROFILE	MBED_TRACE_LEVEL
+#endif
+#define _LEVEL_	MBED_TRACE_LEVEL_PROFILE
+
+
+//------------------------------------------------------------------------------------
+static void clearStats(Profile::Stats_t* stats){
+	memset(stats, 0, sizeof(Profile::Stats_t));
+	stats->min = UINT32_MAX;
+}
+
+
+//------------------------------------------------------------------------------------
+/** Convierte ciclos de CPU a us (sólo para el volcado) */
+static inline uint32_t cyclesToUs(uint64_t cycles){
+	return (uint32_t)(cycles / CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ);
+}
+
+
+
+//------------------------------------------------------------------------------------
+//-- PUBLIC METHODS IMPLEMENTATION ---------------------------------------------------
+//------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------
+Profile::Probe_t* Profile::probe(const char* name){
+	Probe_t* result = NULL;
+	enterCritical(&_mux);
+	for(int i = 0; i < _count; i++){
+		if(strcmp(_probes[i].name, name) == 0){
+			result = &_probes[i];
+			break;
+		}
+	}
+	if(!result && _count < MaxProbes){
+		result = &_probes[_count];
+		result->name = name;
+		for(int c = 0; c < portNUM_PROCESSORS; c++){
+			clearStats(&result->core[c]);
+		}
+		// la sonda se publica una vez iniciada
+		_count = _count + 1;
+	}
+	exitCritical(&_mux);
+	return result;
+}
+
+
+//------------------------------------------------------------------------------------
+void Profile::record(Probe_t* probe, uint32_t cycles){
+	// cada core actualiza su propia entrada con sus interrupciones enmascaradas, sin competir con el otro core
+	uint32_t state = portENTER_CRITICAL_NESTED();
+	Stats_t* stats = &probe->core[xPortGetCoreID()];
+	Ticker_HAL::histRecord(&stats->hist, cycles);
+	stats->total += cycles;
+	if(cycles < stats->min){
+		stats->min = cycles;
+	}
+	portEXIT_CRITICAL_NESTED(state);
+}
+
+
+//------------------------------------------------------------------------------------
+const char* Profile::snapshot(int idx, Stats_t* stats){
+	if(idx < 0 || idx >= _count){
+		return NULL;
+	}
+	Probe_t* probe = &_probes[idx];
+	clearStats(stats);
+	for(int c = 0; c < portNUM_PROCESSORS; c++){
+		const Stats_t* src = &probe->core[c];
+		for(int i = 0; i < Ticker_HAL::HistogramBuckets; i++){
+			stats->hist.bucket[i] += src->hist.bucket[i];
+		}
+		stats->hist.count += src->hist.count;
+		stats->total += src->total;
+		if(src->hist.max > stats->hist.max){
+			stats->hist.max = src->hist.max;
+		}
+		if(src->min < stats->min){
+			stats->min = src->min;
+		}
+	}
+	return probe->name;
+}
+
+
+//------------------------------------------------------------------------------------
+void Profile::dump(){
+	DEBUG_TRACE_I(_EXPR_, _MODULE_, "%d sondas (tiempos en us)", _count);
+	for(int i = 0; i < _count; i++){
+		Stats_t stats;
+		const char* name = snapshot(i, &stats);
+		if(stats.hist.count == 0){
+			DEBUG_TRACE_I(_EXPR_, _MODULE_, "%-24s sin llamadas", name);
+			continue;
+		}
+		DEBUG_TRACE_I(_EXPR_, _MODULE_, "%-24s n=%d media=%d min=%d p50=%d p99=%d max=%d", name, stats.hist.count,
+				cyclesToUs(stats.total / stats.hist.count), cyclesToUs(stats.min),
+				cyclesToUs(Ticker_HAL::histPercentile(&stats.hist, 50)), cyclesToUs(Ticker_HAL::histPercentile(&stats.hist, 99)),
+				cyclesToUs(stats.hist.max));
+	}
+}
+
+
+//------------------------------------------------------------------------------------
+void Profile::reset(){
+	MBED_ASSERT(!IS_ISR());
+	// cada entrada sólo la modifica su core, por lo que se reinicia desde ese core. La tarea IPC de cada core
+	// (incluido el actual) la ejecuta fijada a él, sin depender del core en el que se encuentre el llamante
+	if(xTaskGetSchedulerState() != taskSCHEDULER_RUNNING){
+		resetCore(NULL);
+		return;
+	}
+	for(int c = 0; c < portNUM_PROCESSORS; c++){
+		esp_err_t err = esp_ipc_call_blocking(c, resetCore, NULL);
+		MBED_ASSERT(err == ESP_OK);
+	}
+}
+
+
+
+//------------------------------------------------------------------------------------
+//-- PRIVATE METHODS IMPLEMENTATION --------------------------------------------------
+//------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------
+void Profile::resetCore(void* arg){
+	// con las interrupciones del core enmascaradas, como record()
+	uint32_t state = portENTER_CRITICAL_NESTED();
+	int core = xPortGetCoreID();
+	int count = _count;
+	for(int i = 0; i < count; i++){
+		clearStats(&_probes[i].core[core]);
+	}
+	portEXIT_CRITICAL_NESTED(state);
+}
@@ -0,0 +1,148 @@
+/*
+ * Profile.h
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ *	Sondas de perfilado por ámbito (PROFILE_SCOPE) para medir dónde se consume el tiempo en las llamadas a los
+ *	drivers sin depurador. Cada sonda acumula número de llamadas, tiempo total, mínimo, máximo e histograma log2 en
+ *	una tabla estática con una entrada por core, que se actualiza sin spinlocks.
+ *
+ */
+
+#ifndef MBED_PROFILE_H
+#define MBED_PROFILE_H
+
+#include "mbed_api.h"
+#include "Ticker_HAL.h"
+#include "HighResTimer.h"
+
+
+/** Activa (1) las sondas PROFILE_SCOPE. Desactivadas por defecto, en cuyo caso no generan código. Se activan en la
+ *  configuración del componente con CPPFLAGS += -DMBED_PROFILE=1
+ */
+#if !defined(MBED_PROFILE)
+#define MBED_PROFILE		0
+#endif
+
+
+/** The Profile class keeps the global table of profiling probes.
+ *
+ * A probe is declared at the beginning of the scope to be measured, and is registered the first time it runs:
+ * @code
+ * int SPI::write(int value) {
+ *     PROFILE_SCOPE("SPI::write");
+ *     ...
+ * }
+ * ...
+ * Profile::dump();
+ * @endcode
+ *
+ * Durations are measured with HighResTimer::cycles(), so they are valid even if the task migrates between cores.
+ * Each core updates its own entry of the probe with its interrupts masked, so there is no contention between cores.
+ * Probes sharing the same name share their statistics.
+ */
+class Profile {
+public:
+
+	/** Número máximo de sondas registradas */
+	static const int MaxProbes = 32;
+
+	/** Estadísticas de una sonda (en ciclos de CPU)
+	 */
+	struct Stats_t {
+		Ticker_HAL::Histogram_t hist;	/// Histograma log2, con número de llamadas y máximo
+		uint64_t total;					/// Tiempo acumulado
+		uint32_t min;					/// Mínimo
+	};
+
+	/** Sonda registrada
+	 */
+	struct Probe_t {
+		const char* name;				/// Nombre (debe permanecer en memoria)
+		Stats_t core[portNUM_PROCESSORS];	/// Estadísticas de cada core
+	};
+
+
+	/** Registra una sonda o, si ya existe una con el mismo nombre, la obtiene
+	 *  @param name Nombre de la sonda
+	 *  @return Sonda o NULL si la tabla está llena
+	 */
+	static Probe_t* probe(const char* name);
+
+
+	/** Registra la duración de una llamada en la entrada del core actual
+	 *  @param probe Sonda
+	 *  @param cycles Duración en ciclos de CPU
+	 */
+	static void record(Probe_t* probe, uint32_t cycles);
+
+
+	/** Obtiene el número de sondas registradas
+	 *  @return Sondas
+	 */
+	static int count() { return _count; }
+
+
+	/** Obtiene las estadísticas de una sonda, agregadas de todos los cores
+	 *  @param idx Índice de la sonda (0..count()-1)
+	 *  @param stats Recibe las estadísticas
+	 *  @return Nombre de la sonda o NULL si no existe
+	 */
+	static const char* snapshot(int idx, Stats_t* stats);
+
+
+	/** Vuelca en el log la tabla de sondas: llamadas, media, mínimo, p50, p99 y máximo en us
+	 */
+	static void dump();
+
+
+	/** Reinicia las estadísticas de todas las sondas (se mantienen registradas). Cada core reinicia sus entradas
+	 *  desde sí mismo a través de esp_ipc_call_blocking, por lo que no puede llamarse desde una ISR
+	 */
+	static void reset();
+
+
+	/** Medida de un ámbito: registra su duración en la sonda al destruirse
+	 */
+	class Scope {
+	public:
+		Scope(Probe_t* probe) : _probe(probe), _start(HighResTimer::cycles()) {}
+		~Scope() {
+			if(_probe){
+				record(_probe, (uint32_t)(HighResTimer::cycles() - _start));
+			}
+		}
+	private:
+		Probe_t* _probe;
+		uint64_t _start;
+	};
+
+private:
+	static Probe_t _probes[MaxProbes];		/// Tabla de sondas
+	static volatile int _count;				/// Sondas registradas
+	static portMUX_TYPE _mux;				/// Spinlock de registro de sondas
+
+	/** Reinicia las entradas del core actual de todas las sondas
+	 *  @param arg No se utiliza
+	 */
+	static void resetCore(void* arg);
+};
+
+
+#define PROFILE_CONCAT_(a, b)	a##b
+#define PROFILE_CONCAT(a, b)	PROFILE_CONCAT_(a, b)
+
+/** Mide la duración del ámbito en el que se declara, en la sonda 'name' */
+#if MBED_PROFILE
+#define PROFILE_SCOPE(name)																	\
+	static Profile::Probe_t* PROFILE_CONCAT(_profile_probe_, __LINE__) = Profile::probe(name);	\
+	Profile::Scope PROFILE_CONCAT(_profile_scope_, __LINE__)(PROFILE_CONCAT(_profile_probe_, __LINE__))
+#else
+#define PROFILE_SCOPE(name)		do{}while(0)
+#endif
+
+
+#endif
+
+/** @}*/
@@ -0,0 +1,175 @@
+/*
+ * RWLock.cpp
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ */
+
+#include "RWLock.h"
+
+
+
+//------------------------------------------------------------------------------------
+//-- PUBLIC METHODS IMPLEMENTATION ---------------------------------------------------
+//------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------
+RWLock::RWLock(const char *name) : _name(name), _readers(0), _writers_waiting(0), _writer(false) {
+	vPortCPUInitializeMutex(&_mux);
+}
+
+
+//------------------------------------------------------------------------------------
+osStatus RWLock::read_lock(uint32_t millisec) {
+	WaitList::enter(&_mux);
+	// con escritores en espera no se admiten nuevos lectores (preferencia de escritura)
+	if(!_writer && _writers_waiting == 0){
+		_readers++;
+		WaitList::exit(&_mux);
+		return osOK;
+	}
+	if(millisec == 0 || IS_ISR()){
+		WaitList::exit(&_mux);
+		return osErrorTimeoutResource;
+	}
+	WaitList::Node node;
+	_rd_waiters.enqueue(&node);
+	WaitList::exit(&_mux);
+
+	if(_block(&node, &_rd_waiters, millisec)){
+		return osOK;
+	}
+	WaitList::exit(&_mux);
+	return osErrorTimeoutResource;
+}
+
+
+//------------------------------------------------------------------------------------
+bool RWLock::try_read_lock() {
+	return (read_lock(0) == osOK);
+}
+
+
+//------------------------------------------------------------------------------------
+void RWLock::read_unlock() {
+	BaseType_t woken = pdFALSE;
+	WaitList::enter(&_mux);
+	MBED_ASSERT(_readers > 0);
+	_readers--;
+	if(_readers == 0){
+		_handoff(&woken);
+	}
+	WaitList::exit(&_mux, woken);
+}
+
+
+//------------------------------------------------------------------------------------
+osStatus RWLock::write_lock(uint32_t millisec) {
+	WaitList::enter(&_mux);
+	if(!_writer && _readers == 0){
+		_writer = true;
+		WaitList::exit(&_mux);
+		return osOK;
+	}
+	if(millisec == 0 || IS_ISR()){
+		WaitList::exit(&_mux);
+		return osErrorTimeoutResource;
+	}
+	WaitList::Node node;
+	_writers_waiting++;
+	_wr_waiters.enqueue(&node);
+	WaitList::exit(&_mux);
+
+	if(_block(&node, &_wr_waiters, millisec)){
+		return osOK;
+	}
+	// timeout: si era el único escritor en espera, los lectores bloqueados por él pueden continuar
+	_writers_waiting--;
+	BaseType_t woken = pdFALSE;
+	if(!_writer){
+		_handoff(&woken);
+	}
+	WaitList::exit(&_mux, woken);
+	return osErrorTimeoutResource;
+}
+
+
+//------------------------------------------------------------------------------------
+bool RWLock::try_write_lock() {
+	return (write_lock(0) == osOK);
+}
+
+
+//------------------------------------------------------------------------------------
+void RWLock::write_unlock() {
+	BaseType_t woken = pdFALSE;
+	WaitList::enter(&_mux);
+	MBED_ASSERT(_writer);
+	_writer = false;
+	_handoff(&woken);
+	WaitList::exit(&_mux, woken);
+}
+
+
+//------------------------------------------------------------------------------------
+RWLock::~RWLock() {
+	MBED_ASSERT(_rd_waiters.empty() && _wr_waiters.empty());
+}
+
+
+//------------------------------------------------------------------------------------
+//-- PRIVATE METHODS IMPLEMENTATION --------------------------------------------------
+//------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------
+void RWLock::_handoff(BaseType_t* woken) {
+	if(_writer){
+		return;
+	}
+	// prioridad al primer escritor en espera, cuando no quedan lectores activos
+	if(!_wr_waiters.empty()){
+		if(_readers == 0){
+			_writer = true;
+			_writers_waiting--;
+			_wr_waiters.wake(_wr_waiters.first(), woken);
+		}
+		return;
+	}
+	// sin escritores pendientes, se admiten todos los lectores en espera
+	while(!_rd_waiters.empty()){
+		_readers++;
+		_rd_waiters.wake(_rd_waiters.first(), woken);
+	}
+}
+
+
+//------------------------------------------------------------------------------------
+bool RWLock::_block(WaitList::Node* node, WaitList* list, uint32_t millisec) {
+	TickType_t ticks = MBED_MILLIS_TO_TICK(millisec);
+	TickType_t start = xTaskGetTickCount();
+	bool signals = false;
+	for(;;){
+		TickType_t left = WaitList::remaining(start, ticks);
+		if(left > 0){
+			WaitList::block(left, &signals);
+		}
+		WaitList::enter(&_mux);
+		// quien despierta ya ha transferido la propiedad del cerrojo a este thread
+		if(node->signaled){
+			WaitList::exit(&_mux);
+			WaitList::rearm(signals);
+			return true;
+		}
+		// en timeout se retorna con el spinlock tomado para que el llamante actualice el estado (como en wake(),
+		// la notificación se emite dentro del spinlock)
+		if(WaitList::remaining(start, ticks) == 0){
+			list->remove(node);
+			WaitList::rearm(signals);
+			return false;
+		}
+		WaitList::exit(&_mux);
+	}
+}
@@ -0,0 +1,110 @@
+/*
+ * RWLock.h
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ *	Cerrojo de lectura/escritura con preferencia de escritura, pensado para datos leídos por muchos threads y
+ *	modificados con poca frecuencia (ej: tablas de configuración).
+ *
+ */
+
+#ifndef MBED_RWLOCK_H
+#define MBED_RWLOCK_H
+
+#include "mbed_api.h"
+#include "WaitList.h"
+
+
+/** The RWLock class allows concurrent readers and one exclusive writer.
+ *
+ * It is writer-preferring: once a writer is waiting, new readers block until it has finished, so writers
+ * can not be starved by a continuous stream of readers. Ownership is handed directly to the woken threads.
+ *
+ * try_read_lock(), try_write_lock() and the unlock methods can be called from interrupt context (read probes
+ * from ISR must be released from the same ISR). Blocking locks are not allowed in interrupt context.
+ *
+ * @note
+ * Memory considerations: no heap is used. Waiting threads are linked through nodes on their own stack and
+ * woken with task notifications (@a osFlagsWakeup). Locks are not recursive.
+ */
+class RWLock  {
+public:
+    /** Create and Initialize a RWLock object
+     @param name name to be used for this lock. It has to stay allocated for the lifetime of the object.
+    */
+    RWLock(const char *name = "no-name");
+
+    /** Acquire the lock in shared (read) mode
+      @param   millisec  timeout value or 0 in case of no time-out. (default: osWaitForever)
+      @return  status code that indicates the execution status of the function:
+               @a osOK the lock has been obtained.
+               @a osErrorTimeoutResource the lock could not be obtained in the given time.
+     */
+    osStatus read_lock(uint32_t millisec=osWaitForever);
+
+    /** Try to acquire the lock in shared mode, and return immediately. ISR safe.
+      @return true if the lock was acquired, false otherwise.
+     */
+    bool try_read_lock();
+
+    /** Release a shared lock. ISR safe.
+     */
+    void read_unlock();
+
+    /** Acquire the lock in exclusive (write) mode
+      @param   millisec  timeout value or 0 in case of no time-out. (default: osWaitForever)
+      @return  status code that indicates the execution status of the function:
+               @a osOK the lock has been obtained.
+               @a osErrorTimeoutResource the lock could not be obtained in the given time.
+     */
+    osStatus write_lock(uint32_t millisec=osWaitForever);
+
+    /** Try to acquire the lock in exclusive mode, and return immediately. ISR safe.
+      @return true if the lock was acquired, false otherwise.
+     */
+    bool try_write_lock();
+
+    /** Release the exclusive lock. ISR safe.
+     */
+    void write_unlock();
+
+    /** Get the number of active readers
+      @return  active readers
+     */
+    uint32_t readers() const { return _readers; }
+
+    /** Check if the lock is held by a writer
+      @return  true if held in exclusive mode
+     */
+    bool write_locked() const { return _writer; }
+
+    ~RWLock();
+
+private:
+    const char* _name;				/// Nombre del objeto
+    portMUX_TYPE _mux;				/// Spinlock de acceso al estado
+    volatile uint32_t _readers;		/// Lectores activos
+    volatile uint32_t _writers_waiting;	/// Escritores en espera
+    volatile bool _writer;			/// Escritor activo
+    WaitList _rd_waiters;			/// Lectores en espera
+    WaitList _wr_waiters;			/// Escritores en espera
+
+    /** Concede el cerrojo a los threads en espera tras una liberación. Se invoca con el spinlock tomado
+     *  @param woken Se activa si algún thread despertado requiere cambio de contexto
+     */
+    void _handoff(BaseType_t* woken);
+
+    /** Espera genérica hasta que el nodo es despertado o vence el timeout
+     *  @param node Nodo encolado
+     *  @param list Lista en la que se encuentra
+     *  @param millisec Timeout
+     *  @return true si se ha concedido el cerrojo. En caso de timeout retorna false con el spinlock tomado
+     */
+    bool _block(WaitList::Node* node, WaitList* list, uint32_t millisec);
+};
+
+
+#endif
+
+/** @}*/
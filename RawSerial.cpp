@@ -18,6 +18,10 @@
 //------------------------------------------------------------------------------------
 static const char* _MODULE_ = "[RawSerial].....";
 #define _EXPR_	(!IS_ISR())
+#if !defined(MBED_TRACE_LEVEL_RAWSERIAL)
+#define MBED_TRACE_LEVEL_RAWSERIAL	MBED_TRACE_LEVEL
+#endif
+#define _LEVEL_	MBED_TRACE_LEVEL_RAWSERIAL
 
 
 //------------------------------------------------------------------------------------
@@ -150,9 +154,7 @@ int RawSerial::putChar(int c) {
 	}
 	// si ha sido un envo bloqueante por semforo, lo libera
 	DEBUG_TRACE_D(_EXPR_, _MODULE_, "Notificando trama enviada");
-	if(_irq[TxIrq]){
-		_irq[TxIrq].call();
-	}
+	_notify(TxIrq);
 	return sent;
 }
 
@@ -172,9 +174,7 @@ int RawSerial::puts(const char *str) {
 	}
 	// si ha sido un envo bloqueante por semforo, lo libera
 	DEBUG_TRACE_D(_EXPR_, _MODULE_, "Notificando trama enviada");
-	if(_irq[TxIrq]){
-		_irq[TxIrq].call();
-	}
+	_notify(TxIrq);
 	return sent;
 }
 
@@ -224,6 +224,16 @@ int RawSerial::getChar(){
 //------------------------------------------------------------------------------------
 
 
+//------------------------------------------------------------------------------------
+void RawSerial::_notify(IrqType type){
+	if(_irq[type]){
+		_irq[type].call();
+	}
+	if(!_chain[type].empty()){
+		_chain[type].call();
+	}
+}
+
 
 //------------------------------------------------------------------------------------
 void RawSerial::_install(){
@@ -247,8 +257,9 @@ void RawSerial::_install(){
 	_installed = true;
 	_started = false;
 	DEBUG_TRACE_D(_EXPR_, _MODULE_, "Iniciando thread");
+	_started_ntf.bind(Thread::gettid());
 	_th->start(callback(this, &RawSerial::_task));
-	_sem.wait();
+	_started_ntf.take();
 	_started = true;
 	DEBUG_TRACE_D(_EXPR_, _MODULE_, "RawSerial iniciado!");
 }
@@ -258,7 +269,7 @@ void RawSerial::_install(){
 void RawSerial::_task() {
 	uart_event_t event;
 	DEBUG_TRACE_D(_EXPR_, _MODULE_, "Iniciando tarea y cola de mensajes...");
-	_sem.release();
+	_started_ntf.give();
 	for(;;){
 		if (xQueueReceive(_queue, (void * )&event, (portTickType)osWaitForever)){
 			uart_event_t*  evt = &event;
@@ -269,9 +280,7 @@ void RawSerial::_task() {
 				case UART_DATA_BREAK: {
 					DEBUG_TRACE_D(_EXPR_, _MODULE_, "EVT: uart_data_break!");
 					/* Evento al finalizar un envo */
-					if(_irq[TxIrq]){
-						_irq[TxIrq].call();
-					}
+					_notify(TxIrq);
 					break;
 				}
 
@@ -288,9 +297,7 @@ void RawSerial::_task() {
 						_rxbuf = buffer;
 						_rxsz = size;
 						_rxcnt = 0;
-						if(_irq[RxIrq]){
-							_irq[RxIrq].call();
-						}
+						_notify(RxIrq);
 						_rxbuf = NULL;
 						_rxsz = 0;
 						delete(buffer);
@@ -304,9 +311,7 @@ void RawSerial::_task() {
 					// If fifo overflow happened, you should consider adding flow control for your application.
 					// We can read data out out the buffer, or directly flush the Rx buffer.
 					uart_flush(_uart_num);
-					if(_irq[ErrIrq]){
-						_irq[ErrIrq].call();
-					}
+					_notify(ErrIrq);
 					break;
 				}
 
@@ -316,9 +321,7 @@ void RawSerial::_task() {
 					// If buffer full happened, you should consider increasing your buffer size
 					// We can read data out out the buffer, or directly flush the Rx buffer.
 					uart_flush(_uart_num);
-					if(_irq[ErrIrq]){
-						_irq[ErrIrq].call();
-					}
+					_notify(ErrIrq);
 					break;
 				}
 
@@ -331,9 +334,7 @@ void RawSerial::_task() {
 				case UART_PARITY_ERR: {
 					DEBUG_TRACE_D(_EXPR_, _MODULE_, "EVT: uart_parity_err!");
 					uart_flush(_uart_num);
-					if(_irq[ErrIrq]){
-						_irq[ErrIrq].call();
-					}
+					_notify(ErrIrq);
 					break;
 				}
 
@@ -341,9 +342,7 @@ void RawSerial::_task() {
 				case UART_FRAME_ERR: {
 					DEBUG_TRACE_D(_EXPR_, _MODULE_, "EVT: uart_frame_err!");
 					uart_flush(_uart_num);
-					if(_irq[ErrIrq]){
-						_irq[ErrIrq].call();
-					}
+					_notify(ErrIrq);
 					break;
 				}
 
@@ -12,8 +12,9 @@
 
 #include "mbed_api.h"
 #include "Thread.h"
-#include "Semaphore.h"
+#include "Notifier.h"
 #include "Callback.h"
+#include "CallChain.h"
 
 
 
@@ -112,6 +113,29 @@ public:
     }
 
 
+    /** Add a link to the chain of observers called on a serial interrupt, after the attached function. Several
+     *  components can observe the same interrupt. On RxIrq, data not read by a callback is left for the next one
+     *
+     *  @param link Link to add. It must stay alive until it is removed
+     *  @param type Which serial interrupt to observe
+     *  @returns true if added, false if the link is empty or already in a chain
+     */
+    bool attach_add(CallChain::Link* link, IrqType type = RxIrq){
+    	return _chain[type].add(link);
+    }
+
+
+    /** Remove a link from the chain of observers of a serial interrupt. On return it is no longer called
+     *
+     *  @param link Link to remove
+     *  @param type Serial interrupt it observes
+     *  @returns true if it was in the chain
+     */
+    bool attach_remove(CallChain::Link* link, IrqType type = RxIrq){
+    	return _chain[type].remove(link);
+    }
+
+
     /** Write a char to the serial port
      *
      * @param c The char to write
@@ -165,7 +189,7 @@ protected:
     /** Control de la tarea asociada a la UART ESP32 */
     Thread* _th;
     QueueHandle_t _queue;
-    Semaphore _sem{0,1};
+    Notifier _started_ntf;
     osPriority _priority;
     uint32_t _stack_size;
 
@@ -176,6 +200,8 @@ protected:
 
     /** Callbacks */
     Callback<void()> _irq[IrqCnt];
+    /** Observadores de cada interrupcin */
+    CallChain _chain[IrqCnt];
 
     /** Controlador UART ESP32 */
     uart_config_t _uart_config;
@@ -198,6 +224,12 @@ protected:
      * Tarea de control
      */
     void _task();
+
+    /**
+     * Notifica una interrupcin a la callback y a la cadena de observadores
+     * @param type Interrupcin
+     */
+    void _notify(IrqType type);
 };
 
 
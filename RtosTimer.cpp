@@ -7,7 +7,7 @@
  */
 
 #include "RtosTimer.h"
-#include "Mutex.h"
+#include "HighResTimer.h"
 
 //------------------------------------------------------------------------------------
 //--- PRIVATE TYPES ------------------------------------------------------------------
@@ -15,22 +15,113 @@
 
 static const char* _MODULE_ = "[RtosTimer].....";
 #define _EXPR_	(_defdbg && !IS_ISR())
-static Mutex _mtx;
+#if !defined(MBED_TRACE_LEVEL_RTOSTIMER)
+#define MBED_TRACE_LEVEL_RTOSTIMER	MBED_TRACE_LEVEL
+#endif
+#define _LEVEL_	MBED_TRACE_LEVEL_RTOSTIMER
 
+/** Tiempo máximo de espera para encolar el borrado del timer en el daemon */
+static const uint32_t DeleteTimeoutMs = 100;
+
+/** Timer cuya callback está en ejecución. Todas las callbacks se ejecutan en la tarea daemon de FreeRTOS, de una en
+ *  una, por lo que basta con una referencia. El spinlock sólo protege la lectura del ID y su publicación, nunca la
+ *  ejecución de la callback, de forma que la destrucción de un timer no espera por las callbacks de otros
+ */
+static RtosTimer* volatile _running = NULL;
+static portMUX_TYPE _running_mux = portMUX_INITIALIZER_UNLOCKED;
 
-static void defaultCallback(){
-}
 
 static void vCallbackFunction(TimerHandle_t arg){
-	_mtx.lock();
+	portENTER_CRITICAL(&_running_mux);
 	RtosTimer* tmr = (RtosTimer*)pvTimerGetTimerID(arg);
+	_running = tmr;
+	portEXIT_CRITICAL(&_running_mux);
+
+	// si el timer se ha destruido, su ID es NULL y no se accede al objeto
 	if(tmr){
 		tmr->doCallback();
 	}
-	_mtx.unlock();
+	// el objeto pudo destruirse desde su propia callback, por lo que ya no se accede a él
+	_running = NULL;
+}
+
+
+/** Estadísticas de comandos al daemon */
+static RtosTimer::Stats_t _stats = {0, 0, 0, 0, 0, 0};
+static portMUX_TYPE _stats_mux = portMUX_INITIALIZER_UNLOCKED;
+
+/** Medida de latencia en curso: el daemon sólo registra la medida si su secuencia sigue vigente, por lo que nunca
+ *  accede a memoria del llamante aunque éste haya dejado de esperar */
+static volatile uint32_t _probe_seq = 0;
+static uint64_t _probe_sent = 0;
+static volatile int32_t _probe_latency = -1;
+
+/** Frecuencia de CPU en MHz (ciclos por us) */
+static const uint32_t CpuMHz = CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ;
+
+
+//------------------------------------------------------------------------------------
+/** Marca de tiempo en ciclos, o 0 si la base de tiempos no está en marcha (no se arranca desde aquí) */
+static inline uint64_t timestamp(){
+	return (Ticker_HAL::isStarted())? HighResTimer::cycles() : 0;
+}
+
+
+//------------------------------------------------------------------------------------
+/** Tiempo de bloqueo admisible: el daemon no puede bloquearse esperando a su propia cola */
+static inline TickType_t blockTime(TickType_t ticks){
+	return (IS_ISR() || xTaskGetCurrentTaskHandle() == xTimerGetTimerDaemonTaskHandle())? 0 : ticks;
+}
+
+
+//------------------------------------------------------------------------------------
+/** Registra el resultado de un comando enviado al daemon
+ *  @param result Resultado del envío
+ *  @param start Marca de tiempo previa al envío
+ *  @return osOK o osErrorTimeoutResource si la cola del daemon estaba llena
+ */
+static osStatus trackCommand(BaseType_t result, uint64_t start){
+	uint32_t us = (start)? (uint32_t)((timestamp() - start) / CpuMHz) : 0;
+	enterCritical(&_stats_mux);
+	_stats.commands++;
+	if(result != pdPASS){
+		_stats.failures++;
+	}
+	_stats.send_total_us += us;
+	if(us > _stats.send_max_us){
+		_stats.send_max_us = us;
+	}
+	exitCritical(&_stats_mux);
+	return (result == pdPASS)? osOK : osErrorTimeoutResource;
+}
+
+
+//------------------------------------------------------------------------------------
+/** Ejecutada en el daemon: registra la latencia de la medida en curso */
+static void latencyProbe(void* arg, uint32_t seq){
+	uint64_t now = timestamp();
+	portENTER_CRITICAL(&_stats_mux);
+	if(seq == _probe_seq){
+		uint32_t us = (uint32_t)((now - _probe_sent) / CpuMHz);
+		_probe_latency = us;
+		_stats.daemon_latency_us = us;
+		if(us > _stats.daemon_latency_max_us){
+			_stats.daemon_latency_max_us = us;
+		}
+	}
+	portEXIT_CRITICAL(&_stats_mux);
 }
 
 
+#if MBED_RTOSTIMER_STATIC
+//------------------------------------------------------------------------------------
+/** Ejecutada en el daemon tras procesar los comandos previos, entre ellos el borrado del timer */
+static void deleteDone(void* arg, uint32_t){
+	*(volatile bool*)arg = true;
+}
+#endif
+
+
 //------------------------------------------------------------------------------------
 //-- PUBLIC METHODS IMPLEMENTATION ---------------------------------------------------
 //------------------------------------------------------------------------------------
@@ -47,68 +138,186 @@ RtosTimer::RtosTimer(Callback<void()> func, os_timer_type type, const char* name
 
 //------------------------------------------------------------------------------------
 osStatus RtosTimer::start(uint32_t millisec) {
-	if(_id==0){
-		DEBUG_TRACE_D(_EXPR_, _MODULE_, "Creando xTimerCreate para RtosTimer <%s>", _name);
-		if((_id = xTimerCreate(_name, MBED_MILLIS_TO_TICK(millisec), _type, (void*)this, vCallbackFunction)) == 0){
-			DEBUG_TRACE_E(_EXPR_, _MODULE_, "ERROR xTimerCreate en RtosTimer <%s>", _name);
-			return osError;
-		}
-		if(IS_ISR()){
-			if(xTimerStartFromISR(_id, NULL) == pdPASS){
-				return osOK;
-			}
-		}
-		else{
-			if(xTimerStart(_id, 0) == pdPASS){
-				return osOK;
-			}
-		}
-		DEBUG_TRACE_E(_EXPR_, _MODULE_, "ERROR al iniciar RtosTimer <%s>", _name);
-		return osError;
+	if(_id != 0){
+		DEBUG_TRACE_D(_EXPR_, _MODULE_, "Reiniciando RtosTimer <%s>", _name);
 	}
-	DEBUG_TRACE_D(_EXPR_, _MODULE_, "Reiniciando RtosTimer <%s>", _name);
-	// lo reinicia cambiando el periodo
-	if(IS_ISR()){
-		if(xTimerChangePeriodFromISR(_id, MBED_MILLIS_TO_TICK(millisec), NULL) == pdPASS){
-			return osOK;
-		}
-	}
-	else{
-		if(xTimerChangePeriod(_id, MBED_MILLIS_TO_TICK(millisec), 0) == pdPASS){
-			return osOK;
-		}
+	osStatus result = sendStart(millisec, blockTime(MBED_MILLIS_TO_TICK(CommandTimeoutMs)));
+	if(result != osOK){
+		DEBUG_TRACE_E(_EXPR_, _MODULE_, "ERROR al iniciar RtosTimer <%s>", _name);
 	}
-	DEBUG_TRACE_E(_EXPR_, _MODULE_, "ERROR al iniciar RtosTimer <%s>", _name);
-	return osError;
+	return result;
 }
 
 
 //------------------------------------------------------------------------------------
 osStatus RtosTimer::stop(void) {
-	if(xTimerIsTimerActive(_id) == pdFALSE){
+	if(_id == 0 || xTimerIsTimerActive(_id) == pdFALSE){
 		return osOK;
 	}
-	if(IS_ISR()){
-		if(xTimerStopFromISR(_id, NULL) == pdPASS){
-			return osOK;
+	DEBUG_TRACE_D(_EXPR_, _MODULE_, "Deteniendo RtosTimer <%s>", _name);
+	osStatus result = sendStop(blockTime(MBED_MILLIS_TO_TICK(CommandTimeoutMs)));
+	if(result != osOK){
+		DEBUG_TRACE_E(_EXPR_, _MODULE_, "ERROR al detener RtosTimer <%s>", _name);
+	}
+	return result;
+}
+
+
+//------------------------------------------------------------------------------------
+int RtosTimer::startGroup(RtosTimer* const timers[], int count, uint32_t millisec) {
+	// los comandos del grupo comparten un único plazo de bloqueo, que el daemon atiende en una misma pasada
+	TickType_t deadline = xTaskGetTickCount() + MBED_MILLIS_TO_TICK(CommandTimeoutMs);
+	int started = 0;
+	for(int i = 0; i < count; i++){
+		TickType_t left = deadline - xTaskGetTickCount();
+		if(timers[i]->sendStart(millisec, blockTime(((int32_t)left > 0)? left : 0)) == osOK){
+			started++;
 		}
-		return osError;
 	}
-	DEBUG_TRACE_D(_EXPR_, _MODULE_, "Deteniendo RtosTimer <%s>", _name);
-	if(xTimerStop(_id, 0) == pdPASS){
-		return osOK;
+	return started;
+}
+
+
+//------------------------------------------------------------------------------------
+int RtosTimer::stopGroup(RtosTimer* const timers[], int count) {
+	TickType_t deadline = xTaskGetTickCount() + MBED_MILLIS_TO_TICK(CommandTimeoutMs);
+	int stopped = 0;
+	for(int i = 0; i < count; i++){
+		RtosTimer* tmr = timers[i];
+		if(tmr->_id == 0 || xTimerIsTimerActive(tmr->_id) == pdFALSE){
+			stopped++;
+			continue;
+		}
+		TickType_t left = deadline - xTaskGetTickCount();
+		if(tmr->sendStop(blockTime(((int32_t)left > 0)? left : 0)) == osOK){
+			stopped++;
+		}
 	}
+	return stopped;
+}
+
 
-	return osError;
+//------------------------------------------------------------------------------------
+void RtosTimer::getStats(Stats_t* stats) {
+	enterCritical(&_stats_mux);
+	*stats = _stats;
+	exitCritical(&_stats_mux);
+}
+
+
+//------------------------------------------------------------------------------------
+void RtosTimer::resetStats() {
+	enterCritical(&_stats_mux);
+	memset(&_stats, 0, sizeof(Stats_t));
+	exitCritical(&_stats_mux);
+}
+
+
+//------------------------------------------------------------------------------------
+int32_t RtosTimer::measureDaemonLatency(uint32_t timeout_ms) {
+	MBED_ASSERT(!IS_ISR());
+	Ticker_HAL::start();
+	portENTER_CRITICAL(&_stats_mux);
+	uint32_t seq = ++_probe_seq;
+	_probe_latency = -1;
+	_probe_sent = timestamp();
+	portEXIT_CRITICAL(&_stats_mux);
+
+	uint64_t start = timestamp();
+	if(trackCommand(xTimerPendFunctionCall(latencyProbe, NULL, seq, blockTime(MBED_MILLIS_TO_TICK(timeout_ms))), start) != osOK){
+		return -1;
+	}
+	TickType_t deadline = xTaskGetTickCount() + MBED_MILLIS_TO_TICK(timeout_ms);
+	while(_probe_latency < 0 && (int32_t)(deadline - xTaskGetTickCount()) > 0){
+		vTaskDelay(1);
+	}
+	return _probe_latency;
 }
 
 
 //------------------------------------------------------------------------------------
 RtosTimer::~RtosTimer() {
-	_mtx.lock();
-	_function = callback(defaultCallback);
-	xTimerDelete(_id, 0);
+	if(_id == 0){
+		return;
+	}
+	// desvincula el objeto del timer: a partir de aquí ninguna callback nueva accede a él
+	portENTER_CRITICAL(&_running_mux);
+	vTimerSetTimerID(_id, NULL);
+	bool running = (_running == this);
+	portEXIT_CRITICAL(&_running_mux);
+
+	// si su callback está en curso en el daemon, espera a que termine. Desde la propia callback no se espera: el
+	// daemon no vuelve a acceder al objeto tras invocarla
+	bool in_daemon = (xTaskGetCurrentTaskHandle() == xTimerGetTimerDaemonTaskHandle());
+	if(running && !in_daemon){
+		DEBUG_TRACE_D(_EXPR_, _MODULE_, "Esperando fin de callback de RtosTimer <%s>", _name);
+		while(_running == this){
+			vTaskDelay(1);
+		}
+	}
+
+#if MBED_RTOSTIMER_STATIC
+	// el timer está reservado en este objeto: el daemon debe procesar su borrado antes de liberarlo
+	MBED_ASSERT(!in_daemon);
+	volatile bool deleted = false;
+	xTimerDelete(_id, portMAX_DELAY);
+	xTimerPendFunctionCall(deleteDone, (void*)&deleted, 0, portMAX_DELAY);
+	while(!deleted){
+		vTaskDelay(1);
+	}
+#else
+	// desde el daemon no se puede bloquear esperando a su propia cola de comandos
+	if(xTimerDelete(_id, in_daemon? 0 : MBED_MILLIS_TO_TICK(DeleteTimeoutMs)) != pdPASS){
+		DEBUG_TRACE_E(_EXPR_, _MODULE_, "ERROR al eliminar RtosTimer <%s>", _name);
+	}
+#endif
 	_id = 0;
-	_mtx.unlock();
 }
 
+
+
+//------------------------------------------------------------------------------------
+//-- PRIVATE METHODS IMPLEMENTATION --------------------------------------------------
+//------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------
+bool RtosTimer::create(uint32_t millisec) {
+#if MBED_RTOSTIMER_STATIC
+	DEBUG_TRACE_D(_EXPR_, _MODULE_, "Creando xTimerCreateStatic para RtosTimer <%s>", _name);
+	_id = xTimerCreateStatic(_name, MBED_MILLIS_TO_TICK(millisec), _type, (void*)this, vCallbackFunction, &_tcb);
+#else
+	DEBUG_TRACE_D(_EXPR_, _MODULE_, "Creando xTimerCreate para RtosTimer <%s>", _name);
+	_id = xTimerCreate(_name, MBED_MILLIS_TO_TICK(millisec), _type, (void*)this, vCallbackFunction);
+#endif
+	if(_id == 0){
+		DEBUG_TRACE_E(_EXPR_, _MODULE_, "ERROR xTimerCreate en RtosTimer <%s>", _name);
+		return false;
+	}
+	return true;
+}
+
+
+//------------------------------------------------------------------------------------
+osStatus RtosTimer::sendStart(uint32_t millisec, TickType_t block) {
+	uint64_t start = timestamp();
+	BaseType_t result;
+	if(_id == 0){
+		if(!create(millisec)){
+			return osError;
+		}
+		result = (IS_ISR())? xTimerStartFromISR(_id, NULL) : xTimerStart(_id, block);
+	}
+	else{
+		// lo reinicia cambiando el periodo
+		result = (IS_ISR())? xTimerChangePeriodFromISR(_id, MBED_MILLIS_TO_TICK(millisec), NULL) : xTimerChangePeriod(_id, MBED_MILLIS_TO_TICK(millisec), block);
+	}
+	return trackCommand(result, start);
+}
+
+
+//------------------------------------------------------------------------------------
+osStatus RtosTimer::sendStop(TickType_t block) {
+	uint64_t start = timestamp();
+	return trackCommand((IS_ISR())? xTimerStopFromISR(_id, NULL) : xTimerStop(_id, block), start);
+}
@@ -14,6 +14,19 @@
 #include "mbed_api.h"
 
 
+/** Activa (1) la reserva esttica del timer de FreeRTOS (xTimerCreateStatic) dentro del propio objeto RtosTimer, en
+ *  lugar de reservarlo en el heap al arrancarlo por primera vez. Requiere configSUPPORT_STATIC_ALLOCATION. Con reserva
+ *  esttica el destructor espera a que el daemon procese el borrado, por lo que un timer no puede destruirse desde su
+ *  propia callback. Se activa en la configuracin del componente con CPPFLAGS += -DMBED_RTOSTIMER_STATIC=1
+ */
+#if !defined(MBED_RTOSTIMER_STATIC)
+#define MBED_RTOSTIMER_STATIC		0
+#endif
+#if MBED_RTOSTIMER_STATIC && !configSUPPORT_STATIC_ALLOCATION
+#error "MBED_RTOSTIMER_STATIC requiere configSUPPORT_STATIC_ALLOCATION"
+#endif
+
+
 /** The RtosTimer class allow creating and and controlling of timer functions in the system.
  A timer function is called when a time period expires whereby both on-shot and
  periodic timers are possible. A timer can be started, restarted, or stopped.
@@ -58,7 +71,8 @@
 
  @note
  Memory considerations: The timer control structures will be created on current thread's stack, both for the mbed OS
- and underlying RTOS objects (static or dynamic RTOS memory pools are not being used).
+ and underlying RTOS objects (static or dynamic RTOS memory pools are not being used). The FreeRTOS timer is allocated
+ from the heap on the first start(), unless MBED_RTOSTIMER_STATIC is enabled.
 */
 class RtosTimer  {
 public:
@@ -66,6 +80,20 @@ public:
 	/** Clave para activar la depuracin en tiempo de compilacin */
 	static const bool DEBUG = true;
 
+	/** Tiempo mximo de bloqueo (ms) al enviar un comando al daemon desde una tarea, si su cola est llena */
+	static const uint32_t CommandTimeoutMs = 10;
+
+	/** Estadsticas de los comandos enviados al daemon de timers
+	 */
+	struct Stats_t {
+		uint32_t commands;				/// Comandos enviados
+		uint32_t failures;				/// Comandos rechazados por cola del daemon llena
+		uint32_t send_max_us;			/// Mximo tiempo de bloqueo en el envo
+		uint64_t send_total_us;			/// Tiempo de bloqueo acumulado en los envos
+		uint32_t daemon_latency_us;		/// ltima latencia medida de la cola del daemon
+		uint32_t daemon_latency_max_us;	/// Mxima latencia medida de la cola del daemon
+	};
+
     
     /** Create timer.
       @param   func      function to be executed by this timer.
@@ -82,6 +110,7 @@ public:
           @a osErrorISR @a stop cannot be called from interrupt service routines.
           @a osErrorParameter internal error.
           @a osErrorResource the timer is not running.
+          @a osErrorTimeoutResource the timer daemon command queue stayed full for CommandTimeoutMs.
     */
     osStatus stop(void);
 
@@ -92,9 +121,44 @@ public:
           @a osErrorISR @a start cannot be called from interrupt service routines.
           @a osErrorParameter internal error or incorrect parameter value.
           @a osErrorResource internal error (the timer is in an invalid timer state).
+          @a osErrorTimeoutResource the timer daemon command queue stayed full for CommandTimeoutMs.
     */
     osStatus start(uint32_t millisec);
 
+    /** Start or restart a group of timers with the same period, sharing one CommandTimeoutMs budget.
+      @param   timers    timers to start.
+      @param   count     number of timers.
+      @param   millisec  non-zero value of the timers.
+      @return  number of timers started. The rest were rejected by the timer daemon (see getStats).
+    */
+    static int startGroup(RtosTimer* const timers[], int count, uint32_t millisec);
+
+    /** Stop a group of timers, sharing one CommandTimeoutMs budget.
+      @param   timers    timers to stop.
+      @param   count     number of timers.
+      @return  number of timers stopped.
+    */
+    static int stopGroup(RtosTimer* const timers[], int count);
+
+    /** Obtiene las estadsticas de comandos enviados al daemon
+     *  @param stats Recibe las estadsticas
+     */
+    static void getStats(Stats_t* stats);
+
+    /** Reinicia las estadsticas de comandos
+     */
+    static void resetStats();
+
+    /** Mide la latencia actual de la cola del daemon, encolando una funcin que registra cundo se ejecuta. No debe
+     *  invocarse desde ISR ni desde una callback de timer
+     *  @param timeout_ms Tiempo mximo de espera
+     *  @return Latencia en us o -1 si el daemon no la ha atendido a tiempo
+     */
+    static int32_t measureDaemonLatency(uint32_t timeout_ms);
+
+    /** Destroy the timer. If its callback is running in the timer daemon, it waits for it to finish. Callbacks of
+        other timers are never waited for, and a timer may be destroyed from its own callback.
+    */
     ~RtosTimer();
 
     void doCallback(){
@@ -109,6 +173,25 @@ protected:
     Callback<void()> 	_function;	/// Callback a invocar
     const char* 		_name;		/// nombre del timer
     bool 				_defdbg;	/// Flag para activar depuracin por defecto <printf>
+#if MBED_RTOSTIMER_STATIC
+    StaticTimer_t		_tcb;		/// Timer de FreeRTOS reservado estticamente
+#endif
+
+private:
+    /** Crea el timer de FreeRTOS con el periodo indicado
+     *  @return true si se ha creado
+     */
+    bool create(uint32_t millisec);
+
+    /** Enva al daemon el comando de arranque (o reinicio con el periodo indicado)
+     *  @param block Tiempo mximo de bloqueo en ticks (ignorado en ISR)
+     */
+    osStatus sendStart(uint32_t millisec, TickType_t block);
+
+    /** Enva al daemon el comando de parada
+     *  @param block Tiempo mximo de bloqueo en ticks (ignorado en ISR)
+     */
+    osStatus sendStop(TickType_t block);
 };
 
 
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "SPI.h"
+#include "Profile.h"
 
 
 //------------------------------------------------------------------------------------
@@ -138,6 +139,7 @@ void SPI::frequency(int hz) {
 
 //------------------------------------------------------------------------------------
 int SPI::write(int value) {
+	PROFILE_SCOPE("SPI::write");
 	uint8_t read;
     lock();
     spi_transaction_t t;
@@ -158,6 +160,7 @@ int SPI::write(int value) {
 
 //------------------------------------------------------------------------------------
 int SPI::write(const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length) {
+	PROFILE_SCOPE("SPI::write_buf");
 	lock();
 	int max_len = (tx_length > rx_length)? tx_length : rx_length;
 	MBED_ASSERT(max_len <= DefaultDMABufferSize);
@@ -7,6 +7,7 @@
  */
 
 #include "Serial.h"
+#include "Profile.h"
 
 
 //------------------------------------------------------------------------------------
@@ -16,6 +17,10 @@
 //------------------------------------------------------------------------------------
 static const char* _MODULE_ = "[Serial]........";
 #define _EXPR_	(_debug && !IS_ISR())
+#if !defined(MBED_TRACE_LEVEL_SERIAL)
+#define MBED_TRACE_LEVEL_SERIAL	MBED_TRACE_LEVEL
+#endif
+#define _LEVEL_	MBED_TRACE_LEVEL_SERIAL
 
 
 //------------------------------------------------------------------------------------
@@ -135,6 +140,7 @@ void Serial::config(Callback<void()> rx_done, Callback <void()> rx_timeout, Call
 
 //------------------------------------------------------------------------------------
 bool Serial::send(void* data, uint16_t size, Callback<void()> tx_done){
+	PROFILE_SCOPE("Serial::send");
 	if(tx_done == (Callback<void()>)NULL){
 		_cb_tx = callback(defaultCb);
 	}
@@ -233,6 +239,30 @@ void Serial::stopReceiver(){
 //------------------------------------------------------------------------------------
 
 
+//------------------------------------------------------------------------------------
+void Serial::notify(Event ev) {
+	switch(ev){
+		case RxDone:
+			_cb_rx.call();
+			break;
+		case RxTimeout:
+			_cb_rx_tmr.call();
+			break;
+		case RxOverflow:
+			_cb_rx_ovf.call();
+			break;
+		case TxDone:
+			_cb_tx.call();
+			break;
+		default:
+			return;
+	}
+	if(!_chain[ev].empty()){
+		_chain[ev].call();
+	}
+}
+
+
 //------------------------------------------------------------------------------------
 void Serial::task() {
 	uart_event_t event;
@@ -247,7 +277,7 @@ void Serial::task() {
 				case UART_DATA_BREAK: {
 					DEBUG_TRACE_D(_EXPR_, _MODULE_, "EVT: uart_data_break!");
 					/* Evento al finalizar un env�o */
-					_cb_tx.call();
+					notify(TxDone);
 					break;
 				}
 
@@ -257,7 +287,7 @@ void Serial::task() {
 						size_t bytes = 0;
 						uart_get_buffered_data_len(_uart_num, &bytes);
 						DEBUG_TRACE_D(_EXPR_, _MODULE_, "%d bytes", bytes);
-						_cb_rx.call();
+						notify(RxDone);
 					}
 					else{
 						uart_flush(_uart_num);
@@ -277,7 +307,7 @@ void Serial::task() {
 					// If fifo overflow happened, you should consider adding flow control for your application.
 					// We can read data out out the buffer, or directly flush the Rx buffer.
 					uart_flush(_uart_num);
-					_cb_rx_ovf.call();
+					notify(RxOverflow);
 					break;
 				}
 
@@ -287,7 +317,7 @@ void Serial::task() {
 					// If buffer full happened, you should consider increasing your buffer size
 					// We can read data out out the buffer, or directly flush the Rx buffer.
 					uart_flush(_uart_num);
-					_cb_rx_ovf.call();
+					notify(RxOverflow);
 					break;
 				}
 
@@ -295,7 +325,7 @@ void Serial::task() {
 				case UART_BREAK: {
 					DEBUG_TRACE_D(_EXPR_, _MODULE_, "EVT: uart_break!");
 					if(_en_rx){
-						_cb_rx.call();
+						notify(RxDone);
 					}
 					else{
 						uart_flush(_uart_num);
@@ -307,7 +337,7 @@ void Serial::task() {
 				case UART_PARITY_ERR: {
 					DEBUG_TRACE_D(_EXPR_, _MODULE_, "EVT: uart_parity_err!");
 					uart_flush(_uart_num);
-					_cb_rx_tmr.call();
+					notify(RxTimeout);
 					break;
 				}
 
@@ -315,7 +345,7 @@ void Serial::task() {
 				case UART_FRAME_ERR: {
 					DEBUG_TRACE_D(_EXPR_, _MODULE_, "EVT: uart_frame_err!");
 					uart_flush(_uart_num);
-					_cb_rx_tmr.call();
+					notify(RxTimeout);
 					break;
 				}
 
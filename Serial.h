@@ -15,6 +15,7 @@
 
 #include "mbed_api.h"
 #include "mbed.h"
+#include "CallChain.h"
 
 
 
@@ -29,6 +30,15 @@ public:
         IrqCnt
     };
 
+    /** Eventos notificados a las callbacks de config() y send() y a las cadenas de observadores */
+    enum Event {
+        RxDone = 0,		/// Recepcin completa (rx_done)
+        RxTimeout,		/// Error de trama o de paridad (rx_timeout)
+        RxOverflow,		/// Desbordamiento en recepcin (rx_ovf)
+        TxDone,			/// Fin del envo (tx_done)
+        EventCnt
+    };
+
     /** Constructor que crea una instancia
 	 *
 	 *  @param tx tx pin
@@ -79,6 +89,29 @@ public:
     void config(Callback<void()> rx_done, Callback <void()> rx_timeout, Callback <void()> rx_ovf, uint32_t us_timeout, char eof = 0);
 
 
+    /** attach_add()
+     *  Aade un observador de un evento, que se invoca tras la callback de config() o send(). Varios componentes
+     *  pueden observar el mismo evento. En RxDone, los datos que no lea uno quedan para el siguiente
+     *  @param link Eslabn a aadir, que debe mantenerse hasta eliminarlo
+     *  @param ev Evento a observar
+     *  @return true si se ha aadido, false si el eslabn est vaco o ya enlazado
+     */
+    bool attach_add(CallChain::Link* link, Event ev){
+    	return _chain[ev].add(link);
+    }
+
+
+    /** attach_remove()
+     *  Elimina un observador de un evento. Al retornar ya no se invoca
+     *  @param link Eslabn a eliminar
+     *  @param ev Evento observado
+     *  @return true si estaba enlazado
+     */
+    bool attach_remove(CallChain::Link* link, Event ev){
+    	return _chain[ev].remove(link);
+    }
+
+
     /** send()
      *  Prepara para una nueva transimisin gestionada por interrupciones. El final de transmisin
      *  se notifica invocando la callback
@@ -196,6 +229,12 @@ protected:
     void task();
 
 
+    /** Notifica un evento a su callback y a su cadena de observadores
+     *  @param ev Evento
+     */
+    void notify(Event ev);
+
+
     /** Mximo nmero acumulado de eventos en la tarea asociada a la UART */
     static const uint32_t DefaultQueueDepth = 16;
 
@@ -217,6 +256,7 @@ protected:
     Callback<void()> _cb_tx;
     Callback<void()> _cb_rx_tmr;
     Callback<void()> _cb_rx_ovf;
+    CallChain _chain[EventCnt];		/// Observadores de cada evento
 };
 
 
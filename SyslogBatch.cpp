@@ -0,0 +1,157 @@
+/*
+ * SyslogBatch.cpp
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ */
+
+#include "SyslogBatch.h"
+#include "Thread.h"
+
+
+
+//------------------------------------------------------------------------------------
+//---- STATIC ------------------------------------------------------------------------
+//------------------------------------------------------------------------------------
+
+SyslogBatchCore* SyslogBatch::_core = NULL;
+portMUX_TYPE SyslogBatch::_mux = portMUX_INITIALIZER_UNLOCKED;
+Thread* SyslogBatch::_thread = NULL;
+SyslogBatch::Sink SyslogBatch::_sink;
+uint32_t SyslogBatch::_poll_ms = DefaultLatencyMs;
+volatile uint32_t SyslogBatch::_isr_drops = 0;
+
+
+
+//------------------------------------------------------------------------------------
+//-- PUBLIC METHODS IMPLEMENTATION ---------------------------------------------------
+//------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------
+void SyslogBatch::start(Sink sink, uint32_t rate, uint32_t burst, uint32_t max_latency_ms){
+	MBED_ASSERT(!IS_ISR() && !_thread);
+	_sink = sink;
+	_poll_ms = (max_latency_ms > 1)? (max_latency_ms / 2) : 1;
+	SyslogBatchCore* core = new SyslogBatchCore(rate, burst, max_latency_ms);
+	_thread = new Thread(ThreadPriority, ThreadStackSize, NULL, "syslog_batch");
+	MBED_ASSERT(core && _thread);
+	osStatus err = _thread->start(callback(&SyslogBatch::task));
+	MBED_ASSERT(err == osOK);
+	// se publica una vez arrancado el thread: hasta entonces print() descarta
+	__atomic_store_n(&_core, core, __ATOMIC_SEQ_CST);
+}
+
+
+//------------------------------------------------------------------------------------
+void SyslogBatch::print(const char* level, const char* tag, const char* format, ...){
+	SyslogBatchCore* core = __atomic_load_n(&_core, __ATOMIC_SEQ_CST);
+	if(!core){
+		return;
+	}
+	// desde ISR no se formatea: se contabiliza y el thread de envío lo incluye en la siguiente línea de descartes
+	if(IS_ISR()){
+		__atomic_add_fetch(&_isr_drops, 1, __ATOMIC_RELAXED);
+		return;
+	}
+	uint32_t t = now();
+
+	// la tasa se comprueba antes de formatear, para no formatear las trazas descartadas
+	portENTER_CRITICAL(&_mux);
+	collectIsrDrops(core);
+	SyslogBatchCore::Result res = core->admit(tag, t);
+	portEXIT_CRITICAL(&_mux);
+	if(res != SyslogBatchCore::Accepted){
+		return;
+	}
+
+	// se formatea fuera del spinlock, reservando el '\n' final
+	char line[MaxRecordLength];
+	int n = snprintf(line, sizeof(line) - 1, "%s %s ", level, tag);
+	n = (n < (int)sizeof(line) - 1)? n : (int)sizeof(line) - 2;
+	va_list args;
+	va_start(args, format);
+	int m = vsnprintf(&line[n], sizeof(line) - 1 - n, format, args);
+	va_end(args);
+	n += (m < 0)? 0 : ((m < (int)sizeof(line) - 1 - n)? m : (int)sizeof(line) - 2 - n);
+	line[n++] = '\n';
+
+	portENTER_CRITICAL(&_mux);
+	int pending = core->pending();
+	core->append(line, n, t);
+	bool ready = (core->pending() > pending);
+	portEXIT_CRITICAL(&_mux);
+	// una trama cerrada por tamaño se envía sin esperar al periodo del thread
+	if(ready){
+		_thread->signal_set(FrameReadySignal);
+	}
+}
+
+
+//------------------------------------------------------------------------------------
+void SyslogBatch::flush(){
+	if(!_core){
+		return;
+	}
+	portENTER_CRITICAL(&_mux);
+	_core->close();
+	portEXIT_CRITICAL(&_mux);
+	_thread->signal_set(FrameReadySignal);
+}
+
+
+//------------------------------------------------------------------------------------
+void SyslogBatch::getStats(SyslogBatchCore::Stats_t* stats){
+	if(!_core){
+		memset(stats, 0, sizeof(SyslogBatchCore::Stats_t));
+		return;
+	}
+	portENTER_CRITICAL(&_mux);
+	collectIsrDrops(_core);
+	_core->getStats(stats);
+	portEXIT_CRITICAL(&_mux);
+}
+
+
+//------------------------------------------------------------------------------------
+void SyslogBatch::resetStats(){
+	if(!_core){
+		return;
+	}
+	portENTER_CRITICAL(&_mux);
+	_core->resetStats();
+	portEXIT_CRITICAL(&_mux);
+}
+
+
+
+//------------------------------------------------------------------------------------
+//-- PRIVATE METHODS IMPLEMENTATION --------------------------------------------------
+//------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------
+void SyslogBatch::task(){
+	// espera a que print() pueda registrar
+	while(!__atomic_load_n(&_core, __ATOMIC_SEQ_CST)){
+		Thread::wait(1);
+	}
+	for(;;){
+		Thread::signal_wait(FrameReadySignal, _poll_ms);
+		for(;;){
+			portENTER_CRITICAL(&_mux);
+			collectIsrDrops(_core);
+			SyslogBatchCore::Frame_t* f = _core->next(now());
+			portEXIT_CRITICAL(&_mux);
+			if(!f){
+				break;
+			}
+			// el destino puede bloquear: la trama es del thread hasta su release()
+			_sink(f->data, f->len);
+			portENTER_CRITICAL(&_mux);
+			_core->release(f);
+			portEXIT_CRITICAL(&_mux);
+		}
+	}
+}
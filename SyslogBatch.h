@@ -0,0 +1,121 @@
+/*
+ * SyslogBatch.h
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ *	Adaptador de syslog por lotes. Se instala como 'syslog_print' delante del destino real (p.ej. un envío por red),
+ *	de forma que las trazas DEBUG_TRACE_* no esperan a que éste complete cada envío: la traza se formatea en el
+ *	thread llamante, se copia en la trama en curso con un spinlock y un thread de baja prioridad entrega las tramas
+ *	completas (por tamaño o por antigüedad) al destino. La limitación de tasa por tag y el agotamiento de tramas
+ *	descartan trazas y lo notifican en la siguiente trama, sin bloquear nunca al llamante (ver SyslogBatchCore.h).
+ *
+ */
+
+#ifndef MBED_SYSLOG_BATCH_H
+#define MBED_SYSLOG_BATCH_H
+
+#include "mbed_api.h"
+#include "Callback.h"
+#include "SyslogBatchCore.h"
+
+
+class Thread;
+
+
+/** The SyslogBatch class batches the traces forwarded to syslog and hands whole frames to the real sink.
+ *
+ * @code
+ * static void udpSend(const char* data, uint32_t len){ ... }
+ * ...
+ * SyslogBatch::start(callback(udpSend));
+ * syslog_print = SyslogBatch::print;
+ * @endcode
+ *
+ * Each frame holds several newline-terminated records "<level> <tag> <message>\n". The sink is called from the
+ * SyslogBatch thread, one frame at a time, and may block as long as it needs: while it does, new records fill
+ * the free frames, and once they are exhausted records are dropped and counted.
+ *
+ * @note Synchronization level: print() is thread safe. From an ISR the record is dropped, and counted in the drop report
+ */
+class SyslogBatch {
+public:
+
+	/** Tipo del destino de las tramas */
+	typedef Callback<void(const char*, uint32_t)> Sink;
+
+	/** Longitud máxima de una traza formateada */
+	static const int MaxRecordLength = 160;
+
+	/** Valores por defecto de la limitación de tasa por tag y de la antigüedad máxima de una trama */
+	static const uint32_t DefaultRate = 50;
+	static const uint32_t DefaultBurst = 100;
+	static const uint32_t DefaultLatencyMs = 100;
+
+	/** Prioridad y stack del thread de envío */
+	static const int ThreadPriority = (osPriorityIdle + 1);
+	static const uint32_t ThreadStackSize = 3072;
+
+
+	/** Arranca el thread de envío
+	 *  @param sink Destino de las tramas
+	 *  @param rate Trazas por segundo admitidas por tag (0: sin límite)
+	 *  @param burst Ráfaga máxima de trazas por tag
+	 *  @param max_latency_ms Antigüedad máxima de una trama antes de enviarla
+	 */
+	static void start(Sink sink, uint32_t rate = DefaultRate, uint32_t burst = DefaultBurst, uint32_t max_latency_ms = DefaultLatencyMs);
+
+
+	/** Registra una traza. Compatible con 'syslog_print'
+	 *  @param level Nivel ("E", "W", "I", "D", "V")
+	 *  @param tag Tag
+	 *  @param format Formato printf
+	 */
+	static void print(const char* level, const char* tag, const char* format, ...);
+
+
+	/** Cierra la trama en curso y despierta al thread de envío, sin esperar al envío
+	 */
+	static void flush();
+
+
+	/** Obtiene las estadísticas
+	 *  @param stats Recibe las estadísticas
+	 */
+	static void getStats(SyslogBatchCore::Stats_t* stats);
+
+
+	/** Reinicia las estadísticas
+	 */
+	static void resetStats();
+
+private:
+
+	/** Flag de notificación al thread de envío */
+	static const int32_t FrameReadySignal = (1 << 0);
+
+	static SyslogBatchCore* _core;
+	static portMUX_TYPE _mux;
+	static Thread* _thread;
+	static Sink _sink;
+	static uint32_t _poll_ms;			/// Periodo de comprobación de la antigüedad de la trama en curso
+	static volatile uint32_t _isr_drops;	/// Trazas descartadas desde ISR, pendientes de pasar al núcleo
+
+	/** Pasa al núcleo los descartes desde ISR acumulados. Se llama con el spinlock tomado
+	 *  @param core Núcleo
+	 */
+	static inline void collectIsrDrops(SyslogBatchCore* core){
+		uint32_t drops = __atomic_exchange_n(&_isr_drops, 0, __ATOMIC_RELAXED);
+		if(drops){
+			core->dropIsr(drops);
+		}
+	}
+
+	static inline uint32_t now() { return (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS); }
+	static void task();
+};
+
+
+#endif
+
+/** @}*/
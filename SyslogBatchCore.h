@@ -0,0 +1,289 @@
+/*
+ * SyslogBatchCore.h
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ *	Núcleo portable del adaptador de syslog por lotes (SyslogBatch): agrupa las trazas en tramas de tamaño fijo, que
+ *	se cierran por tamaño o por antigüedad, limita la tasa de cada tag con un token bucket y contabiliza los descartes
+ *	en lugar de bloquear al llamante. Los descartes pendientes se notifican con una línea al inicio de la siguiente
+ *	trama. No depende del hardware ni del RTOS, de forma que se prueba en host.
+ *
+ *	No incluye sincronización: el llamante protege todas las llamadas (en SyslogBatch, con un spinlock). Una trama
+ *	entregada por next() pertenece al llamante hasta su release(), de forma que puede enviarse fuera del spinlock.
+ *
+ */
+
+#ifndef SYSLOG_BATCH_CORE_H
+#define SYSLOG_BATCH_CORE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+
+/** Tamaño en bytes de cada trama */
+#if !defined(MBED_SYSLOG_FRAME_SIZE)
+#define MBED_SYSLOG_FRAME_SIZE		512
+#endif
+
+/** Número de tramas (la que se llena y las pendientes de envío) */
+#if !defined(MBED_SYSLOG_FRAMES)
+#define MBED_SYSLOG_FRAMES			4
+#endif
+
+
+class SyslogBatchCore {
+public:
+
+	/** Tamaño de cada trama */
+	static const uint32_t FrameSize = MBED_SYSLOG_FRAME_SIZE;
+
+	/** Número de tramas */
+	static const int FrameCount = MBED_SYSLOG_FRAMES;
+
+	/** Número de tags con limitación de tasa propia. El resto comparte un bucket común */
+	static const int MaxTags = 16;
+
+	/** Resultado del registro de una traza */
+	enum Result {
+		Accepted = 0,			/// Copiada en la trama en curso
+		DroppedRate,			/// Descartada por la tasa de su tag
+		DroppedFull,			/// Descartada por no haber tramas libres
+	};
+
+	/** Trama */
+	struct Frame_t {
+		uint32_t len;			/// Bytes ocupados
+		uint32_t opened;		/// Instante (ms) de la primera traza
+		char data[FrameSize];
+	};
+
+	/** Estadísticas
+	 */
+	struct Stats_t {
+		uint32_t accepted;		/// Trazas copiadas en una trama
+		uint32_t dropped_rate;	/// Trazas descartadas por la tasa de su tag
+		uint32_t dropped_full;	/// Trazas descartadas por no haber tramas libres
+		uint32_t dropped_isr;	/// Trazas descartadas por registrarse desde una ISR
+		uint32_t reports;		/// Líneas de descartes insertadas
+		uint32_t frames;		/// Tramas enviadas
+		uint32_t bytes;			/// Bytes enviados
+		uint32_t max_pending;	/// Máximo de tramas cerradas pendientes de envío
+	};
+
+
+	/** Constructor
+	 *  @param rate Trazas por segundo admitidas por tag (0: sin límite)
+	 *  @param burst Ráfaga máxima de trazas por tag
+	 *  @param max_latency_ms Antigüedad máxima de una trama antes de cerrarla
+	 */
+	SyslogBatchCore(uint32_t rate, uint32_t burst, uint32_t max_latency_ms) : _rate(rate), _burst(burst),
+			_max_latency(max_latency_ms), _first(0), _closed(0), _sending(false), _ntags(0), _unreported_rate(0),
+			_unreported_full(0), _unreported_isr(0) {
+		memset(_frames, 0, sizeof(_frames));
+		memset(_tags, 0, sizeof(_tags));
+		memset(&_stats, 0, sizeof(_stats));
+	}
+
+
+	/** Aplica la limitación de tasa del tag. Se llama antes de formatear la traza, para no formatear las descartadas
+	 *  @param tag Tag (se compara por contenido)
+	 *  @param now Instante actual (ms)
+	 *  @return Accepted o DroppedRate
+	 */
+	Result admit(const char* tag, uint32_t now){
+		if(_rate == 0){
+			return Accepted;
+		}
+		Bucket_t* b = bucket(tag, now);
+		uint64_t max = (uint64_t)_burst * 1000;
+		uint64_t tokens = b->tokens + (uint64_t)(uint32_t)(now - b->last) * _rate;
+		b->tokens = (uint32_t)((tokens > max)? max : tokens);
+		b->last = now;
+		if(b->tokens < 1000){
+			b->dropped++;
+			_stats.dropped_rate++;
+			_unreported_rate++;
+			return DroppedRate;
+		}
+		b->tokens -= 1000;
+		return Accepted;
+	}
+
+
+	/** Copia una traza formateada en la trama en curso. Si no cabe, cierra la trama y continúa en la siguiente
+	 *  @param text Traza (se trunca al tamaño de trama)
+	 *  @param len Longitud
+	 *  @param now Instante actual (ms)
+	 *  @return Accepted o DroppedFull
+	 */
+	Result append(const char* text, uint32_t len, uint32_t now){
+		if(len > FrameSize / 2){
+			len = FrameSize / 2;
+		}
+		Frame_t* f = open(now);
+		if(f && f->len + len > FrameSize){
+			close();
+			f = open(now);
+		}
+		if(!f){
+			_stats.dropped_full++;
+			_unreported_full++;
+			return DroppedFull;
+		}
+		memcpy(&f->data[f->len], text, len);
+		f->len += len;
+		_stats.accepted++;
+		return Accepted;
+	}
+
+
+	/** Contabiliza trazas descartadas antes de llegar al núcleo por registrarse desde una ISR, para notificarlas en la
+	 *  siguiente trama como el resto de descartes
+	 *  @param count Trazas descartadas
+	 */
+	void dropIsr(uint32_t count){
+		_stats.dropped_isr += count;
+		_unreported_isr += count;
+	}
+
+
+	/** Obtiene la siguiente trama a enviar. La trama en curso se cierra si ha superado su antigüedad máxima
+	 *  @param now Instante actual (ms)
+	 *  @return Trama (hasta su release()) o NULL si no hay ninguna o ya hay una en envío
+	 */
+	Frame_t* next(uint32_t now){
+		if(_sending){
+			return NULL;
+		}
+		if(_closed == 0){
+			Frame_t* f = &_frames[_first];
+			if(f->len == 0 || (uint32_t)(now - f->opened) < _max_latency){
+				return NULL;
+			}
+			close();
+		}
+		_sending = true;
+		return &_frames[_first];
+	}
+
+
+	/** Libera la trama entregada por next() una vez enviada
+	 *  @param f Trama
+	 */
+	void release(Frame_t* f){
+		_stats.frames++;
+		_stats.bytes += f->len;
+		f->len = 0;
+		_first = (_first + 1) % FrameCount;
+		_closed--;
+		_sending = false;
+	}
+
+
+	/** Cierra la trama en curso si tiene contenido, para que next() la entregue sin esperar a su antigüedad máxima
+	 */
+	void close(){
+		if(_closed < FrameCount && _frames[index(_closed)].len > 0){
+			_closed++;
+			if((uint32_t)_closed > _stats.max_pending){
+				_stats.max_pending = _closed;
+			}
+		}
+	}
+
+
+	/** Número de tramas cerradas pendientes de envío (incluida la que está en envío) */
+	int pending() const { return _closed; }
+
+	/** Obtiene las estadísticas */
+	void getStats(Stats_t* stats) const { *stats = _stats; }
+
+	/** Reinicia las estadísticas */
+	void resetStats() { memset(&_stats, 0, sizeof(_stats)); }
+
+	/** Obtiene los descartes por tasa de un tag
+	 *  @param tag Tag
+	 *  @return Descartes, 0 si el tag no tiene bucket propio
+	 */
+	uint32_t tagDrops(const char* tag) const {
+		for(int i = 0; i < _ntags; i++){
+			if(_tags[i].tag == tag || strcmp(_tags[i].tag, tag) == 0){
+				return _tags[i].dropped;
+			}
+		}
+		return 0;
+	}
+
+private:
+
+	static_assert(FrameSize >= 256, "MBED_SYSLOG_FRAME_SIZE demasiado pequeño");
+	static_assert(FrameCount >= 2, "MBED_SYSLOG_FRAMES debe ser al menos 2");
+
+	/** Token bucket de un tag, en milésimas de traza */
+	struct Bucket_t {
+		const char* tag;
+		uint32_t tokens;
+		uint32_t last;
+		uint32_t dropped;
+	};
+
+	uint32_t _rate;
+	uint32_t _burst;
+	uint32_t _max_latency;
+	Frame_t _frames[FrameCount];
+	int _first;					/// Primera trama cerrada (o la trama en curso si no hay cerradas)
+	int _closed;				/// Tramas cerradas. La trama en curso es la siguiente
+	bool _sending;
+	Bucket_t _tags[MaxTags + 1];	/// El último es el bucket común
+	int _ntags;
+	uint32_t _unreported_rate;
+	uint32_t _unreported_full;
+	uint32_t _unreported_isr;
+	Stats_t _stats;
+
+	inline int index(int n) const { return (_first + n) % FrameCount; }
+
+	/** Trama en curso, abriéndola si está vacía (con la línea de descartes pendientes). NULL si no hay libres */
+	Frame_t* open(uint32_t now){
+		if(_closed == FrameCount){
+			return NULL;
+		}
+		Frame_t* f = &_frames[index(_closed)];
+		if(f->len == 0){
+			f->opened = now;
+			if(_unreported_rate || _unreported_full || _unreported_isr){
+				int n = snprintf(f->data, FrameSize, "W [SyslogBatch] Descartadas %u por tasa, %u por tramas llenas, %u desde ISR\n",
+						(unsigned)_unreported_rate, (unsigned)_unreported_full, (unsigned)_unreported_isr);
+				f->len = ((uint32_t)n < FrameSize)? n : FrameSize - 1;
+				_unreported_rate = 0;
+				_unreported_full = 0;
+				_unreported_isr = 0;
+				_stats.reports++;
+			}
+		}
+		return f;
+	}
+
+	/** Bucket del tag. Uno nuevo empieza con la ráfaga completa */
+	Bucket_t* bucket(const char* tag, uint32_t now){
+		for(int i = 0; i < _ntags; i++){
+			if(_tags[i].tag == tag || strcmp(_tags[i].tag, tag) == 0){
+				return &_tags[i];
+			}
+		}
+		Bucket_t* b = (_ntags < MaxTags)? &_tags[_ntags++] : &_tags[MaxTags];
+		if(!b->tag){
+			b->tag = tag;
+			b->tokens = _burst * 1000;
+			b->last = now;
+		}
+		return b;
+	}
+};
+
+
+#endif
+
+/** @}*/
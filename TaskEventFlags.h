@@ -0,0 +1,207 @@
+/*
+ * TaskEventFlags.h
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ *	Implementación de EventFlags que despierta directamente a los threads en espera mediante task notifications,
+ *	incluso desde una ISR, sin diferir la operación a través de la cola del timer daemon como hace
+ *	xEventGroupSetBitsFromISR. Admite conjuntos de flags de 32 y 64 bits.
+ *
+ */
+
+#ifndef MBED_TASKEVENTFLAGS_H
+#define MBED_TASKEVENTFLAGS_H
+
+#include "mbed_api.h"
+#include "WaitList.h"
+
+
+/** The TaskEventFlags class is used to signal or wait for an arbitrary event or events.
+  @tparam  T         flags storage type, uint32_t or uint64_t. All bits are usable as flags.
+
+ It keeps the EventFlags wait_any and wait_all semantics, but set() from interrupt context wakes the waiting
+ threads directly, so there is no timer daemon deferral and no failure when the daemon queue is full.
+
+ @note
+ Since every bit is a valid flag, wait methods do not return an error code. On timeout they return the
+ current flags, so the caller must check them against the requested mask (as with EventFlags).
+ @note
+ Memory considerations: no heap is used. Waiting threads are linked through nodes on their own stack.
+*/
+template<typename T>
+class TaskEventFlags  {
+public:
+    /** Create and Initialize a TaskEventFlags object
+     @param name name to be used for this TaskEventFlags. It has to stay allocated for the lifetime of the object.
+    */
+    TaskEventFlags(const char *name = "no-name") : _name(name), _flags(0) {
+    	vPortCPUInitializeMutex(&_mux);
+    }
+
+    /** Set the specified Event Flags.
+      @param   flags  specifies the flags that shall be set.
+      @return  event flags after setting, once the flags consumed by woken threads are cleared.
+     */
+    T set(T flags){
+    	BaseType_t woken = pdFALSE;
+    	WaitList::enter(&_mux);
+    	_flags |= flags;
+    	T to_clear = 0;
+    	Waiter* w = static_cast<Waiter*>(_waiters.first());
+    	while(w){
+    		Waiter* next = static_cast<Waiter*>(w->next);
+    		if(_satisfied(w->mask, w->all)){
+    			w->result = _flags;
+    			if(w->clear){
+    				to_clear |= w->mask;
+    			}
+    			_waiters.wake(w, &woken);
+    		}
+    		w = next;
+    	}
+    	_flags &= ~to_clear;
+    	T result = _flags;
+    	WaitList::exit(&_mux, woken);
+    	return result;
+    }
+
+    /** Clear the specified Event Flags.
+      @param   flags  specifies the flags that shall be cleared. (default: all flags)
+      @return  event flags before clearing.
+     */
+    T clear(T flags = (T)~((T)0)){
+    	WaitList::enter(&_mux);
+    	T result = _flags;
+    	_flags &= ~flags;
+    	WaitList::exit(&_mux);
+    	return result;
+    }
+
+    /** Get the currently set Event Flags.
+      @return  set event flags.
+     */
+    T get() const {
+    	// con T de 64 bits la lectura no es atómica en el ESP32
+    	WaitList::enter(&_mux);
+    	T result = _flags;
+    	WaitList::exit(&_mux);
+    	return result;
+    }
+
+    /** Wait for all of the specified event flags to become signaled.
+      @param   flags    specifies the flags to wait for. 0 waits for any flag.
+      @param   timeout  timeout value or 0 in case of no time-out. (default: osWaitForever)
+      @param   clear    specifies wether to clear the flags after waiting for them. (default: true)
+      @return  event flags before clearing, or current flags on timeout.
+     */
+    T wait_all(T flags = 0, uint32_t timeout = osWaitForever, bool clear = true){
+    	return _wait(flags, timeout, clear, true);
+    }
+
+    /** Wait for any of the specified event flags to become signaled.
+      @param   flags    specifies the flags to wait for. 0 waits for any flag. (default: 0)
+      @param   timeout  timeout value or 0 in case of no time-out. (default: osWaitForever)
+      @param   clear    specifies wether to clear the flags after waiting for them. (default: true)
+      @return  event flags before clearing, or current flags on timeout.
+     */
+    T wait_any(T flags = 0, uint32_t timeout = osWaitForever, bool clear = true){
+    	return _wait(flags, timeout, clear, false);
+    }
+
+    /** Get the name of this object
+      @return  name
+     */
+    const char* get_name() const { return _name; }
+
+    ~TaskEventFlags(){
+    	MBED_ASSERT(_waiters.empty());
+    }
+
+private:
+
+    /** Nodo de espera con los parámetros de la condición */
+    struct Waiter : public WaitList::Node {
+    	T mask;				/// Flags esperados
+    	T result;			/// Flags en el momento de cumplirse la condición
+    	bool all;			/// Espera de todos los flags (true) o de cualquiera (false)
+    	bool clear;			/// Borrado de los flags esperados al cumplirse la condición
+    };
+
+    const char* _name;		/// Nombre del objeto
+    volatile T _flags;		/// Flags activos
+    mutable portMUX_TYPE _mux;	/// Spinlock de acceso a flags y lista de espera
+    WaitList _waiters;		/// Threads en espera
+
+    /** Evalúa la condición de espera. Se invoca con el spinlock tomado
+     *  @param mask Flags esperados
+     *  @param all Espera de todos los flags o de cualquiera
+     *  @return true si se cumple
+     */
+    bool _satisfied(T mask, bool all) const {
+    	return (all)? ((_flags & mask) == mask) : ((_flags & mask) != 0);
+    }
+
+    /** Espera genérica para wait_all y wait_any */
+    T _wait(T flags, uint32_t timeout, bool clear, bool all){
+    	T mask = (flags == 0)? (T)~((T)0) : flags;
+    	if(flags == 0){
+    		all = false;
+    	}
+    	WaitList::enter(&_mux);
+    	if(_satisfied(mask, all)){
+    		T result = _flags;
+    		if(clear){
+    			_flags &= ~mask;
+    		}
+    		WaitList::exit(&_mux);
+    		return result;
+    	}
+    	if(timeout == 0 || IS_ISR()){
+    		T result = _flags;
+    		WaitList::exit(&_mux);
+    		return result;
+    	}
+    	Waiter w;
+    	w.mask = mask;
+    	w.result = 0;
+    	w.all = all;
+    	w.clear = clear;
+    	_waiters.enqueue(&w);
+    	WaitList::exit(&_mux);
+
+    	TickType_t ticks = MBED_MILLIS_TO_TICK(timeout);
+    	TickType_t start = xTaskGetTickCount();
+    	bool signals = false;
+    	for(;;){
+    		TickType_t left = WaitList::remaining(start, ticks);
+    		if(left > 0){
+    			WaitList::block(left, &signals);
+    		}
+    		WaitList::enter(&_mux);
+    		if(w.signaled){
+    			WaitList::exit(&_mux);
+    			WaitList::rearm(signals);
+    			return w.result;
+    		}
+    		if(WaitList::remaining(start, ticks) == 0){
+    			_waiters.remove(&w);
+    			T result = _flags;
+    			WaitList::exit(&_mux);
+    			WaitList::rearm(signals);
+    			return result;
+    		}
+    		WaitList::exit(&_mux);
+    	}
+    }
+};
+
+
+/** Tipos predefinidos de 32 y 64 flags */
+typedef TaskEventFlags<uint32_t> EventFlags32;
+typedef TaskEventFlags<uint64_t> EventFlags64;
+
+
+#endif
+
+/** @}*/
@@ -10,6 +10,10 @@
 
 static const char* _MODULE_ = "[Thread]........";
 #define _EXPR_	(!IS_ISR())
+#if !defined(MBED_TRACE_LEVEL_THREAD)
+#define MBED_TRACE_LEVEL_THREAD	MBED_TRACE_LEVEL
+#endif
+#define _LEVEL_	MBED_TRACE_LEVEL_THREAD
 
 //------------------------------------------------------------------------------------
 //--- PRIVATE TYPES ------------------------------------------------------------------
@@ -147,12 +151,14 @@ osEvent Thread::signal_wait(int32_t signals, uint32_t millisec) {
 	osEvent evt;
 	uint32_t flags = 0;
 
+	// el flag osFlagsWakeup pertenece a las primitivas basadas en notificaciones (Notifier, ...) y no se consume aqu
 	do{
-		if(xTaskNotifyWait(flags, ULONG_MAX, &flags, MBED_MILLIS_TO_TICK(millisec)) != pdPASS){
+		if(xTaskNotifyWait(flags, (ULONG_MAX & ~osFlagsWakeup), &flags, MBED_MILLIS_TO_TICK(millisec)) != pdPASS){
 			evt.status = (osStatus)osEventTimeout;
 			return evt;
 		}
-	}while(signals != 0 && (signals & flags) == 0);
+		flags &= ~osFlagsWakeup;
+	}while((signals != 0 && (signals & flags) == 0) || flags == 0);
 	evt.status = (osStatus)osEventSignal;
 	evt.value.signals = flags;
 	return evt;
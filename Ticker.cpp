@@ -21,6 +21,15 @@
 //---- STATIC ------------------------------------------------------------------------
 //------------------------------------------------------------------------------------
 
+static const char* _MODULE_ = "[Ticker]........";
+#define _EXPR_	(!IS_ISR())
+#if !defined(MBED_TRACE_LEVEL_TICKER)
+#define MBED_TRACE_LEVEL_TICKER	MBED_TRACE_LEVEL
+#endif
+#define _LEVEL_	MBED_TRACE_LEVEL_TICKER
+
+
+//------------------------------------------------------------------------------------
 static void defaultCallback(){
 }
 
@@ -43,23 +52,66 @@ Ticker::Ticker(int32_t uuid) {
 	}
 	_tdata.uuid = uuid;
 	_tdata.func = callback(defaultCallback);
+	_tdata.ref = FunctionRef<void()>();
 	_tdata.timeout = 0;
+	_tdata.slack = 0;
 	_tdata.next_event = 0;
+	_tdata.heap_idx = -1;
+	_tdata.dispatch = Ticker_HAL::DispatchISR;
+	_tdata.coalesce = true;
+	_tdata.queued = 0;
+	_tdata.fired_at = 0;
+	_tdata.overruns = 0;
+	_tdata.overrun = Ticker_HAL::OverrunSkip;
+	_tdata.late_fires = 0;
+	_tdata.max_lateness = 0;
+	_tdata.skipped = 0;
+	_tdata.affinity = Ticker_HAL::AnyCore;
+	_tdata.shard = -1;
+	_tdata.oneshot = false;
+#if MBED_TICKER_HISTOGRAMS
+	memset(&_tdata.hist, 0, sizeof(Ticker_HAL::TickerHist_t));
+#endif
 }
 
 
 //------------------------------------------------------------------------------------
-void Ticker::attach_us(Callback<void()> func, uint64_t microsec) {
+void Ticker::attach_us(Callback<void()> func, uint64_t microsec, uint64_t slack_us) {
 	// desconecta una posible referencia anterior
 	detach();
+	// la callback se copia en cada disparo con un spinlock tomado: su copia no puede reservar memoria, por lo
+	// que se rechaza en cualquier tipo de compilacin
+	if(func.heap_allocated()){
+		DEBUG_TRACE_E(_EXPR_, _MODULE_, "Callback en heap rechazada, utilizar una FunctionRef");
+		return;
+	}
 
 	// reajusta los parmetros
     _tdata.func = func;
-    // calcula el timeout en ticks en relacin al Scale
-    _tdata.timeout = (microsec * Ticker_HAL::TimerScale)/1000000;
-    _tdata.next_event = Ticker_HAL::getRawCounter() + _tdata.timeout;
-	// conecta la nueva referencia
-	Ticker_HAL::attach(&_tdata);
+    arm(microsec, slack_us);
+}
+
+
+//------------------------------------------------------------------------------------
+void Ticker::attach_us(FunctionRef<void()> func, uint64_t microsec, uint64_t slack_us) {
+	detach();
+	if(!func){
+		return;
+	}
+	// la ISR invoca la referencia sin copiar la callback por defecto
+    _tdata.ref = func;
+    arm(microsec, slack_us);
+}
+
+
+//------------------------------------------------------------------------------------
+void Ticker::set_dispatch(Ticker_HAL::DispatchMode mode, bool coalesce) {
+	// el thread de servicio se arranca con el primer ticker que lo requiere
+	if(mode == Ticker_HAL::DispatchThread){
+		Ticker_HAL::startService();
+	}
+	_tdata.coalesce = coalesce;
+	_tdata.dispatch = mode;
 }
 
 
@@ -69,5 +121,26 @@ void Ticker::detach() {
 	Ticker_HAL::detach(&_tdata);
 	// borra parmetros a valores por defecto
     _tdata.func = callback(defaultCallback);
+    _tdata.ref = FunctionRef<void()>();
+}
+
+
+
+//------------------------------------------------------------------------------------
+//-- PRIVATE METHODS IMPLEMENTATION --------------------------------------------------
+//------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------
+void Ticker::arm(uint64_t microsec, uint64_t slack_us) {
+    // calcula el timeout en ticks en relacin al Scale
+    _tdata.timeout = (microsec * Ticker_HAL::TimerScale)/1000000;
+    if(_tdata.timeout == 0){
+    	_tdata.timeout = 1;
+    }
+    _tdata.slack = (slack_us * Ticker_HAL::TimerScale)/1000000;
+    _tdata.next_event = Ticker_HAL::getRawCounter() + _tdata.timeout;
+	// conecta la nueva referencia
+	Ticker_HAL::attach(&_tdata);
 }
 
@@ -18,6 +18,7 @@
 
 #include "mbed_api.h"
 #include "Ticker_HAL.h"
+#include "CallChain.h"
 
 
 class Ticker  {
@@ -39,9 +40,10 @@ public:
      *
      *  @param func pointer to the function to be called
      *  @param t the time between calls in seconds
+     *  @param slack delay tolerated on each call in seconds (default: 0)
      */
-    void attach(Callback<void()> func, float t) {
-        attach_us(func, (uint64_t)(t * 1000000.0f));
+    void attach(Callback<void()> func, float t, float slack = 0) {
+        attach_us(func, (uint64_t)(t * 1000000.0f), (uint64_t)(slack * 1000000.0f));
     }
 
 
@@ -49,8 +51,70 @@ public:
      *
      *  @param func pointer to the function to be called
      *  @param t the time between calls in us
+     *  @param slack_us delay tolerated on each call, so it can be batched with other tickers whose windows
+     *  		overlap into a single interrupt. (default: 0, exact)
+     *  @note The Callback is copied on every call from the ISR (or the service thread) while holding a spinlock,
+     *  		so function objects stored on the heap (MBED_CALLBACK_HEAP_FALLBACK) are rejected in every build: the
+     *  		Ticker is left detached and an error is traced. Use a FunctionRef to the function object instead
      */
-    void attach_us(Callback<void()> func, uint64_t microsec);
+    void attach_us(Callback<void()> func, uint64_t microsec, uint64_t slack_us = 0);
+
+
+    /** Attach a function reference to be called by the Ticker, specifying the interval in us. The interrupt (or
+     *  the service thread) calls it directly, without copying a Callback
+     *
+     *  @param func reference to the function to be called. The referenced function must outlive the attachment
+     *  @param t the time between calls in us
+     *  @param slack_us delay tolerated on each call (default: 0, exact)
+     */
+    void attach_us(FunctionRef<void()> func, uint64_t microsec, uint64_t slack_us = 0);
+
+
+    /** Attach a member function bound at compile time, specifying the interval in seconds
+     *
+     *  @param func bound member function (see MBED_BOUND_CALLBACK)
+     *  @param t the time between calls in seconds
+     *  @param slack delay tolerated on each call in seconds (default: 0)
+     */
+    template <typename M, M Method>
+    void attach(const BoundCallback<M, Method> &func, float t, float slack = 0) {
+        attach_us(FunctionRef<void()>(func), (uint64_t)(t * 1000000.0f), (uint64_t)(slack * 1000000.0f));
+    }
+
+
+    /** Attach a member function bound at compile time, specifying the interval in us
+     *
+     *  @param func bound member function (see MBED_BOUND_CALLBACK)
+     *  @param t the time between calls in us
+     *  @param slack_us delay tolerated on each call (default: 0, exact)
+     */
+    template <typename M, M Method>
+    void attach_us(const BoundCallback<M, Method> &func, uint64_t microsec, uint64_t slack_us = 0) {
+        attach_us(FunctionRef<void()>(func), microsec, slack_us);
+    }
+
+
+    /** Attach a chain of callbacks, so several observers share the same ticker. Links can be added to and removed
+     *  from the chain while the ticker runs
+     *
+     *  @param chain chain to be called. It must outlive the attachment
+     *  @param t the time between calls in seconds
+     *  @param slack delay tolerated on each call in seconds (default: 0)
+     */
+    void attach(CallChain &chain, float t, float slack = 0) {
+        attach_us(FunctionRef<void()>(chain), (uint64_t)(t * 1000000.0f), (uint64_t)(slack * 1000000.0f));
+    }
+
+
+    /** Attach a chain of callbacks, specifying the interval in us
+     *
+     *  @param chain chain to be called. It must outlive the attachment
+     *  @param t the time between calls in us
+     *  @param slack_us delay tolerated on each call (default: 0, exact)
+     */
+    void attach_us(CallChain &chain, uint64_t microsec, uint64_t slack_us = 0) {
+        attach_us(FunctionRef<void()>(chain), microsec, slack_us);
+    }
 
 
     /** Detach the function
@@ -58,9 +122,73 @@ public:
     void detach();
 
 
+    /** Select the context in which the callback is executed
+     *  @param mode Ticker_HAL::DispatchISR (default) runs the callback inside the timer interrupt.
+     *  			Ticker_HAL::DispatchThread defers it to the high-priority Ticker_HAL service thread, so the
+     *  			interrupt only re-arms the hardware alarm.
+     *  @param coalesce In DispatchThread mode, if the callback has not consumed the previous event when the next
+     *  			one expires, both are merged into a single call (counted in overruns()). (default: true)
+     */
+    void set_dispatch(Ticker_HAL::DispatchMode mode, bool coalesce = true);
+
+
+    /** Get the number of events merged (coalesce) or dropped by a full dispatch ring
+     *  @return overruns
+     */
+    uint32_t overruns() const { return _tdata.overruns; }
+
+
+    /** Select the core whose hardware timer (and ISR) serves this ticker. It applies on the next attach
+     *  @param core Core number or Ticker_HAL::AnyCore (default) to use the core running attach
+     */
+    void set_affinity(int core) { _tdata.affinity = core; }
+
+
+    /** Select how a periodic ticker is rescheduled when it fires one or more periods late
+     *  @param policy Ticker_HAL::OverrunSkip (default), Ticker_HAL::OverrunCatchUp or Ticker_HAL::OverrunFireOnce
+     */
+    void set_overrun_policy(Ticker_HAL::OverrunPolicy policy) { _tdata.overrun = policy; }
+
+
+    /** Get the number of fires delayed more than Ticker_HAL::LateToleranceTicks from their deadline
+     *  @return late fires
+     */
+    uint32_t late_fires() const { return _tdata.late_fires; }
+
+
+    /** Get the worst-case lateness of a fire from its deadline
+     *  @return lateness in us
+     */
+    uint32_t max_lateness_us() const { return (uint32_t)(((uint64_t)_tdata.max_lateness * 1000000) / Ticker_HAL::TimerScale); }
+
+
+    /** Get the number of periods skipped with Ticker_HAL::OverrunSkip policy
+     *  @return skipped periods
+     */
+    uint32_t skipped() const { return _tdata.skipped; }
+
+
+    /** Get a snapshot of the lateness and callback duration histograms of this ticker (in CPU cycles). They are
+     *  only filled in when the library is built with MBED_TICKER_HISTOGRAMS=1
+     *  @param snap receives the histograms
+     */
+    void get_histograms(Ticker_HAL::TickerHist_t* snap) const { Ticker_HAL::getHistograms(&_tdata, snap); }
+
+
+    /** Reset the histograms of this ticker and the aggregated ones
+     */
+    void reset_histograms() { Ticker_HAL::resetHistograms(&_tdata); }
+
+
 protected:
     Ticker_HAL::TickerData_t _tdata;	// Estructura que contiene callback y timestamp
 
+private:
+    /** Calcula la temporizacin y conecta el ticker con la callback o referencia ya asignadas
+     *  @param microsec Temporizacin en us
+     *  @param slack_us Retraso admitido en us
+     */
+    void arm(uint64_t microsec, uint64_t slack_us);
 };
 
 
@@ -0,0 +1,323 @@
+/*
+ * TickerCore.h
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ *	Núcleo portable del planificador de tickers: cola de prioridad (min-heap por final de ventana de vencimiento),
+ *	política de reprogramación de tickers periódicos y cálculo de la siguiente alarma. No depende del hardware ni
+ *	del RTOS, de forma que el mismo código se ejecuta en Ticker_HAL (ESP32) y en TickerVirtual (host, con reloj
+ *	virtual).
+ *
+ *	Las rutinas son plantillas sobre el tipo de ticker T, que debe disponer de los campos:
+ *		uint64_t next_event, timeout, slack;
+ *		int32_t heap_idx;
+ *		bool oneshot;
+ *		TickerCore::OverrunPolicy overrun;
+ *		uint32_t late_fires, max_lateness, skipped;
+ *	No incluyen sincronización: el llamante protege la cola (en Ticker_HAL, con el spinlock de cada timer). La
+ *	rutina de servicio de la interrupción (service) recibe del llamante ésta y el resto de operaciones de la
+ *	plataforma.
+ *
+ */
+
+#ifndef TICKER_CORE_H
+#define TICKER_CORE_H
+
+#include <stdint.h>
+
+
+class TickerCore {
+public:
+
+    /** Valor de alarma cuando la cola está vacía */
+    static const uint64_t NoAlarm = UINT64_MAX;
+
+    /** Política de reprogramación cuando un ticker periódico se dispara con uno o más periodos de retraso. En
+     *  todos los casos el siguiente evento se calcula desde el anterior (next_event += timeout), de forma que la
+     *  latencia de la ISR y la duración de la callback no acumulan deriva
+     */
+    enum OverrunPolicy {
+    	OverrunSkip = 0,			/// Descarta los periodos perdidos manteniendo la fase (por defecto)
+    	OverrunCatchUp,				/// Ejecuta todos los periodos perdidos, uno tras otro
+    	OverrunFireOnce,			/// Ejecuta una vez y reprograma un periodo desde el instante actual (pierde la fase)
+    };
+
+
+    /** Obtiene la clave de ordenación de un ticker en la cola: el final de su ventana de vencimiento
+     *  @param tdata Elemento
+     *  @return next_event + slack
+     */
+    template<typename T>
+    static inline uint64_t deadline(const T* tdata){
+    	return (tdata->next_event + tdata->slack);
+    }
+
+
+    /** Coloca un elemento en una posición de la cola, actualizando su índice
+     *  @param heap Cola
+     *  @param idx Posición
+     *  @param tdata Elemento
+     */
+    template<typename T>
+    static inline void heapSet(T** heap, int idx, T* tdata){
+    	heap[idx] = tdata;
+    	tdata->heap_idx = idx;
+    }
+
+
+    /** Mueve un elemento hacia la raíz mientras sea más prioritario que su padre
+     *  @param heap Cola
+     *  @param idx Posición del elemento
+     *  @return Posición final
+     */
+    template<typename T>
+    static inline int heapSiftUp(T** heap, int idx){
+    	T* tdata = heap[idx];
+    	while(idx > 0){
+    		int parent = (idx - 1) / 2;
+    		if(deadline(heap[parent]) <= deadline(tdata)){
+    			break;
+    		}
+    		heapSet(heap, idx, heap[parent]);
+    		idx = parent;
+    	}
+    	heapSet(heap, idx, tdata);
+    	return idx;
+    }
+
+
+    /** Mueve un elemento hacia las hojas mientras sea menos prioritario que alguno de sus hijos
+     *  @param heap Cola
+     *  @param size Elementos en la cola
+     *  @param idx Posición del elemento
+     *  @return Posición final
+     */
+    template<typename T>
+    static inline int heapSiftDown(T** heap, int size, int idx){
+    	T* tdata = heap[idx];
+    	for(;;){
+    		int child = (2 * idx) + 1;
+    		if(child >= size){
+    			break;
+    		}
+    		if(child + 1 < size && deadline(heap[child + 1]) < deadline(heap[child])){
+    			child++;
+    		}
+    		if(deadline(tdata) <= deadline(heap[child])){
+    			break;
+    		}
+    		heapSet(heap, idx, heap[child]);
+    		idx = child;
+    	}
+    	heapSet(heap, idx, tdata);
+    	return idx;
+    }
+
+
+    /** Recoloca un elemento de la cola tras modificar su 'next_event' o su 'slack'
+     *  @param heap Cola
+     *  @param size Elementos en la cola
+     *  @param idx Posición del elemento
+     */
+    template<typename T>
+    static inline void heapUpdate(T** heap, int size, int idx){
+    	if(heapSiftUp(heap, idx) == idx){
+    		heapSiftDown(heap, size, idx);
+    	}
+    }
+
+
+    /** Inserta un elemento en la cola. El llamante comprueba la capacidad
+     *  @param heap Cola
+     *  @param size Elementos en la cola, se incrementa
+     *  @param tdata Elemento
+     */
+    template<typename T>
+    static inline void heapInsert(T** heap, int* size, T* tdata){
+    	heapSet(heap, *size, tdata);
+    	(*size)++;
+    	heapSiftUp(heap, *size - 1);
+    }
+
+
+    /** Retira un elemento de la cola. El último ocupa su posición y se recoloca
+     *  @param heap Cola
+     *  @param size Elementos en la cola, se decrementa
+     *  @param idx Posición del elemento
+     */
+    template<typename T>
+    static inline void heapRemove(T** heap, int* size, int idx){
+    	T* tdata = heap[idx];
+    	(*size)--;
+    	if(idx < *size){
+    		heapSet(heap, idx, heap[*size]);
+    		heapUpdate(heap, *size, idx);
+    	}
+    	tdata->heap_idx = -1;
+    }
+
+
+    /** Comprueba si un elemento está en la cola
+     *  @param heap Cola
+     *  @param size Elementos en la cola
+     *  @param tdata Elemento
+     *  @return true si está instalado
+     */
+    template<typename T>
+    static inline bool heapContains(T* const* heap, int size, const T* tdata){
+    	int idx = tdata->heap_idx;
+    	return (idx >= 0 && idx < size && heap[idx] == tdata);
+    }
+
+
+    /** Obtiene el ticker más prioritario si ya ha alcanzado el inicio de su ventana
+     *  @param heap Cola
+     *  @param size Elementos en la cola
+     *  @param now Contador actual
+     *  @return Ticker vencido o NULL
+     */
+    template<typename T>
+    static inline T* expired(T** heap, int size, uint64_t now){
+    	return (size > 0 && heap[0]->next_event <= now)? heap[0] : NULL;
+    }
+
+
+    /** Contabiliza el retraso de un ticker que acaba de vencer, medido desde el final de su ventana
+     *  @param tdata Ticker que ha vencido
+     *  @param now Contador actual
+     *  @param tolerance Retraso a partir del cual el disparo se contabiliza como tardío
+     */
+    template<typename T>
+    static inline void measureLateness(T* tdata, uint64_t now, uint64_t tolerance){
+    	uint64_t lateness = (now > deadline(tdata))? (now - deadline(tdata)) : 0;
+    	if(lateness > tolerance){
+    		tdata->late_fires++;
+    	}
+    	if(lateness > tdata->max_lateness){
+    		tdata->max_lateness = (lateness > UINT32_MAX)? UINT32_MAX : (uint32_t)lateness;
+    	}
+    }
+
+
+    /** Calcula el siguiente evento de un ticker periódico que acaba de vencer, según su política de retraso
+     *  @param tdata Ticker que ha vencido
+     *  @param now Contador actual
+     *  @param tolerance Retraso a partir del cual el disparo se contabiliza como tardío
+     */
+    template<typename T>
+    static inline void reschedule(T* tdata, uint64_t now, uint64_t tolerance){
+    	measureLateness(tdata, now, tolerance);
+    	// se programa desde el evento anterior para no acumular deriva
+    	tdata->next_event += tdata->timeout;
+    	// un evento que vence justo ahora está en hora: se dispara sin aplicar la política
+    	if(tdata->next_event >= now){
+    		return;
+    	}
+    	// se ha perdido al menos un periodo completo
+    	switch(tdata->overrun){
+    		case OverrunCatchUp:{
+    			break;
+    		}
+    		case OverrunFireOnce:{
+    			tdata->next_event = now + tdata->timeout;
+    			break;
+    		}
+    		case OverrunSkip:
+    		default:{
+    			uint64_t missed = ((now - tdata->next_event) / tdata->timeout) + 1;
+    			tdata->next_event += (missed * tdata->timeout);
+    			tdata->skipped += (uint32_t)missed;
+    			break;
+    		}
+    	}
+    }
+
+
+    /** Consume el ticker vencido de la raíz de la cola: los de un disparo se retiran sin reprogramarse y los
+     *  periódicos se reprograman y recolocan. Coste O(log n)
+     *  @param heap Cola
+     *  @param size Elementos en la cola
+     *  @param now Contador actual
+     *  @param tolerance Retraso a partir del cual el disparo se contabiliza como tardío
+     *  @return Ticker consumido
+     */
+    template<typename T>
+    static inline T* consume(T** heap, int* size, uint64_t now, uint64_t tolerance){
+    	T* tdata = heap[0];
+    	if(tdata->oneshot){
+    		measureLateness(tdata, now, tolerance);
+    		heapRemove(heap, size, 0);
+    	}
+    	else{
+    		reschedule(tdata, now, tolerance);
+    		heapSiftDown(heap, *size, 0);
+    	}
+    	return tdata;
+    }
+
+
+    /** Calcula el valor de alarma de un timer: el final de la ventana del ticker más prioritario, trasladado a su
+     *  contador. No se programan alarmas en el pasado, ya que no llegarían a dispararse
+     *  @param heap Cola
+     *  @param size Elementos en la cola
+     *  @param counter Contador actual del timer
+     *  @param offset Diferencia entre el contador del timer y la base de tiempos de los tickers
+     *  @param min_ticks Margen mínimo respecto del contador actual
+     *  @return Valor de alarma o NoAlarm si la cola está vacía
+     */
+    template<typename T>
+    static inline uint64_t nextAlarm(T* const* heap, int size, uint64_t counter, uint64_t offset, uint64_t min_ticks){
+    	if(size == 0){
+    		return NoAlarm;
+    	}
+    	uint64_t alarm = deadline(heap[0]) + offset;
+    	uint64_t earliest = counter + min_ticks;
+    	return (alarm < earliest)? earliest : alarm;
+    }
+
+
+    /** Atiende la interrupción de alarma de un timer: procesa los tickers vencidos en orden de final de ventana
+     *  hasta encontrar el primero que aún no ha vencido. Cada uno se reprograma en la cola (O(log n)) antes de su
+     *  disparo; los de un disparo se retiran sin reprogramarse. El número de iteraciones se limita a los tickers
+     *  instalados al entrar, para acotar el tiempo en la interrupción. No carga la siguiente alarma.
+     *  Las operaciones dependientes de la plataforma las aporta el llamante en 'ops':
+     *  	void lock(), unlock()					Protección de la cola
+     *  	uint64_t now()							Instante actual en la base de tiempos de los tickers
+     *  	void expire(T*, uint64_t now)			Ticker vencido, antes de reprogramarlo (ej: estadísticas)
+     *  	void retire(T*)							Ticker de un disparo retirado de la cola
+     *  	bool defer(T*, uint64_t now)			Difiere el disparo a otro contexto. true si lo ha diferido
+     *  	void fire(T*)							Dispara el ticker. Se invoca con la cola protegida y debe
+     *  											liberarla antes de ejecutar la callback
+     *  Todas salvo fire() se invocan con la cola protegida
+     *  @param heap Cola
+     *  @param size Elementos en la cola, se actualiza
+     *  @param tolerance Retraso a partir del cual un disparo se contabiliza como tardío
+     *  @param ops Operaciones de la plataforma
+     */
+    template<typename T, typename Ops>
+    static inline void service(T** heap, int* size, uint64_t tolerance, Ops& ops){
+    	for(int pending = *size; pending > 0; pending--){
+    		ops.lock();
+    		uint64_t now = ops.now();
+    		T* tdata = expired(heap, *size, now);
+    		if(!tdata){
+    			ops.unlock();
+    			break;
+    		}
+    		ops.expire(tdata, now);
+    		consume(heap, size, now, tolerance);
+    		if(tdata->oneshot){
+    			ops.retire(tdata);
+    		}
+    		if(ops.defer(tdata, now)){
+    			ops.unlock();
+    			continue;
+    		}
+    		ops.fire(tdata);
+    	}
+    }
+};
+
+
+#endif
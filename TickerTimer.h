@@ -0,0 +1,74 @@
+/*
+ * TickerTimer.h
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ *	Acceso a los registros de un timer hardware del ESP32, parametrizado por grupo e índice en tiempo de
+ *	compilación. Cada operación se reduce a accesos directos a registros, sin selección del grupo ni del timer en
+ *	tiempo de ejecución, por lo que es apta para rutinas de interrupción en IRAM.
+ *
+ */
+
+#ifndef TICKER_TIMER_H
+#define TICKER_TIMER_H
+
+#include "mbed_api.h"
+
+
+/** Backend hardware de Ticker_HAL: un timer del grupo 'Group' con índice 'Idx'
+ */
+template<timer_group_t Group, timer_idx_t Idx>
+struct TickerTimer {
+	static_assert(Group == TIMER_GROUP_0 || Group == TIMER_GROUP_1, "Grupo de timers no válido");
+	static_assert(Idx == TIMER_0 || Idx == TIMER_1, "Timer no válido");
+
+	/** Obtiene los registros del grupo
+	 *  @return Registros del grupo de timers
+	 */
+	static inline timg_dev_t* dev() {
+		return (Group == TIMER_GROUP_0)? &TIMERG0 : &TIMERG1;
+	}
+
+
+	/** Lee el contador. Si otro core vuelve a capturarlo entre la lectura de ambas mitades y la parte baja
+	 *  desborda, se repite la lectura
+	 *  @return Contador actual
+	 */
+	static inline uint64_t counter() {
+		uint32_t hi, lo;
+		do{
+			dev()->hw_timer[Idx].update = 1;
+			hi = dev()->hw_timer[Idx].cnt_high;
+			lo = dev()->hw_timer[Idx].cnt_low;
+		}while(hi != dev()->hw_timer[Idx].cnt_high);
+		return (((uint64_t)hi) << 32) | lo;
+	}
+
+
+	/** Carga y habilita la alarma
+	 *  @param alarm Valor del contador en el que se dispara
+	 */
+	static inline void setAlarm(uint64_t alarm) {
+		dev()->hw_timer[Idx].alarm_high = (uint32_t)(alarm >> 32);
+		dev()->hw_timer[Idx].alarm_low = (uint32_t)alarm;
+		dev()->hw_timer[Idx].config.alarm_en = TIMER_ALARM_EN;
+	}
+
+
+	/** Borra la interrupción del timer si está activa
+	 */
+	static inline void clearIntr() {
+		if(dev()->int_st_timers.val & BIT(Idx)){
+			if(Idx == TIMER_0){
+				dev()->int_clr_timers.t0 = 1;
+			}
+			else{
+				dev()->int_clr_timers.t1 = 1;
+			}
+		}
+	}
+};
+
+
+#endif
@@ -0,0 +1,228 @@
+/*
+ * TickerVirtual.h
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ *	Backend simulado de Ticker_HAL para ejecución en host (Linux). Sustituye los registros del timer por un reloj
+ *	virtual que avanza de forma determinista bajo control de la aplicación, y ejecuta la misma rutina de servicio
+ *	de interrupción que Ticker_HAL (TickerCore::service). Sólo difieren las operaciones de la plataforma: en el
+ *	host no hay spinlocks, histogramas ni despacho diferido al thread de servicio. Permite probar y medir en el
+ *	host la planificación, el orden de disparo, la deriva y la escalabilidad de la cola de tickers.
+ *
+ */
+
+#ifndef TICKER_VIRTUAL_H
+#define TICKER_VIRTUAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "TickerCore.h"
+
+
+/** Timer virtual con la misma interfaz que TickerTimer (counter, setAlarm, clearIntr). El contador sólo avanza
+ *  mediante set()
+ *  @tparam Id Identificador del timer, para disponer de varios independientes
+ */
+template<int Id>
+struct TickerVirtualTimer {
+
+	/** Lee el contador
+	 *  @return Contador actual
+	 */
+	static inline uint64_t counter() { return _counter; }
+
+
+	/** Carga y habilita la alarma
+	 *  @param alarm Valor del contador en el que se dispara
+	 */
+	static inline void setAlarm(uint64_t alarm) { _alarm = alarm; }
+
+
+	/** Sin efecto: la interrupción virtual no necesita borrarse
+	 */
+	static inline void clearIntr() { }
+
+
+	/** Obtiene la alarma programada
+	 *  @return Valor de alarma (TickerCore::NoAlarm si no hay ninguna)
+	 */
+	static inline uint64_t alarm() { return _alarm; }
+
+
+	/** Fija el contador y la alarma
+	 *  @param counter Nuevo valor del contador
+	 *  @param alarm Nuevo valor de alarma (por defecto, ninguna)
+	 */
+	static inline void reset(uint64_t counter = 0, uint64_t alarm = TickerCore::NoAlarm) {
+		_counter = counter;
+		_alarm = alarm;
+	}
+
+
+	/** Fija el contador. El reloj no retrocede
+	 *  @param counter Nuevo valor del contador
+	 */
+	static inline void set(uint64_t counter) {
+		if(counter > _counter){
+			_counter = counter;
+		}
+	}
+
+	static uint64_t _counter;		/// Contador virtual
+	static uint64_t _alarm;			/// Alarma programada
+};
+
+template<int Id> uint64_t TickerVirtualTimer<Id>::_counter = 0;
+template<int Id> uint64_t TickerVirtualTimer<Id>::_alarm = TickerCore::NoAlarm;
+
+
+/** Planificador de tickers sobre un timer virtual. Equivale a un timer de alarmas de Ticker_HAL: mantiene su cola
+ *  de prioridad y, al alcanzar el reloj virtual cada alarma, ejecuta la misma secuencia que tickerISR
+ *
+ * @code
+ * struct Node { uint64_t next_event, timeout, slack; int32_t heap_idx; bool oneshot;
+ *               TickerCore::OverrunPolicy overrun; uint32_t late_fires, max_lateness, skipped; };
+ * void onFire(Node* n){ ... }
+ * TickerVirtual<Node, 1024> sched(&onFire);
+ * sched.attach(&node);
+ * sched.advance(1000000);		// dispara en orden todo lo que vence en 1M ticks
+ * @endcode
+ *
+ * @tparam T Tipo de ticker (ver campos requeridos en TickerCore.h)
+ * @tparam Capacity Número máximo de tickers instalados
+ * @tparam Timer Timer virtual
+ */
+template<typename T, int Capacity, typename Timer = TickerVirtualTimer<0> >
+class TickerVirtual : public TickerCore {
+public:
+
+	/** Constructor. Reinicia el timer virtual
+	 *  @param fire Función invocada en cada disparo (en el lugar de la callback del ticker)
+	 *  @param tolerance Retraso (en ticks) a partir del cual un disparo se contabiliza como tardío
+	 *  @param min_alarm Margen mínimo (en ticks) con el que se programa una alarma
+	 */
+	TickerVirtual(void (*fire)(T*), uint64_t tolerance = 0, uint64_t min_alarm = 0) :
+			_fire(fire), _tolerance(tolerance), _min_alarm(min_alarm), _size(0), _isr_count(0), _fire_count(0) {
+		Timer::reset();
+	}
+
+
+	/** Instala un ticker o, si ya lo estaba, lo recoloca con su nuevo 'next_event'
+	 *  @param tdata Ticker
+	 *  @return false si se ha alcanzado la capacidad máxima
+	 */
+	bool attach(T* tdata) {
+		if(heapContains(_heap, _size, tdata)){
+			heapUpdate(_heap, _size, tdata->heap_idx);
+		}
+		else if(_size < Capacity){
+			heapInsert(_heap, &_size, tdata);
+		}
+		else{
+			return false;
+		}
+		executeNext();
+		return true;
+	}
+
+
+	/** Desinstala un ticker
+	 *  @param tdata Ticker
+	 */
+	void detach(T* tdata) {
+		if(heapContains(_heap, _size, tdata)){
+			heapRemove(_heap, &_size, tdata->heap_idx);
+			executeNext();
+		}
+		tdata->heap_idx = -1;
+	}
+
+
+	/** Avanza el reloj virtual. El reloj se detiene en cada alarma alcanzada y ejecuta la interrupción, de forma
+	 *  que los disparos se producen en orden y en el instante exacto de su alarma
+	 *  @param ticks Ticks a avanzar
+	 *  @return Interrupciones ejecutadas
+	 */
+	uint32_t advance(uint64_t ticks) {
+		uint64_t target = Timer::counter() + ticks;
+		uint32_t count = 0;
+		while(Timer::alarm() <= target){
+			Timer::set(Timer::alarm());
+			isr();
+			count++;
+		}
+		Timer::set(target);
+		return count;
+	}
+
+
+	/** Obtiene el contador virtual
+	 *  @return Contador actual
+	 */
+	uint64_t now() const { return Timer::counter(); }
+
+	/** Obtiene el número de tickers instalados
+	 *  @return Tickers en la cola
+	 */
+	int count() const { return _size; }
+
+	/** Obtiene el número de interrupciones ejecutadas
+	 *  @return Interrupciones
+	 */
+	uint32_t isrCount() const { return _isr_count; }
+
+	/** Obtiene el número de disparos ejecutados
+	 *  @return Disparos
+	 */
+	uint32_t fireCount() const { return _fire_count; }
+
+private:
+	void (*_fire)(T*);				/// Función de disparo
+	uint64_t _tolerance;			/// Retraso tolerado
+	uint64_t _min_alarm;			/// Margen mínimo de alarma
+	T* _heap[Capacity];				/// Cola de prioridad
+	int _size;						/// Tickers en la cola
+	uint32_t _isr_count;			/// Interrupciones ejecutadas
+	uint32_t _fire_count;			/// Disparos ejecutados
+
+	/** Carga la alarma del ticker más prioritario
+	 */
+	void executeNext() {
+		Timer::setAlarm(nextAlarm(_heap, _size, Timer::counter(), 0, _min_alarm));
+	}
+
+
+	/** Rutina de interrupción virtual. Ejecuta el mismo núcleo que Ticker_HAL::tickerISR (TickerCore::service)
+	 *  y carga la siguiente alarma. La función de disparo puede avanzar el reloj (simulando su duración) e
+	 *  instalar o desinstalar tickers
+	 */
+	void isr() {
+		Timer::clearIntr();
+		Ops ops = { this };
+		service(_heap, &_size, _tolerance, ops);
+		executeNext();
+		_isr_count++;
+	}
+
+
+	/** Operaciones de la plataforma para TickerCore::service. En el host no hay concurrencia ni asignación a
+	 *  timers, y todos los disparos se ejecutan en la interrupción (sin despacho diferido)
+	 */
+	struct Ops {
+		TickerVirtual* owner;
+		void lock() {}
+		void unlock() {}
+		uint64_t now() { return Timer::counter(); }
+		void expire(T*, uint64_t) {}
+		void retire(T*) {}
+		bool defer(T*, uint64_t) { return false; }
+		void fire(T* tdata) {
+			owner->_fire_count++;
+			owner->_fire(tdata);
+		}
+	};
+};
+
+
+#endif
@@ -7,14 +7,23 @@
  */
 
 #include "Ticker_HAL.h"
+#include <xtensa/hal.h>
 
 //------------------------------------------------------------------------------------
 //---- TYPES -------------------------------------------------------------------------
 //------------------------------------------------------------------------------------
 
-List<Ticker_HAL::TickerData_t> *Ticker_HAL::_ticker_list = NULL;
-Ticker_HAL::TickerData_t* Ticker_HAL::_curr_ticker = NULL;
+Ticker_HAL::Shard_t Ticker_HAL::_shards[Ticker_HAL::NumShards];
+volatile bool Ticker_HAL::_started = false;
+portMUX_TYPE Ticker_HAL::_ring_mux;
 uint64_t Ticker_HAL::_offset = 0;
+Ticker_HAL::TickerData_t** Ticker_HAL::_ring = NULL;
+int Ticker_HAL::_ring_head = 0;
+int Ticker_HAL::_ring_tail = 0;
+Ticker_HAL::DispatchStats_t Ticker_HAL::_dispatch_stats = {0, 0, 0, 0};
+Thread* Ticker_HAL::_service = NULL;
+Notifier* Ticker_HAL::_service_ntf = NULL;
+Ticker_HAL::TickerData_t* Ticker_HAL::_dispatching = NULL;
 
 
 
@@ -23,20 +32,50 @@ uint64_t Ticker_HAL::_offset = 0;
 //------------------------------------------------------------------------------------
 
 
-static const Ticker_HAL::TickerData_t no_more_tickdata={0, NULL, 0, 0};
+//------------------------------------------------------------------------------------
+/** Invoca una callback o una referencia a función
+ *  @return Duración de la llamada en ciclos de CPU (0 sin MBED_TICKER_HISTOGRAMS)
+ */
+template<typename F>
+static inline uint32_t invoke(const F& func){
+#if MBED_TICKER_HISTOGRAMS
+	uint32_t cycles = xthal_get_ccount();
+	func.call();
+	return xthal_get_ccount() - cycles;
+#else
+	func.call();
+	return 0;
+#endif
+}
 
 
 //------------------------------------------------------------------------------------
-void tickerAlarmISR(void *para){
+template<int N>
+static void IRAM_ATTR tickerAlarmISR(void *para){
 	ENTER_ISR();
-	timer_idx_t timerIdx = (timer_idx_t)(int)para;
-	if(timerIdx == Ticker_HAL::TimerIdx){
-		Ticker_HAL::tickerISR();
-	}
+	Ticker_HAL::tickerISR<N>();
 	EXIT_ISR();
 }
 
 
+//------------------------------------------------------------------------------------
+template<>
+void Ticker_HAL::bindShards<0>(){
+}
+
+
+//------------------------------------------------------------------------------------
+template<int N>
+void Ticker_HAL::bindShards(){
+	bindShards<N - 1>();
+	Shard_t* sh = &_shards[N - 1];
+	sh->idx = (timer_idx_t)(TimerIdx + N - 1);
+	sh->counter = &ShardTimer<N - 1>::counter;
+	sh->setAlarm = &ShardTimer<N - 1>::setAlarm;
+	sh->isr = &tickerAlarmISR<N - 1>;
+}
+
+
 //------------------------------------------------------------------------------------
 //---- PUBLIC ------------------------------------------------------------------------
 //------------------------------------------------------------------------------------
@@ -47,22 +86,32 @@ void Ticker_HAL::start(){
 
 	esp_err_t err = ESP_OK;
 
-	// si el timer a�n no se ha iniciado...
-	if(!_ticker_list){
+	// si el timer aún no se ha iniciado...
+	if(!_started){
 
 		MBED_ASSERT(!IS_ISR());
+		_started = true;
+		vPortCPUInitializeMutex(&_ring_mux);
+		bindShards<NumShards>();
+		for(int i = 0; i < NumShards; i++){
+			_shards[i].heap = NULL;
+			_shards[i].heap_size = 0;
+			_shards[i].setup = 0;
+			_shards[i].firing = NULL;
+			_shards[i].isr_stats = {0, 0, 0, 0};
+			_shards[i].offset = 0;
+#if MBED_TICKER_HISTOGRAMS
+			memset(&_shards[i].hist, 0, sizeof(HistSnapshot_t));
+#endif
+			vPortCPUInitializeMutex(&_shards[i].mux);
+		}
 
-		// crea lista de Tickers registrados
-		_ticker_list = new List<Ticker_HAL::TickerData_t>();
-		// de momento no hay ninguno cargado
-		_curr_ticker = NULL;
-
-		// Inicia el contador
+		// Inicia el contador de la base de tiempos común
 		timer_config_t config;
 		config.divider = TimerDivider;
 		config.counter_dir = TIMER_COUNT_UP;
 		config.counter_en = TIMER_PAUSE;
-		config.alarm_en = TIMER_ALARM_EN;
+		config.alarm_en = TIMER_ALARM_DIS;
 		config.intr_type = TIMER_INTR_LEVEL;
 		config.auto_reload = TIMER_AUTORELOAD_DIS;
 		err = timer_init(TimerGroup, TimerIdx, &config);
@@ -70,218 +119,386 @@ void Ticker_HAL::start(){
 		// Carga el valor inicial
 		err = timer_set_counter_value(TimerGroup, TimerIdx, 0x00000000ULL);
 		MBED_ASSERT(err == ESP_OK);
-		// Carga el valor de comparaci�n
-		err = timer_set_alarm_value(TimerGroup, TimerIdx, UINT64_MAX);
-		timer_set_alarm(TimerGroup, TimerIdx, TIMER_ALARM_EN);
-		MBED_ASSERT(err == ESP_OK);
-		// Habilita interrupci�n
-		err = timer_enable_intr(TimerGroup, TimerIdx);
-		// Registra manejador de interrupci�n
-		MBED_ASSERT(err == ESP_OK);
-		err = timer_isr_register(TimerGroup, TimerIdx, tickerAlarmISR, (void*)TimerIdx, 0, NULL);
 		// Arranca el timer
 		err = timer_start(TimerGroup, TimerIdx);
 		MBED_ASSERT(err == ESP_OK);
-
-		// Arranca el hilo de ejecuci�n propio
 		_offset = 0;
+
+		// Inicia el timer de alarmas del core actual. El resto se inician con el primer ticker que los requiere
+		bool started = initShard(xPortGetCoreID());
+		MBED_ASSERT(started);
 	}
 }
 
 //------------------------------------------------------------------------------------
-void Ticker_HAL::tickerISR(){
-
-	/* Obtiene el estado de la alarma y el valor del contador */
-	uint32_t intr_status;
-	switch(TimerGroup){
-		case TIMER_GROUP_0:{
-			intr_status = TIMERG0.int_st_timers.val;
-			TIMERG0.hw_timer[TimerIdx].update = 1;
-			uint64_t timer_counter_value = ((uint64_t) TIMERG0.hw_timer[TimerIdx].cnt_high) << 32 | TIMERG0.hw_timer[TimerIdx].cnt_low;
+template<int N>
+struct Ticker_HAL::IsrOps {
+	typedef ShardTimer<N> Hw;
+	Shard_t* sh;
+	bool notify;
+
+	void lock() { portENTER_CRITICAL_ISR(&sh->mux); }
+
+	void unlock() { portEXIT_CRITICAL_ISR(&sh->mux); }
+
+	uint64_t now() { return Hw::counter() - sh->offset; }
+
+	void expire(TickerData_t* tickdata, uint64_t now){
+#if MBED_TICKER_HISTOGRAMS
+		uint64_t late = now - tickdata->next_event;
+		uint32_t late_cycles = (late < (UINT32_MAX / CyclesPerTick))? (uint32_t)(late * CyclesPerTick) : UINT32_MAX;
+		histRecord(&tickdata->hist.lateness, late_cycles);
+		histRecord(&sh->hist.lateness, late_cycles);
+#else
+		(void)tickdata;
+		(void)now;
+#endif
+	}
 
-			/* Clear the interrupt and update the alarm time */
-			if ((intr_status & BIT(TimerIdx)) && TimerIdx == TIMER_0) {
-				TIMERG0.int_clr_timers.t0 = 1;
-			}
-			else if ((intr_status & BIT(TimerIdx)) && TimerIdx == TIMER_1) {
-				TIMERG0.int_clr_timers.t1 = 1;
-			}
+	// los tickers de un disparo quedan sin timer asignado
+	void retire(TickerData_t* tickdata) { tickdata->shard = -1; }
 
-			// en caso de que no haya asignado ning�n ticker, lo pausa y lo pone a 0 y marca una alarma en el infinito
-			// por �ltimo lo inicia
-			if(!_curr_ticker){
-				_curr_ticker = (TickerData_t*)&no_more_tickdata;
-				// lo pausa
-				TIMERG0.hw_timer[TimerIdx].config.enable = 0;
-				// establece cuenta a 0
-				TIMERG0.hw_timer[TimerIdx].load_high = (uint32_t)0;
-				TIMERG0.hw_timer[TimerIdx].load_low = (uint32_t)0;
-				TIMERG0.hw_timer[TimerIdx].reload = 1;
-				// set alarm_value
-				TIMERG0.hw_timer[TimerIdx].alarm_high = (uint32_t) 0xFFFFFFF;
-				TIMERG0.hw_timer[TimerIdx].alarm_low = (uint32_t) 0xFFFFFFF;
-			}
-			// si no hay m�s tickers, marca alarma en infinito
-			else if(_curr_ticker == (TickerData_t*)&no_more_tickdata){
-				_curr_ticker = (TickerData_t*)&no_more_tickdata;
-				// set alarm_value
-				TIMERG0.hw_timer[TimerIdx].alarm_high = (uint32_t) 0xFFFFFFF;
-				TIMERG0.hw_timer[TimerIdx].alarm_low = (uint32_t) 0xFFFFFFF;
-			}
-			// en otro caso, procesa evento de ticker a nivel de ISR
-			else{
-				// Se lanza el elemento en curso (primer item)
-				TickerData_t* tickdata = _ticker_list->getFirstItem();
-				if(tickdata){
-					// Se reinserta el ticker activo
-					tickdata->next_event = Ticker_HAL::getRawCounter() + tickdata->timeout;
-					// se arranca el nuevo ticker
-					executeNext();
-					// se invoca a la callback
-					tickdata->func.call();
-				}
-			}
-			// set alarm
-			TIMERG0.hw_timer[TimerIdx].config.alarm_en = TIMER_ALARM_EN;
-			// arranca de nuevo
-			TIMERG0.hw_timer[TimerIdx].config.enable = 1;
+	// en modo diferido la ISR únicamente encola el evento para el thread de servicio
+	bool defer(TickerData_t* tickdata, uint64_t now){
+		if(tickdata->dispatch != DispatchThread){
+			return false;
+		}
+		notify |= dispatch(tickdata, now);
+		return true;
+	}
 
-			return;
+	void fire(TickerData_t* tickdata){
+		// se invoca a la callback, o directamente a la referencia si la hay (sin copiar la Callback)
+		uint32_t cb_cycles;
+		sh->firing = tickdata;
+		FunctionRef<void()> ref = tickdata->ref;
+		if(ref){
+			unlock();
+			cb_cycles = invoke(ref);
+		}
+		else{
+			Callback<void()> func = tickdata->func;
+			unlock();
+			cb_cycles = invoke(func);
+		}
+		// la callback puede haber desinstalado y destruido su ticker, o haberlo hecho otro core mientras tanto:
+		// sólo se accede a él si ningún detach ha anulado 'firing'
+#if MBED_TICKER_HISTOGRAMS
+		lock();
+		if(sh->firing == tickdata){
+			histRecord(&tickdata->hist.callback, cb_cycles);
 		}
+		histRecord(&sh->hist.callback, cb_cycles);
+		sh->firing = NULL;
+		unlock();
+#else
+		(void)cb_cycles;
+		sh->firing = NULL;
+#endif
+	}
+};
 
-		case TIMER_GROUP_1:{
-			intr_status = TIMERG1.int_st_timers.val;
-			TIMERG1.hw_timer[TimerIdx].update = 1;
-			uint64_t timer_counter_value = ((uint64_t) TIMERG1.hw_timer[TimerIdx].cnt_high) << 32 | TIMERG1.hw_timer[TimerIdx].cnt_low;
 
-			/* Clear the interrupt and update the alarm time */
-			if ((intr_status & BIT(TimerIdx)) && TimerIdx == TIMER_0) {
-				TIMERG1.int_clr_timers.t0 = 1;
-			}
-			else if ((intr_status & BIT(TimerIdx)) && TimerIdx == TIMER_1) {
-				TIMERG1.int_clr_timers.t1 = 1;
-			}
+//------------------------------------------------------------------------------------
+template<int N>
+void IRAM_ATTR Ticker_HAL::tickerISR(){
+	typedef ShardTimer<N> Hw;
+	uint32_t cycles = xthal_get_ccount();
+	Shard_t* sh = &_shards[N];
+
+	/* Clear the interrupt */
+	Hw::clearIntr();
+
+	// procesa los tickers vencidos con el núcleo común. Las callbacks se ejecutan fuera del spinlock para que
+	// puedan instalar o desinstalar tickers
+	IsrOps<N> ops = { sh, false };
+	service(sh->heap, &sh->heap_size, LateToleranceTicks, ops);
+	bool notify = ops.notify;
+
+	if(notify && _service_ntf){
+		_service_ntf->give_from_isr(NULL);
+	}
 
-			// en caso de que no haya asignado ning�n ticker, lo pausa y lo pone a 0 dejando las interrupciones desactivadas
-			if(!_curr_ticker){
-				_curr_ticker = (TickerData_t*)&no_more_tickdata;
-				// lo pausa
-				TIMERG1.hw_timer[TimerIdx].config.enable = 0;
-				// establece cuenta a 0
-				TIMERG1.hw_timer[TimerIdx].load_high = (uint32_t)0;
-				TIMERG1.hw_timer[TimerIdx].load_low = (uint32_t)0;
-				TIMERG1.hw_timer[TimerIdx].reload = 1;
-				// set alarm_value
-				TIMERG1.hw_timer[TimerIdx].alarm_high = (uint32_t) 0xFFFFFFF;
-				TIMERG1.hw_timer[TimerIdx].alarm_low = (uint32_t) 0xFFFFFFF;
-			}
-			// si no hay m�s tickers, marca alarma en infinito
-			else if(_curr_ticker == (TickerData_t*)&no_more_tickdata){
-				_curr_ticker = (TickerData_t*)&no_more_tickdata;
-				// set alarm_value
-				TIMERG1.hw_timer[TimerIdx].alarm_high = (uint32_t) 0xFFFFFFF;
-				TIMERG1.hw_timer[TimerIdx].alarm_low = (uint32_t) 0xFFFFFFF;
-			}
-			// en otro caso, procesa evento de ticker a nivel de ISR
-			else{
-				// Se lanza el elemento en curso (primer item)
-				TickerData_t* tickdata = _ticker_list->getFirstItem();
-				if(tickdata){
-					// Se reinserta el ticker activo
-					tickdata->next_event = Ticker_HAL::getRawCounter() + tickdata->timeout;
-					// se arranca el nuevo ticker
-					executeNext();
-					// se invoca a la callback
-					tickdata->func.call();
-				}
-			}
-			// set alarm
-			TIMERG1.hw_timer[TimerIdx].config.alarm_en = TIMER_ALARM_EN;
-			// arranca de nuevo
-			TIMERG1.hw_timer[TimerIdx].config.enable = 1;
-			return;
-		}
+	// carga la alarma del siguiente ticker
+	portENTER_CRITICAL_ISR(&sh->mux);
+	Hw::setAlarm(nextAlarm(sh->heap, sh->heap_size, Hw::counter(), sh->offset, MinAlarmTicks));
+	cycles = xthal_get_ccount() - cycles;
+	sh->isr_stats.count++;
+	sh->isr_stats.last_cycles = cycles;
+	sh->isr_stats.sum_cycles += cycles;
+	if(cycles > sh->isr_stats.max_cycles){
+		sh->isr_stats.max_cycles = cycles;
 	}
+#if MBED_TICKER_HISTOGRAMS
+	histRecord(&sh->hist.isr, cycles);
+#endif
+	portEXIT_CRITICAL_ISR(&sh->mux);
 }
 
 
 //------------------------------------------------------------------------------------
 uint64_t Ticker_HAL::getRawCounter(){
-	uint64_t now = 0;
-	esp_err_t err = timer_get_counter_value(TimerGroup, TimerIdx, &now);
-	MBED_ASSERT(err == ESP_OK);
-	return now;
+	return now_ticks();
 }
 
 
 //------------------------------------------------------------------------------------
 uint64_t Ticker_HAL::getTimestamp(){
-	uint64_t now = 0;
-	esp_err_t err = timer_get_counter_value(TimerGroup, TimerIdx, &now);
-	MBED_ASSERT(err == ESP_OK);
-	uint64_t mulfactor = 1000000;
-	return (_offset + ((now * mulfactor)/Ticker_HAL::TimerScale));
+	return (_offset + now_us());
 }
 
 
 //------------------------------------------------------------------------------------
-Ticker_HAL::TickerData_t* Ticker_HAL::attach(Ticker_HAL::TickerData_t* tickdata){
-	timg_dev_t* tim;
-	switch(TimerGroup){
-		case TIMER_GROUP_0:{
-			tim = &TIMERG0;
-			break;
+Ticker_HAL::TickerData_t* Ticker_HAL::install(Ticker_HAL::TickerData_t* tickdata, bool rearm){
+	TickerData_t* result = tickdata;
+	// si ya está instalado se mantiene en su timer, si no se selecciona según su afinidad
+	int shard = (tickdata->shard >= 0)? tickdata->shard : selectShard(tickdata->affinity);
+	Shard_t* sh = &_shards[shard];
+	enterCritical(&sh->mux);
+	// el rearme calcula el siguiente evento dentro del spinlock, para que la ISR no lo lea a medias
+	if(rearm){
+		tickdata->next_event = now_ticks() + tickdata->timeout;
+	}
+	// si ya está instalado, únicamente se recoloca con su nuevo timestamp
+	if(tickdata->shard == shard && heapContains(sh->heap, sh->heap_size, tickdata)){
+		heapUpdate(sh->heap, sh->heap_size, tickdata->heap_idx);
+	}
+	else if(sh->heap_size < MaxTickers){
+		tickdata->shard = shard;
+		heapInsert(sh->heap, &sh->heap_size, tickdata);
+	}
+	else{
+		result = NULL;
+	}
+	executeNext(sh);
+	exitCritical(&sh->mux);
+	return result;
+}
+
+
+//------------------------------------------------------------------------------------
+void Ticker_HAL::detach(Ticker_HAL::TickerData_t* tickdata){
+	// descarta sus despachos pendientes en el thread de servicio
+	enterCritical(&_ring_mux);
+	if(tickdata->queued > 0){
+		for(int i = _ring_tail; i != _ring_head; i = (i + 1) % DispatchRingSize){
+			if(_ring[i] == tickdata){
+				_ring[i] = NULL;
+			}
 		}
-		case TIMER_GROUP_1:{
-			tim = &TIMERG1;
-			break;
+		tickdata->queued = 0;
+	}
+	// si su callback diferida está en curso, el thread de servicio ya no debe acceder a él al terminarla
+	if(_dispatching == tickdata){
+		_dispatching = NULL;
+	}
+	exitCritical(&_ring_mux);
+
+	// si la ISR de algún core está ejecutando su callback, ya no debe acceder a él al terminarla. Se comprueban
+	// todos, ya que un ticker de un disparo deja de estar asignado a su core antes de la callback
+	for(int i = 0; i < NumShards; i++){
+		enterCritical(&_shards[i].mux);
+		if(_shards[i].firing == tickdata){
+			_shards[i].firing = NULL;
 		}
+		exitCritical(&_shards[i].mux);
 	}
 
-	// desactiva la alarma
-	if(!IS_ISR()){
-		tim->hw_timer[TimerIdx].config.alarm_en = TIMER_ALARM_DIS;
+	// si no está instalado, no hace falta desinstalarlo
+	int shard = tickdata->shard;
+	if(shard < 0 || shard >= NumShards){
+		tickdata->heap_idx = -1;
+		tickdata->shard = -1;
+		return;
 	}
-	_ticker_list->addItem(tickdata);
-	executeNext();
-	// set alarm
-	if(!IS_ISR()){
-		tim->hw_timer[TimerIdx].config.alarm_en = TIMER_ALARM_EN;
+	Shard_t* sh = &_shards[shard];
+	enterCritical(&sh->mux);
+	if(heapContains(sh->heap, sh->heap_size, tickdata)){
+		heapRemove(sh->heap, &sh->heap_size, tickdata->heap_idx);
+		executeNext(sh);
 	}
-	return tickdata;
+	tickdata->heap_idx = -1;
+	tickdata->shard = -1;
+	exitCritical(&sh->mux);
 }
 
 
 //------------------------------------------------------------------------------------
-void Ticker_HAL::detach(Ticker_HAL::TickerData_t* tickdata){
+int Ticker_HAL::getTickerCount(int shard){
+	if(shard >= 0 && shard < NumShards){
+		return _shards[shard].heap_size;
+	}
+	int count = 0;
+	for(int i = 0; i < NumShards; i++){
+		count += _shards[i].heap_size;
+	}
+	return count;
+}
 
-	// Si es la primera vez que se arranca el ticker, no hace falta desinstalarlo
-	if(tickdata->timeout == 0){
-		return;
+
+//------------------------------------------------------------------------------------
+void Ticker_HAL::getIsrStats(IsrStats_t* stats, int shard){
+	*stats = {0, 0, 0, 0};
+	for(int i = 0; i < NumShards; i++){
+		if(shard >= 0 && shard != i){
+			continue;
+		}
+		Shard_t* sh = &_shards[i];
+		enterCritical(&sh->mux);
+		stats->count += sh->isr_stats.count;
+		stats->sum_cycles += sh->isr_stats.sum_cycles;
+		if(sh->isr_stats.count > 0){
+			stats->last_cycles = sh->isr_stats.last_cycles;
+		}
+		if(sh->isr_stats.max_cycles > stats->max_cycles){
+			stats->max_cycles = sh->isr_stats.max_cycles;
+		}
+		exitCritical(&sh->mux);
+	}
+}
+
+
+//------------------------------------------------------------------------------------
+void Ticker_HAL::resetIsrStats(){
+	for(int i = 0; i < NumShards; i++){
+		enterCritical(&_shards[i].mux);
+		_shards[i].isr_stats = {0, 0, 0, 0};
+		exitCritical(&_shards[i].mux);
+	}
+}
+
+
+//------------------------------------------------------------------------------------
+/** Acumula un histograma sobre otro
+ *  @param dst Destino
+ *  @param src Origen
+ */
+static void histMerge(Ticker_HAL::Histogram_t* dst, const Ticker_HAL::Histogram_t* src){
+	for(int i = 0; i < Ticker_HAL::HistogramBuckets; i++){
+		dst->bucket[i] += src->bucket[i];
 	}
+	dst->count += src->count;
+	if(src->max > dst->max){
+		dst->max = src->max;
+	}
+}
 
-	timg_dev_t* tim;
-	switch(TimerGroup){
-		case TIMER_GROUP_0:{
-			tim = &TIMERG0;
-			break;
+
+//------------------------------------------------------------------------------------
+void Ticker_HAL::getHistograms(HistSnapshot_t* snap, int shard){
+	memset(snap, 0, sizeof(HistSnapshot_t));
+#if MBED_TICKER_HISTOGRAMS
+	for(int i = 0; i < NumShards; i++){
+		if(shard >= 0 && shard != i){
+			continue;
 		}
-		case TIMER_GROUP_1:{
-			tim = &TIMERG1;
-			break;
+		Shard_t* sh = &_shards[i];
+		enterCritical(&sh->mux);
+		histMerge(&snap->lateness, &sh->hist.lateness);
+		histMerge(&snap->callback, &sh->hist.callback);
+		histMerge(&snap->isr, &sh->hist.isr);
+		exitCritical(&sh->mux);
+	}
+#endif
+}
+
+
+//------------------------------------------------------------------------------------
+void Ticker_HAL::getHistograms(const TickerData_t* tickdata, TickerHist_t* snap){
+	memset(snap, 0, sizeof(TickerHist_t));
+#if MBED_TICKER_HISTOGRAMS
+	// el spinlock del timer en el que está instalado garantiza una copia coherente frente a su ISR
+	int shard = tickdata->shard;
+	if(shard < 0 || shard >= NumShards){
+		*snap = tickdata->hist;
+		return;
+	}
+	enterCritical(&_shards[shard].mux);
+	*snap = tickdata->hist;
+	exitCritical(&_shards[shard].mux);
+	// la duración de las callbacks diferidas la registra el thread de servicio con el spinlock del despacho
+	if(tickdata->dispatch == DispatchThread){
+		enterCritical(&_ring_mux);
+		snap->callback = tickdata->hist.callback;
+		exitCritical(&_ring_mux);
+	}
+#endif
+}
+
+
+//------------------------------------------------------------------------------------
+void Ticker_HAL::resetHistograms(TickerData_t* tickdata){
+#if MBED_TICKER_HISTOGRAMS
+	for(int i = 0; i < NumShards; i++){
+		enterCritical(&_shards[i].mux);
+		memset(&_shards[i].hist, 0, sizeof(HistSnapshot_t));
+		if(tickdata && tickdata->shard == i){
+			memset(&tickdata->hist, 0, sizeof(TickerHist_t));
 		}
+		exitCritical(&_shards[i].mux);
 	}
-	// desactiva la alarma
-	if(!IS_ISR()){
-		tim->hw_timer[TimerIdx].config.alarm_en = TIMER_ALARM_DIS;
+	if(tickdata && tickdata->shard < 0){
+		memset(&tickdata->hist, 0, sizeof(TickerHist_t));
 	}
-	_ticker_list->removeItem(tickdata);
-	executeNext();
-	// set alarm
-	if(!IS_ISR()){
-		tim->hw_timer[TimerIdx].config.alarm_en = TIMER_ALARM_EN;
+	if(tickdata && tickdata->dispatch == DispatchThread){
+		enterCritical(&_ring_mux);
+		memset(&tickdata->hist.callback, 0, sizeof(tickdata->hist.callback));
+		exitCritical(&_ring_mux);
 	}
+#endif
+}
+
 
+//------------------------------------------------------------------------------------
+uint32_t Ticker_HAL::histPercentile(const Histogram_t* h, uint32_t percent){
+	if(h->count == 0){
+		return 0;
+	}
+	uint64_t target = (((uint64_t)h->count * percent) + 99) / 100;
+	uint64_t acc = 0;
+	for(int i = 0; i < HistogramBuckets - 1; i++){
+		acc += h->bucket[i];
+		if(acc >= target && acc > 0){
+			uint32_t upper = (1UL << (i + 1)) - 1;
+			return (upper < h->max)? upper : h->max;
+		}
+	}
+	return h->max;
+}
+
+
+//------------------------------------------------------------------------------------
+void Ticker_HAL::getDispatchStats(DispatchStats_t* stats){
+	enterCritical(&_ring_mux);
+	*stats = _dispatch_stats;
+	exitCritical(&_ring_mux);
+}
+
+
+//------------------------------------------------------------------------------------
+void Ticker_HAL::resetDispatchStats(){
+	enterCritical(&_ring_mux);
+	_dispatch_stats = {0, 0, 0, 0};
+	exitCritical(&_ring_mux);
+}
+
+
+//------------------------------------------------------------------------------------
+void Ticker_HAL::startService(){
+	MBED_ASSERT(!IS_ISR());
+	start();
+	if(!_service){
+		_ring = new TickerData_t*[DispatchRingSize];
+		MBED_ASSERT(_ring);
+		_ring_head = 0;
+		_ring_tail = 0;
+		_service = new Thread(ServicePriority, ServiceStackSize, NULL, "ticker_svc");
+		MBED_ASSERT(_service);
+		_service_ntf = new Notifier(_service);
+		MBED_ASSERT(_service_ntf);
+		osStatus err = _service->start(callback(&Ticker_HAL::serviceTask));
+		MBED_ASSERT(err == osOK);
+	}
 }
 
 
@@ -291,41 +508,184 @@ void Ticker_HAL::detach(Ticker_HAL::TickerData_t* tickdata){
 
 
 //------------------------------------------------------------------------------------
-void Ticker_HAL::executeNext(){
-	// busca el m�s prioritario
-	timg_dev_t* tim;
-	switch(TimerGroup){
-		case TIMER_GROUP_0:{
-			tim = &TIMERG0;
-			break;
+void Ticker_HAL::serviceTask(){
+	for(;;){
+		_service_ntf->take();
+		// ejecuta todas las callbacks encoladas desde la última notificación
+		for(;;){
+			portENTER_CRITICAL(&_ring_mux);
+			if(_ring_tail == _ring_head){
+				portEXIT_CRITICAL(&_ring_mux);
+				break;
+			}
+			TickerData_t* tickdata = _ring[_ring_tail];
+			_ring_tail = (_ring_tail + 1) % DispatchRingSize;
+			// descartado por un detach posterior
+			if(!tickdata){
+				portEXIT_CRITICAL(&_ring_mux);
+				continue;
+			}
+			tickdata->queued--;
+			uint32_t latency = (uint32_t)(now_ticks() - tickdata->fired_at);
+			_dispatch_stats.count++;
+			_dispatch_stats.sum_latency += latency;
+			if(latency > _dispatch_stats.max_latency){
+				_dispatch_stats.max_latency = latency;
+			}
+			uint32_t cb_cycles;
+			_dispatching = tickdata;
+			FunctionRef<void()> ref = tickdata->ref;
+			if(ref){
+				portEXIT_CRITICAL(&_ring_mux);
+				cb_cycles = invoke(ref);
+			}
+			else{
+				Callback<void()> func = tickdata->func;
+				portEXIT_CRITICAL(&_ring_mux);
+				cb_cycles = invoke(func);
+			}
+			// la callback puede haber desinstalado y destruido su ticker: sólo se accede a él si ningún detach
+			// ha anulado '_dispatching' mientras tanto. El registro se hace con el spinlock tomado, de forma que
+			// un detach concurrente espera a que termine
+			portENTER_CRITICAL(&_ring_mux);
+#if MBED_TICKER_HISTOGRAMS
+			// sólo el thread de servicio registra la duración de las callbacks diferidas
+			if(_dispatching == tickdata){
+				histRecord(&tickdata->hist.callback, cb_cycles);
+			}
+#else
+			(void)cb_cycles;
+#endif
+			_dispatching = NULL;
+			portEXIT_CRITICAL(&_ring_mux);
 		}
-		case TIMER_GROUP_1:{
-			tim = &TIMERG1;
-			break;
+	}
+}
+
+
+//------------------------------------------------------------------------------------
+bool Ticker_HAL::initShard(int core){
+	Shard_t* sh = &_shards[core];
+	if(__atomic_load_n(&sh->heap, __ATOMIC_ACQUIRE)){
+		return true;
+	}
+	// la ISR se asigna al core que registra la interrupción, por lo que se configura desde ese core
+	if(IS_ISR()){
+		return false;
+	}
+	// antes de arrancar el scheduler sólo hay un llamante y no hay cambios de core
+	bool running = (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING);
+	if(!running && core != xPortGetCoreID()){
+		return false;
+	}
+	// sólo el primer llamante configura el timer: registrar dos veces la ISR o sustituir una cola con tickers
+	// instalados los dejaría sin disparar
+	uint32_t idle = 0;
+	if(!__atomic_compare_exchange_n(&sh->setup, &idle, 1, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)){
+		while(!__atomic_load_n(&sh->heap, __ATOMIC_ACQUIRE)){
+			vTaskDelay(1);
 		}
+		return true;
+	}
+	// con el scheduler en marcha se configura siempre desde la tarea IPC del core, fijada a él, para que un cambio
+	// de core del llamante no registre la ISR en otro
+	if(running){
+		esp_err_t err = esp_ipc_call_blocking(core, setupShard, sh);
+		MBED_ASSERT(err == ESP_OK);
+	}
+	else{
+		setupShard(sh);
 	}
+	return (sh->heap != NULL);
+}
 
-	// busca el pr�ximo elemento
-	TickerData_t *tnext = _ticker_list->getFirstItem();
-	// si no hay m�s elementos
-	if(!tnext){
-		_curr_ticker = (TickerData_t *)&no_more_tickdata;
-		// set alarm_value infinite
-		tim->hw_timer[TimerIdx].alarm_high = (uint32_t) 0xFFFFFFFF;
-		tim->hw_timer[TimerIdx].alarm_low = (uint32_t) 0xFFFFFFFF;
-		return;
+
+//------------------------------------------------------------------------------------
+void Ticker_HAL::setupShard(void* arg){
+	Shard_t* sh = (Shard_t*)arg;
+	esp_err_t err = ESP_OK;
+
+	// los timers distintos de la base de tiempos se sincronizan con ella, registrando la diferencia residual
+	if(sh->idx != TimerIdx){
+		timer_config_t config;
+		config.divider = TimerDivider;
+		config.counter_dir = TIMER_COUNT_UP;
+		config.counter_en = TIMER_PAUSE;
+		config.alarm_en = TIMER_ALARM_DIS;
+		config.intr_type = TIMER_INTR_LEVEL;
+		config.auto_reload = TIMER_AUTORELOAD_DIS;
+		err = timer_init(TimerGroup, sh->idx, &config);
+		MBED_ASSERT(err == ESP_OK);
+		err = timer_set_counter_value(TimerGroup, sh->idx, now_ticks());
+		MBED_ASSERT(err == ESP_OK);
+		err = timer_start(TimerGroup, sh->idx);
+		MBED_ASSERT(err == ESP_OK);
+		sh->offset = sh->counter() - now_ticks();
 	}
-	TickerData_t *tdata = _ticker_list->getNextItem();
-	while(tdata){
-		// chequea si es m�s prioritario
-		if(tdata->next_event < tnext->next_event){
-			tnext = tdata;
+
+	// alarma en el infinito hasta que se instale el primer ticker
+	err = timer_set_alarm_value(TimerGroup, sh->idx, NoAlarm);
+	MBED_ASSERT(err == ESP_OK);
+	err = timer_set_alarm(TimerGroup, sh->idx, TIMER_ALARM_EN);
+	MBED_ASSERT(err == ESP_OK);
+	// Habilita interrupción
+	err = timer_enable_intr(TimerGroup, sh->idx);
+	MBED_ASSERT(err == ESP_OK);
+	// Registra manejador de interrupción en el core actual
+	err = timer_isr_register(TimerGroup, sh->idx, sh->isr, (void*)sh, 0, NULL);
+	MBED_ASSERT(err == ESP_OK);
+
+	// crea la cola de prioridad, de momento vacía. A partir de aquí el timer está disponible
+	TickerData_t** heap = new TickerData_t*[MaxTickers];
+	MBED_ASSERT(heap);
+	sh->heap_size = 0;
+	__atomic_store_n(&sh->heap, heap, __ATOMIC_RELEASE);
+}
+
+
+//------------------------------------------------------------------------------------
+int Ticker_HAL::selectShard(int affinity){
+	int core = (affinity >= 0 && affinity < NumShards)? affinity : xPortGetCoreID();
+	if(initShard(core)){
+		return core;
+	}
+	// si no puede iniciarse desde este contexto, se utiliza cualquiera de los ya iniciados
+	for(int i = 0; i < NumShards; i++){
+		if(_shards[i].heap){
+			return i;
 		}
-		tdata = _ticker_list->getNextItem();
 	}
-	// set alarm_value
-	_curr_ticker = tnext;
-	tim->hw_timer[TimerIdx].alarm_high = (uint32_t) (_curr_ticker->next_event >> 32);
-	tim->hw_timer[TimerIdx].alarm_low = (uint32_t) _curr_ticker->next_event;
+	MBED_ASSERT(false);
+	return 0;
 }
 
+
+//------------------------------------------------------------------------------------
+bool IRAM_ATTR Ticker_HAL::dispatch(TickerData_t* tdata, uint64_t now){
+	bool result = false;
+	portENTER_CRITICAL_ISR(&_ring_mux);
+	// si la callback aún no ha procesado el evento anterior, se agrupa con él
+	int next = (_ring_head + 1) % DispatchRingSize;
+	if(tdata->coalesce && tdata->queued > 0){
+		tdata->overruns++;
+	}
+	else if(next == _ring_tail){
+		tdata->overruns++;
+		_dispatch_stats.dropped++;
+	}
+	else{
+		_ring[_ring_head] = tdata;
+		_ring_head = next;
+		tdata->queued++;
+		tdata->fired_at = now;
+		result = true;
+	}
+	portEXIT_CRITICAL_ISR(&_ring_mux);
+	return result;
+}
+
+
+//------------------------------------------------------------------------------------
+void Ticker_HAL::executeNext(Shard_t* sh){
+	sh->setAlarm(nextAlarm(sh->heap, sh->heap_size, sh->counter(), sh->offset, MinAlarmTicks));
+}
@@ -17,6 +17,19 @@
 #include "Thread.h"
 #include "Queue.h"
 #include "Mutex.h"
+#include "Notifier.h"
+#include "esp_ipc.h"
+#include "TickerTimer.h"
+#include "TickerCore.h"
+
+
+/** Activa (1) los histogramas de latencia y duracin de Ticker_HAL. Desactivados por defecto, ya que aaden 192
+ *  bytes a cada ticker y dos lecturas de CCOUNT por callback. Se activan en la configuracin del componente con
+ *  CPPFLAGS += -DMBED_TICKER_HISTOGRAMS=1
+ */
+#if !defined(MBED_TICKER_HISTOGRAMS)
+#define MBED_TICKER_HISTOGRAMS		0
+#endif
 
 
 /** Base abstraction for timer interrupts
@@ -24,7 +37,7 @@
  * @note Synchronization level: Interrupt safe
  * @ingroup drivers
  */
-class Ticker_HAL {
+class Ticker_HAL : public TickerCore {
 public:
 
 	/** Clave para activar la depuracin en tiempo de compilacin */
@@ -39,16 +52,141 @@ public:
 	/** Grupo del timer utilizado para implementar objetos tipo Ticker */
     static const timer_group_t TimerGroup = TIMER_GROUP_0;
 
-    /** Timer dentro del grupo seleccinado */
+    /** Timer dentro del grupo seleccinado. Es la base de tiempos comn y el timer de alarmas del core 0. El
+     *  core 'n' utiliza el timer (TimerIdx + n) del mismo grupo */
     static const timer_idx_t TimerIdx = TIMER_0;
 
+    /** Nmero de timers hardware de alarmas (uno por core), cada uno con su propia cola y su propia ISR
+     *  atendida en su core */
+    static const int NumShards = portNUM_PROCESSORS;
+    static_assert((TimerIdx + NumShards) <= TIMER_MAX, "No hay timers suficientes en el grupo");
+
+    /** Afinidad por defecto: el ticker se instala en el timer del core que ejecuta el attach */
+    static const int AnyCore = -1;
+
+    /** Nmero mximo de tickers instalados simultneamente en cada timer (capacidad de la cola de prioridad) */
+    static const int MaxTickers = 256;
+
+    /** Margen mnimo (en ticks) con el que se programa una alarma respecto del contador actual */
+    static const uint64_t MinAlarmTicks = 10;
+
+    /** Capacidad del buffer circular de callbacks diferidas al thread de servicio */
+    static const int DispatchRingSize = 64;
+
+    /** Prioridad y tamao de pila del thread de servicio */
+    static const int ServicePriority = (configMAX_PRIORITIES - 2);
+    static const uint32_t ServiceStackSize = OS_STACK_SIZE;
+
+    /** Contexto en el que se ejecuta la callback de un ticker
+     */
+    enum DispatchMode {
+    	DispatchISR = 0,			/// Directamente en la rutina de interrupcin (por defecto)
+    	DispatchThread,				/// Diferida al thread de servicio de alta prioridad
+    };
+
+    /** Factores de conversin de ticks a us y ms en coma fija 0.64 (redondeados por exceso para que los mltiplos
+     *  exactos no pierdan una unidad). Evitan la divisin de 64 bits en cada lectura de tiempo y son exactos para
+     *  contadores de hasta 2^52 ticks (unos 28 aos)
+     */
+    static const uint64_t TicksToUsMult = (UINT64_MAX / (TimerScale / 1000000)) + 1;
+    static const uint64_t TicksToMsMult = (UINT64_MAX / (TimerScale / 1000)) + 1;
+    static_assert((TimerScale % 1000000) == 0, "TimerScale debe ser mltiplo de 1MHz");
+
+    /** Retraso (en ticks) a partir del cual un disparo se contabiliza como tardo */
+    static const uint32_t LateToleranceTicks = (TimerScale / 20000);
+
+    /** Nmero de buckets de los histogramas. El bucket 'i' cuenta los valores en [2^i, 2^(i+1)) ciclos de CPU
+     *  (el 0 incluye el valor 0 y el ltimo, todos los superiores) */
+    static const int HistogramBuckets = 24;
+
+    /** Ciclos de CPU por tick de TimerScale, para expresar los retrasos en la misma unidad que las duraciones */
+    static const uint32_t CyclesPerTick = ((CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ * 1000000) / TimerScale);
+
+	/** Histograma log2 (en ciclos de CPU)
+	 */
+	struct Histogram_t {
+		uint32_t bucket[HistogramBuckets];	/// Valores registrados en cada bucket
+		uint32_t count;				/// Valores registrados
+		uint32_t max;				/// Mximo valor registrado
+	};
+
+	/** Histogramas de un ticker
+	 */
+	struct TickerHist_t {
+		Histogram_t lateness;		/// Retraso de la ISR sobre 'next_event'
+		Histogram_t callback;		/// Duracin de la callback
+	};
+
+	/** Histogramas agregados de todos los tickers
+	 */
+	struct HistSnapshot_t {
+		Histogram_t lateness;		/// Retraso de la ISR sobre 'next_event'
+		Histogram_t callback;		/// Duracin de las callbacks ejecutadas en la ISR
+		Histogram_t isr;			/// Duracin total de cada interrupcin
+	};
+
 	/** Estructura de control de tickers
     */
 	struct TickerData_t {
     	int32_t uuid;				/// Identificador del objeto
 		Callback<void()> func;		/// Callback a invocar en los siguientes eventos
+		FunctionRef<void()> ref;	/// Referencia a invocar en lugar de 'func' (si no est vaca)
 		uint64_t next_event;		/// Timestamp del siguiente evento en el que se ejecuta
 		uint64_t timeout;			/// Temporizacin en us
+		uint64_t slack;				/// Retraso admitido sobre 'next_event' (en ticks) para agrupar disparos
+		int32_t heap_idx;			/// Posicin en la cola de prioridad (-1 si no est instalado)
+		DispatchMode dispatch;		/// Contexto de ejecucin de la callback
+		bool coalesce;				/// En modo DispatchThread, agrupa los eventos que vencen antes de ejecutar la callback
+		volatile uint8_t queued;	/// Eventos pendientes en el buffer de despacho
+		uint64_t fired_at;			/// Contador en el ltimo despacho (para medir la latencia aadida)
+		uint32_t overruns;			/// Eventos agrupados (coalesce) o descartados por buffer lleno
+		OverrunPolicy overrun;		/// Poltica de reprogramacin ante retrasos
+		uint32_t late_fires;		/// Disparos con un retraso superior a LateToleranceTicks sobre el final de su ventana
+		uint32_t max_lateness;		/// Mximo retraso observado sobre el final de su ventana (en ticks)
+		uint32_t skipped;			/// Periodos descartados (OverrunSkip)
+		int8_t affinity;			/// Core cuyo timer se prefiere (AnyCore: el que ejecuta el attach)
+		int8_t shard;				/// Timer en el que est instalado (-1 si no est instalado)
+		bool oneshot;				/// Se desinstala al vencer, antes de invocar a la callback (Timeout)
+#if MBED_TICKER_HISTOGRAMS
+		TickerHist_t hist;			/// Histogramas de retraso y duracin
+#endif
+	};
+
+	/** Estadsticas del despacho diferido en el thread de servicio
+	 */
+	struct DispatchStats_t {
+		uint32_t count;				/// Callbacks ejecutadas en el thread de servicio
+		uint32_t max_latency;		/// Latencia mxima desde la ISR hasta la callback (en ticks)
+		uint64_t sum_latency;		/// Latencia acumulada (para obtener la media)
+		uint32_t dropped;			/// Eventos descartados por buffer lleno
+	};
+
+	/** Estadsticas de duracin de la rutina de interrupcin (en ciclos de CPU)
+	 */
+	struct IsrStats_t {
+		uint32_t count;				/// Nmero de interrupciones atendidas
+		uint32_t last_cycles;		/// Duracin de la ltima
+		uint32_t max_cycles;		/// Duracin mxima
+		uint64_t sum_cycles;		/// Duracin acumulada (para obtener la media)
+	};
+
+	/** Estado de cada timer hardware de alarmas
+	 */
+	struct Shard_t {
+		timer_idx_t idx;			/// Timer dentro del grupo TimerGroup
+		TickerData_t **heap;		/// Cola de prioridad (min-heap por 'next_event + slack'). NULL si no est iniciado
+		int heap_size;				/// Nmero de objetos en la cola
+		volatile uint32_t setup;	/// Distinto de 0 desde que un llamante ha iniciado su configuracin
+		TickerData_t* volatile firing;	/// Ticker cuya callback ejecuta la ISR (detach lo anula)
+		portMUX_TYPE mux;			/// Spinlock de acceso a la cola
+		IsrStats_t isr_stats;		/// Estadsticas de la rutina de interrupcin
+		uint64_t offset;			/// Diferencia entre su contador y la base de tiempos comn
+		uint64_t (*counter)();		/// Lectura de su contador (TickerTimer)
+		void (*setAlarm)(uint64_t);	/// Carga de su alarma (TickerTimer)
+		void (*isr)(void*);			/// Rutina de interrupcin especializada para el timer
+#if MBED_TICKER_HISTOGRAMS
+		HistSnapshot_t hist;		/// Histogramas agregados de sus tickers
+#endif
 	};
 
     /** Inicia la ejecucin del TimerManager
@@ -56,18 +194,71 @@ public:
     static void start();
 
 
+    /** Indica si la base de tiempos est en marcha
+     *  @return true si ya se ha ejecutado start()
+     */
+    static inline bool isStarted() { return _started; }
+
+
     /** Obtiene el valor del contador actual
-     * 	@return Contador actual
+     * 	@return Contador actual (en ticks de TimerScale)
      */
 	static uint64_t getRawCounter();
 
 
-    /** Obtiene el valor del timestamp en milisegundos
-     * 	@return Contador actual
+    /** Obtiene el valor del timestamp en microsegundos, incluyendo el offset de sincronizacin
+     * 	@return Timestamp en us
      */
 	static uint64_t getTimestamp();
 
 
+    /** Lectura rpida del contador, directamente de los registros del timer (sin pasar por el driver)
+     * 	@return Contador actual (en ticks de TimerScale)
+     */
+	static inline uint64_t now_ticks() { return BaseTimer::counter(); }
+
+
+    /** Lectura rpida del tiempo transcurrido desde el arranque (sin offset de sincronizacin)
+     * 	@return Tiempo en us
+     */
+	static inline uint64_t now_us() { return ticksToUs(now_ticks()); }
+
+
+    /** Lectura rpida del tiempo transcurrido desde el arranque (sin offset de sincronizacin)
+     * 	@return Tiempo en ms
+     */
+	static inline uint64_t now_ms() { return ticksToMs(now_ticks()); }
+
+
+    /** Convierte ticks a microsegundos sin divisin de 64 bits
+     * 	@param ticks Ticks de TimerScale
+     * 	@return Microsegundos
+     */
+	static inline uint64_t ticksToUs(uint64_t ticks) { return mulhi64(ticks, TicksToUsMult); }
+
+
+    /** Convierte ticks a milisegundos sin divisin de 64 bits
+     * 	@param ticks Ticks de TimerScale
+     * 	@return Milisegundos
+     */
+	static inline uint64_t ticksToMs(uint64_t ticks) { return mulhi64(ticks, TicksToMsMult); }
+
+
+    /** Obtiene la parte alta (64 bits) del producto de 64x64 bits, con multiplicaciones de 32 bits
+     *  @param a Operando
+     *  @param b Operando
+     *  @return (a * b) >> 64
+     */
+	static inline uint64_t mulhi64(uint64_t a, uint64_t b){
+    	uint64_t a_lo = (uint32_t)a, a_hi = a >> 32;
+    	uint64_t b_lo = (uint32_t)b, b_hi = b >> 32;
+    	uint64_t p1 = a_lo * b_hi;
+    	uint64_t p2 = a_hi * b_lo;
+    	uint64_t mid = ((a_lo * b_lo) >> 32) + (uint32_t)p1 + (uint32_t)p2;
+    	return (a_hi * b_hi) + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+    }
+
+
     /** Aade un offset al timestamp para sincronizar con relojes externos
      * 	@return Contador actual
      */
@@ -80,37 +271,207 @@ public:
 	static uint64_t getTimestampOffset() { return _offset; }
 
 
-    /** Instala un Ticker en la lista de objetos en ejecucin
+    /** Instala un Ticker en la cola de objetos en ejecucin. Si ya estaba instalado, lo reprograma con su
+     *  nuevo 'next_event'. Coste O(log n)
+     *
+     *  Cada ticker puede vencer en cualquier instante de su ventana [next_event, next_event + slack]. La cola se
+     *  ordena por el final de la ventana y la alarma se programa en el del ms prioritario. En esa interrupcin se
+     *  ejecutan, en orden, todos los que ya han alcanzado el inicio de su ventana, de forma que los tickers con
+     *  ventanas solapadas comparten alarma y ISR
      * 	@param tickData Objeto a instalar
-     * 	@return Objeto instalado o NULL en caso de error
+     * 	@return Objeto instalado o NULL si se ha alcanzado la capacidad mxima (MaxTickers)
+     */
+    static inline TickerData_t* attach(TickerData_t* tickdata) { return install(tickdata, false); }
+
+
+    /** Rearma un ticker con su misma callback y temporizacin, a contar desde el instante actual. El siguiente
+     *  evento se calcula con el spinlock del timer tomado, por lo que no requiere un detach previo y puede
+     *  invocarse mientras est instalado (ej: watchdogs que se reinician antes de vencer). Coste O(log n)
+     * 	@param tickData Objeto a rearmar
+     * 	@return Objeto instalado o NULL si se ha alcanzado la capacidad mxima (MaxTickers)
      */
-    static TickerData_t* attach(TickerData_t* tickdata);
+    static inline TickerData_t* rearm(TickerData_t* tickdata) { return install(tickdata, true); }
 
 
-    /** Desinstala un objeto de la lista de ejecucin
+    /** Desinstala un objeto de la cola de ejecucin. Coste O(log n)
      * 	@param tickData Objeto a desinstalar
      */
     static void detach(TickerData_t* tickdata);
 
 
-    /** Rutina de atencin a la interrupcin de alarmas
+    /** Rutina de atencin a la interrupcin de alarmas de un timer. Se especializa para cada timer, de forma que
+     *  el acceso a sus registros se resuelve en tiempo de compilacin. Se ubica en IRAM
+     * 	@tparam N Timer (core) que ha generado la interrupcin
      */
+    template<int N>
     static void tickerISR();
 
+
+    /** Obtiene el nmero de tickers instalados
+     * 	@param shard Timer (core) a consultar o AnyCore para el total
+     * 	@return Tickers en la cola de ejecucin
+     */
+    static int getTickerCount(int shard = AnyCore);
+
+
+    /** Obtiene una copia de las estadsticas de la rutina de interrupcin
+     * 	@param stats Recibe las estadsticas
+     * 	@param shard Timer (core) a consultar o AnyCore para el agregado de todos ellos
+     */
+    static void getIsrStats(IsrStats_t* stats, int shard = AnyCore);
+
+
+    /** Reinicia las estadsticas de la rutina de interrupcin
+     */
+    static void resetIsrStats();
+
+
+    /** Obtiene una copia de los histogramas agregados. Vacos si MBED_TICKER_HISTOGRAMS est desactivado
+     * 	@param snap Recibe los histogramas
+     * 	@param shard Timer (core) a consultar o AnyCore para el agregado de todos ellos
+     */
+    static void getHistograms(HistSnapshot_t* snap, int shard = AnyCore);
+
+
+    /** Obtiene una copia de los histogramas de un ticker. Vacos si MBED_TICKER_HISTOGRAMS est desactivado
+     * 	@param tickdata Ticker
+     * 	@param snap Recibe los histogramas
+     */
+    static void getHistograms(const TickerData_t* tickdata, TickerHist_t* snap);
+
+
+    /** Reinicia los histogramas agregados y, opcionalmente, los de un ticker
+     * 	@param tickdata Ticker cuyos histogramas se reinician o NULL
+     */
+    static void resetHistograms(TickerData_t* tickdata = NULL);
+
+
+    /** Registra un valor en un histograma
+     * 	@param h Histograma
+     * 	@param value Valor en ciclos de CPU
+     */
+    static inline void histRecord(Histogram_t* h, uint32_t value){
+    	int i = (value == 0)? 0 : (31 - __builtin_clz(value));
+    	if(i >= HistogramBuckets){
+    		i = HistogramBuckets - 1;
+    	}
+    	h->bucket[i]++;
+    	h->count++;
+    	if(value > h->max){
+    		h->max = value;
+    	}
+    }
+
+
+    /** Obtiene el percentil de un histograma, como lmite superior del bucket en el que se alcanza
+     * 	@param h Histograma
+     * 	@param percent Percentil (0..100)
+     * 	@return Lmite superior en ciclos de CPU (0 si est vaco)
+     */
+    static uint32_t histPercentile(const Histogram_t* h, uint32_t percent);
+
+
+    /** Obtiene una copia de las estadsticas del despacho diferido
+     * 	@param stats Recibe las estadsticas
+     */
+    static void getDispatchStats(DispatchStats_t* stats);
+
+
+    /** Reinicia las estadsticas del despacho diferido
+     */
+    static void resetDispatchStats();
+
+
+    /** Arranca (si no lo est ya) el thread de servicio que ejecuta las callbacks en modo DispatchThread
+     */
+    static void startService();
+
 protected:
 
-    static List<TickerData_t> *_ticker_list;				/// Lista de objetos instalados
-    static TickerData_t *_curr_ticker;						/// Puntero al objeto actual
+    static Shard_t _shards[NumShards];						/// Timers de alarmas, uno por core
+    static volatile bool _started;							/// Flag de base de tiempos iniciada
+    static portMUX_TYPE _ring_mux;							/// Spinlock de acceso al buffer de despacho
     static uint64_t _offset;								/// Offset aplicado al timestamp
+    static TickerData_t **_ring;							/// Buffer circular de callbacks diferidas
+    static int _ring_head;									/// Posicin de escritura (ISR)
+    static int _ring_tail;									/// Posicin de lectura (thread de servicio)
+    static DispatchStats_t _dispatch_stats;					/// Estadsticas del despacho diferido
+    static Thread* _service;								/// Thread de servicio
+    static Notifier* _service_ntf;							/// Seal de despacho pendiente al thread de servicio
+    static TickerData_t* _dispatching;						/// Ticker cuya callback diferida est en curso (detach lo anula)
+
+    /** Rutina de ejecucin del thread de servicio
+     */
+    static void serviceTask();
+
+
+    /** Inicia (si no lo est ya) el timer de alarmas de un core. Slo el primer llamante lo configura; los
+     *  concurrentes esperan a que termine
+     *  @param core Core
+     *  @return true si est iniciado, false si no puede iniciarse desde el contexto actual (ISR, o un core
+     *  distinto antes de arrancar el scheduler)
+     */
+    static bool initShard(int core);
+
+
+    /** Configura el timer de alarmas y registra su ISR. Se ejecuta en el core al que pertenece, directamente o
+     *  a travs de esp_ipc_call_blocking
+     *  @param arg Timer (Shard_t*)
+     */
+    static void setupShard(void* arg);
+
+
+    /** Selecciona el timer en el que se instalar un ticker, segn su afinidad
+     *  @param affinity Core preferido o AnyCore
+     *  @return ndice del timer
+     */
+    static int selectShard(int affinity);
+
+
+    /** Instala o recoloca un ticker en la cola de su timer
+     *  @param tickdata Objeto a instalar
+     *  @param rearm Si es true, su 'next_event' se recalcula desde el contador actual
+     *  @return Objeto instalado o NULL si se ha alcanzado la capacidad mxima (MaxTickers)
+     */
+    static TickerData_t* install(TickerData_t* tickdata, bool rearm);
+
+
+    /** Encola un ticker en el buffer de despacho. Se invoca con el spinlock del timer tomado
+     *  @param tdata Ticker que ha vencido
+     *  @param now Contador actual
+     *  @return true si se ha encolado y hay que notificar al thread de servicio
+     */
+    static bool dispatch(TickerData_t* tdata, uint64_t now);
+
+
+    /** Timer hardware de la base de tiempos comn */
+    typedef TickerTimer<TimerGroup, TimerIdx> BaseTimer;
+
+    /** Timer hardware de alarmas del core 'N' */
+    template<int N>
+    using ShardTimer = TickerTimer<TimerGroup, (timer_idx_t)(TimerIdx + N)>;
+
+
+    /** Operaciones de la rutina de interrupcin del timer 'N' sobre el ncleo comn (TickerCore::service):
+     *  spinlock del timer, histogramas, despacho diferido e invocacin de callbacks
+     *  @tparam N Timer (core) atendido
+     */
+    template<int N>
+    struct IsrOps;
+
 
-    /** Rutina de ejecucin (Thread) del TimerManager
+    /** Asocia a los timers [0, N) sus accesos a registros y sus rutinas de interrupcin especializadas
+     *  @tparam N Nmero de timers
      */
-    static void task();
+    template<int N>
+    static void bindShards();
 
 
-    /** Obtiene el siguiente ticker a cargar en el timer hardware inicindolo
+    /** Carga en el timer hardware la alarma del ticker ms prioritario (raz de la cola). Se invoca con el
+     *  spinlock del timer tomado
+     *  @param sh Timer
      */
-    static void executeNext();
+    static void executeNext(Shard_t* sh);
 };
 
 
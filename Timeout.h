@@ -18,7 +18,47 @@
 
 #include "Ticker.h"
 
-typedef Ticker Timeout;
+/** A Timeout is used to call a function at a point in the future
+ *
+ * Unlike a Ticker, it fires only once: Ticker_HAL removes it from its queue before invoking the callback, so it is
+ * never rescheduled nor fires again unless it is attached or restarted. restart() re-arms it with the same callback
+ * and interval without a previous detach, which makes restartable (watchdog-style) timeouts cheap.
+ *
+ * @code
+ * Timeout watchdog;
+ * watchdog.attach_us(callback(&onLinkLost), 500000);
+ * ...
+ * // on each received frame
+ * watchdog.restart();
+ * @endcode
+ *
+ * @note Synchronization level: Interrupt safe
+ */
+class Timeout : public Ticker {
+
+public:
+	/** Constructor
+	 * @param uuid Identificador del Timeout (por defecto, uuid = this)
+	 */
+    Timeout(int32_t uuid = -1) : Ticker(uuid) {
+    	_tdata.oneshot = true;
+    }
+
+
+    /** Re-arm the timeout with the callback and interval of the last attach, counting from now. It can be
+     *  called while the timeout is pending or after it has fired, also from interrupt context
+     */
+    void restart() {
+    	MBED_ASSERT(_tdata.timeout > 0);
+    	Ticker_HAL::rearm(&_tdata);
+    }
+
+
+    /** Check if the timeout is pending
+     *  @return true if attached and not yet fired
+     */
+    bool pending() const { return (_tdata.heap_idx >= 0); }
+};
 
 
 #endif
@@ -45,12 +45,17 @@ void Timer::stop() {
 
 
 //------------------------------------------------------------------------------------
-int Timer::read_us() {
+uint64_t Timer::read_high_resolution_us() {
 	if(_stat == Started){
-		_last = Ticker_HAL::getRawCounter();
+		_last = Ticker_HAL::now_ticks();
 	}
-	uint64_t mulfactor = 1000000;
-	return(((_last - _start)* mulfactor)/Ticker_HAL::TimerScale);
+	return Ticker_HAL::ticksToUs(_last - _start);
+}
+
+
+//------------------------------------------------------------------------------------
+int Timer::read_us() {
+	return (int)read_high_resolution_us();
 }
 
 
@@ -68,6 +73,6 @@ int Timer::read_ms() {
 
 //------------------------------------------------------------------------------------
 void Timer::reset() {
-	_start = Ticker_HAL::getRawCounter();
+	_start = Ticker_HAL::now_ticks();
 	_last = _start;
 }
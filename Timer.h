@@ -58,6 +58,12 @@ public:
      */
     int read_us();
 
+    /** Get the time passed in micro-seconds, as a 64-bit value that does not overflow
+     *
+     *  @returns    Time passed in micro seconds
+     */
+    uint64_t read_high_resolution_us();
+
 protected:
 
     uint64_t _last;   	/// Timestamp de ltima lectura
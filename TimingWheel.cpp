@@ -0,0 +1,173 @@
+/*
+ * TimingWheel.cpp
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ */
+
+#include "TimingWheel.h"
+
+
+
+//------------------------------------------------------------------------------------
+//---- STATIC ------------------------------------------------------------------------
+//------------------------------------------------------------------------------------
+
+
+
+//------------------------------------------------------------------------------------
+//-- PUBLIC METHODS IMPLEMENTATION ---------------------------------------------------
+//------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------
+TimingWheel::TimingWheel(Callback<void(Entry*)> handler, uint32_t resolution, uint8_t levels, uint8_t bucket_bits) :
+		_handler(handler), _resolution(resolution), _levels(levels), _bits(bucket_bits), _now(0), _count(0), _ticker(NULL), _timer(NULL) {
+	MBED_ASSERT(_resolution > 0 && _levels > 0 && _bits > 0 && (_levels * _bits) <= 32);
+	vPortCPUInitializeMutex(&_mux);
+	_mask = (1UL << _bits) - 1;
+	_max_ticks = ((_levels * _bits) == 32)? UINT32_MAX : ((1UL << (_levels * _bits)) - 1);
+
+	// crea los buckets como listas circulares vacías
+	uint32_t buckets = ((uint32_t)_levels << _bits);
+	_buckets = new Entry[buckets];
+	MBED_ASSERT(_buckets);
+	for(uint32_t i = 0; i < buckets; i++){
+		_buckets[i].next = &_buckets[i];
+		_buckets[i].prev = &_buckets[i];
+	}
+}
+
+
+//------------------------------------------------------------------------------------
+void TimingWheel::attach(Driver driver) {
+	MBED_ASSERT(!IS_ISR());
+	detach();
+	if(driver == DriverTicker){
+		_ticker = new Ticker();
+		MBED_ASSERT(_ticker);
+		_ticker->attach_us(callback(this, &TimingWheel::tick), _resolution);
+		return;
+	}
+	// el RtosTimer sólo admite periodos múltiplos del tick del sistema
+	MBED_ASSERT((_resolution % (portTICK_PERIOD_MS * 1000)) == 0);
+	_timer = new RtosTimer(callback(this, &TimingWheel::tick), osTimerPeriodic, "wheel");
+	MBED_ASSERT(_timer);
+	_timer->start(_resolution / 1000);
+}
+
+
+//------------------------------------------------------------------------------------
+void TimingWheel::detach() {
+	MBED_ASSERT(!IS_ISR());
+	if(_ticker){
+		_ticker->detach();
+		delete(_ticker);
+		_ticker = NULL;
+	}
+	if(_timer){
+		_timer->stop();
+		delete(_timer);
+		_timer = NULL;
+	}
+}
+
+
+//------------------------------------------------------------------------------------
+void TimingWheel::start(Entry* entry, uint64_t microsec) {
+	uint64_t ticks = (microsec + _resolution - 1) / _resolution;
+	// expira como pronto en el siguiente tick, ya que el bucket actual ya ha sido procesado
+	if(ticks == 0){
+		ticks = 1;
+	}
+	if(ticks > _max_ticks){
+		ticks = _max_ticks;
+	}
+	enterCritical(&_mux);
+	if(entry->next){
+		_unlink(entry);
+	}
+	else{
+		_count++;
+	}
+	entry->expires = _now + (uint32_t)ticks;
+	_insert(entry);
+	exitCritical(&_mux);
+}
+
+
+//------------------------------------------------------------------------------------
+bool TimingWheel::cancel(Entry* entry) {
+	bool result = false;
+	enterCritical(&_mux);
+	if(entry->next){
+		_unlink(entry);
+		_count--;
+		result = true;
+	}
+	exitCritical(&_mux);
+	return result;
+}
+
+
+//------------------------------------------------------------------------------------
+void TimingWheel::tick() {
+	enterCritical(&_mux);
+	_now++;
+
+	// al completar una vuelta de un nivel, se redistribuye el bucket actual del nivel superior
+	for(uint32_t level = 1; level < _levels; level++){
+		uint32_t shift = level * _bits;
+		if((_now & ((1UL << shift) - 1)) != 0){
+			break;
+		}
+		Entry* head = _bucket(level, (_now >> shift) & _mask);
+		while(head->next != head){
+			Entry* entry = head->next;
+			_unlink(entry);
+			_insert(entry);
+		}
+	}
+
+	// expira las entradas del bucket actual del primer nivel. El handler se invoca fuera del spinlock para que
+	// pueda reiniciar o cancelar temporizaciones
+	Entry* head = _bucket(0, _now & _mask);
+	while(head->next != head){
+		Entry* entry = head->next;
+		_unlink(entry);
+		_count--;
+		exitCritical(&_mux);
+		_handler.call(entry);
+		enterCritical(&_mux);
+	}
+	exitCritical(&_mux);
+}
+
+
+//------------------------------------------------------------------------------------
+TimingWheel::~TimingWheel() {
+	detach();
+	delete [] _buckets;
+}
+
+
+//------------------------------------------------------------------------------------
+//-- PRIVATE METHODS IMPLEMENTATION --------------------------------------------------
+//------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------
+void TimingWheel::_insert(Entry* entry) {
+	uint32_t delta = entry->expires - _now;
+	// el nivel es el primero cuyo rango cubre la temporización restante
+	uint32_t level = 0;
+	while(level < (uint32_t)(_levels - 1) && delta >= (1UL << ((level + 1) * _bits))){
+		level++;
+	}
+	Entry* head = _bucket(level, (entry->expires >> (level * _bits)) & _mask);
+	entry->next = head;
+	entry->prev = head->prev;
+	head->prev->next = entry;
+	head->prev = entry;
+}
@@ -0,0 +1,165 @@
+/*
+ * TimingWheel.h
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ *	Rueda de temporización jerárquica (hashed hierarchical timing wheel) para gestionar miles de temporizaciones
+ *	software (ej: timeouts por conexión o por dispositivo) a partir de un único Ticker o RtosTimer.
+ *
+ */
+
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include "mbed_api.h"
+#include "Ticker.h"
+#include "RtosTimer.h"
+
+
+/** The TimingWheel class manages a large number of software timeouts driven by a single periodic source.
+ *
+ * Time advances in ticks of 'resolution' microseconds. The wheel is organized in 'levels' of 2^'bucket_bits' buckets
+ * each, so it covers timeouts up to 2^(levels * bucket_bits) ticks (longer ones are clamped to that range). Starting,
+ * cancelling and expiring a timeout are O(1); entries in upper levels are cascaded down as time advances.
+ *
+ * Timeouts are intrusive Entry objects owned by the caller, usually embedded in the connection or device structure
+ * they belong to. All of them expire through the same handler, which receives the expired Entry.
+ *
+ * @code
+ * struct Connection {
+ *     TimingWheel::Entry timeout;
+ *     ...
+ * };
+ * void onTimeout(TimingWheel::Entry* e){
+ *     Connection* c = (Connection*)((char*)e - offsetof(Connection, timeout));
+ *     ...
+ * }
+ * TimingWheel wheel(callback(&onTimeout), 10000);	// 10ms resolution
+ * wheel.attach();									// driven by an RtosTimer
+ * wheel.start(&conn.timeout, 5000000);				// expires in 5s
+ * @endcode
+ *
+ * @note
+ * Memory considerations: buckets are allocated once on construction. Entries are not copied nor allocated.
+ * Synchronization level: start() and cancel() are interrupt safe.
+ */
+class TimingWheel  {
+public:
+
+	/** Temporización gestionada por la rueda. Debe permanecer en memoria mientras esté activa
+	 */
+	struct Entry {
+		Entry* next;				/// Siguiente en el bucket (NULL si no está activa)
+		Entry* prev;				/// Anterior en el bucket
+		uint32_t expires;			/// Tick de expiración
+		Entry() : next(NULL), prev(NULL), expires(0) {}
+	};
+
+	/** Fuente periódica que hace avanzar la rueda
+	 */
+	enum Driver {
+		DriverRtosTimer,			/// RtosTimer: el handler se ejecuta en el contexto del timer service de FreeRTOS
+		DriverTicker,				/// Ticker: el handler se ejecuta en contexto ISR (resoluciones inferiores al tick)
+	};
+
+    /** Create and Initialize a TimingWheel object
+      @param handler 		callback invoked on each expired entry
+      @param resolution 	tick period in microseconds. (default: 1ms)
+      @param levels 		number of levels of the hierarchy. (default: 4)
+      @param bucket_bits 	log2 of the number of buckets per level. levels * bucket_bits must not exceed 32. (default: 6)
+    */
+    TimingWheel(Callback<void(Entry*)> handler, uint32_t resolution = 1000, uint8_t levels = 4, uint8_t bucket_bits = 6);
+
+    /** Connect the wheel to its periodic source
+      @param driver 	source to be used. DriverRtosTimer requires a resolution multiple of the RTOS tick.
+     */
+    void attach(Driver driver = DriverRtosTimer);
+
+    /** Disconnect the wheel from its periodic source. Active entries are kept.
+     */
+    void detach();
+
+    /** Start or restart a timeout. O(1)
+      @param entry 		timeout to start
+      @param microsec 	timeout in microseconds, rounded up to the wheel resolution (at least one tick)
+     */
+    void start(Entry* entry, uint64_t microsec);
+
+    /** Cancel a timeout. O(1)
+      @param entry 		timeout to cancel
+      @return true if the timeout was active
+     */
+    bool cancel(Entry* entry);
+
+    /** Check if a timeout is active
+      @param entry 		timeout to check
+      @return true if active
+     */
+    bool active(const Entry* entry) const { return (entry->next != NULL); }
+
+    /** Advance the wheel one tick, expiring due entries. Invoked by the attached driver, or manually when
+     *  the wheel is driven by the application.
+     */
+    void tick();
+
+    /** Get the number of active timeouts
+      @return active timeouts
+     */
+    uint32_t count() const { return _count; }
+
+    /** Get the number of ticks elapsed since construction
+      @return current tick
+     */
+    uint32_t now() const { return _now; }
+
+    /** Get the tick period
+      @return resolution in microseconds
+     */
+    uint32_t getResolution() const { return _resolution; }
+
+    ~TimingWheel();
+
+private:
+    Callback<void(Entry*)> _handler;	/// Callback de expiración
+    uint32_t _resolution;				/// Periodo del tick en us
+    uint8_t _levels;					/// Niveles de la jerarquía
+    uint8_t _bits;						/// log2 de buckets por nivel
+    uint32_t _mask;						/// Máscara de índice dentro de un nivel
+    uint32_t _max_ticks;				/// Máxima temporización admitida en ticks
+    Entry* _buckets;					/// Centinelas de las listas circulares (_levels << _bits)
+    volatile uint32_t _now;				/// Tick actual
+    volatile uint32_t _count;			/// Temporizaciones activas
+    portMUX_TYPE _mux;					/// Spinlock de acceso a la rueda
+    Ticker* _ticker;					/// Fuente periódica en modo DriverTicker
+    RtosTimer* _timer;					/// Fuente periódica en modo DriverRtosTimer
+
+    /** Inserta una entrada en el bucket que le corresponde según su tick de expiración
+     *  @param entry Entrada
+     */
+    void _insert(Entry* entry);
+
+    /** Desenlaza una entrada de su bucket
+     *  @param entry Entrada
+     */
+    static inline void _unlink(Entry* entry){
+    	entry->prev->next = entry->next;
+    	entry->next->prev = entry->prev;
+    	entry->next = NULL;
+    	entry->prev = NULL;
+    }
+
+    /** Obtiene el centinela de un bucket
+     *  @param level Nivel
+     *  @param idx Índice dentro del nivel
+     *  @return Centinela
+     */
+    inline Entry* _bucket(uint32_t level, uint32_t idx){
+    	return &_buckets[(level << _bits) + idx];
+    }
+};
+
+
+#endif
+
+/** @}*/
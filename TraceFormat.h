@@ -0,0 +1,300 @@
+/*
+ * TraceFormat.h
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ *	Núcleo portable de las trazas diferidas (TraceLog): captura de los argumentos de una traza con su tipo,
+ *	codificación binaria compacta en el buffer de registro y formateo posterior a partir del formato printf y de
+ *	los argumentos decodificados. No depende del hardware ni del RTOS, de forma que se prueba en host.
+ *
+ *	El tipo de cada argumento se toma de su tipo C++ en el punto de llamada, no del formato. Al formatear, cada
+ *	conversión se rehace con el modificador de longitud que corresponde al valor almacenado, por lo que un "%d" con
+ *	un argumento de 64 bits no desalinea el resto. Las conversiones incompatibles con el valor se imprimen como "?".
+ *	Las cadenas (%s) se copian al registrar la traza, truncadas a MaxStringCopy caracteres.
+ *
+ */
+
+#ifndef TRACE_FORMAT_H
+#define TRACE_FORMAT_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+
+class TraceFormat {
+public:
+
+	/** Longitud máxima copiada de cada argumento de tipo cadena */
+	static const uint32_t MaxStringCopy = 32;
+
+	/** Tipo de un argumento capturado */
+	enum ArgType {
+		ArgInt32 = 0,		/// Entero de hasta 32 bits (con signo o sin él)
+		ArgInt64,			/// Entero de 64 bits
+		ArgDouble,			/// Coma flotante (float se promociona a double)
+		ArgString,			/// Cadena terminada en '\0'
+		ArgPointer,			/// Otro puntero (se imprime como %p)
+	};
+
+	/** Argumento capturado */
+	struct Arg_t {
+		uint8_t type;			/// ArgType
+		union {
+			int32_t i32;
+			int64_t i64;
+			double d;
+			const char* s;
+			const void* p;
+		} v;
+	};
+
+
+	/** Captura de argumentos según su tipo en el punto de llamada */
+	static inline Arg_t arg(char v)					{ return int32(v); }
+	static inline Arg_t arg(signed char v)			{ return int32(v); }
+	static inline Arg_t arg(unsigned char v)		{ return int32(v); }
+	static inline Arg_t arg(short v)				{ return int32(v); }
+	static inline Arg_t arg(unsigned short v)		{ return int32(v); }
+	static inline Arg_t arg(bool v)					{ return int32(v); }
+	static inline Arg_t arg(int v)					{ return int32(v); }
+	static inline Arg_t arg(unsigned int v)			{ return int32((int32_t)v); }
+	static inline Arg_t arg(long v)					{ return (sizeof(long) > 4)? int64(v) : int32((int32_t)v); }
+	static inline Arg_t arg(unsigned long v)		{ return (sizeof(long) > 4)? int64((int64_t)v) : int32((int32_t)v); }
+	static inline Arg_t arg(long long v)			{ return int64(v); }
+	static inline Arg_t arg(unsigned long long v)	{ return int64((int64_t)v); }
+	static inline Arg_t arg(double v)				{ Arg_t a; a.type = ArgDouble; a.v.d = v; return a; }
+	static inline Arg_t arg(const char* v)			{ Arg_t a; a.type = ArgString; a.v.s = v; return a; }
+	static inline Arg_t arg(char* v)				{ return arg((const char*)v); }
+	template <typename T>
+	static inline Arg_t arg(T* v)					{ Arg_t a; a.type = ArgPointer; a.v.p = (const void*)v; return a; }
+
+
+	/** Calcula el tamaño codificado de una lista de argumentos
+	 *  @param args Argumentos
+	 *  @param nargs Número de argumentos
+	 *  @param lens Recibe la longitud copiada de cada cadena (nargs elementos)
+	 *  @return Tamaño en bytes (múltiplo de 4)
+	 */
+	static uint32_t encodedSize(const Arg_t* args, int nargs, uint8_t* lens){
+		uint32_t size = align4(nargs);
+		for(int i = 0; i < nargs; i++){
+			switch(args[i].type){
+				case ArgInt64:
+				case ArgDouble:
+					size += 8;
+					break;
+				case ArgString:
+					lens[i] = (args[i].v.s)? (uint8_t)strnlen(args[i].v.s, MaxStringCopy) : 0;
+					size += 4 + align4(lens[i] + 1);
+					break;
+				case ArgPointer:
+					size += align4(sizeof(void*));
+					break;
+				default:
+					size += 4;
+					break;
+			}
+		}
+		return size;
+	}
+
+
+	/** Codifica una lista de argumentos: tipos (un byte cada uno) y a continuación sus valores
+	 *  @param dst Destino, de encodedSize() bytes
+	 *  @param args Argumentos
+	 *  @param nargs Número de argumentos
+	 *  @param lens Longitudes obtenidas con encodedSize()
+	 */
+	static void encode(uint8_t* dst, const Arg_t* args, int nargs, const uint8_t* lens){
+		uint8_t* val = dst + align4(nargs);
+		for(int i = 0; i < nargs; i++){
+			dst[i] = args[i].type;
+			switch(args[i].type){
+				case ArgInt64:
+				case ArgDouble:
+					memcpy(val, &args[i].v, 8);
+					val += 8;
+					break;
+				case ArgString: {
+					uint32_t len = lens[i];
+					memcpy(val, &len, 4);
+					if(len){
+						memcpy(val + 4, args[i].v.s, len);
+					}
+					val[4 + len] = 0;
+					val += 4 + align4(len + 1);
+					break;
+				}
+				case ArgPointer:
+					memcpy(val, &args[i].v.p, sizeof(void*));
+					val += align4(sizeof(void*));
+					break;
+				default:
+					memcpy(val, &args[i].v.i32, 4);
+					val += 4;
+					break;
+			}
+		}
+	}
+
+
+	/** Decodifica una lista de argumentos. Las cadenas apuntan a su copia dentro de 'src'
+	 *  @param src Origen codificado
+	 *  @param nargs Número de argumentos
+	 *  @param args Recibe los argumentos
+	 */
+	static void decode(const uint8_t* src, int nargs, Arg_t* args){
+		const uint8_t* val = src + align4(nargs);
+		for(int i = 0; i < nargs; i++){
+			args[i].type = src[i];
+			switch(src[i]){
+				case ArgInt64:
+				case ArgDouble:
+					memcpy(&args[i].v, val, 8);
+					val += 8;
+					break;
+				case ArgString: {
+					uint32_t len;
+					memcpy(&len, val, 4);
+					args[i].v.s = (const char*)(val + 4);
+					val += 4 + align4(len + 1);
+					break;
+				}
+				case ArgPointer:
+					memcpy(&args[i].v.p, val, sizeof(void*));
+					val += align4(sizeof(void*));
+					break;
+				default:
+					memcpy(&args[i].v.i32, val, 4);
+					val += 4;
+					break;
+			}
+		}
+	}
+
+
+	/** Formatea una traza a partir de su formato printf y de sus argumentos capturados
+	 *  @param buf Destino
+	 *  @param size Tamaño del destino (incluyendo el '\0' final)
+	 *  @param fmt Formato printf
+	 *  @param args Argumentos
+	 *  @param nargs Número de argumentos
+	 *  @return Caracteres escritos (sin el '\0' final)
+	 */
+	static int format(char* buf, size_t size, const char* fmt, const Arg_t* args, int nargs){
+		if(size == 0){
+			return 0;
+		}
+		size_t n = 0;
+		int next = 0;
+		while(*fmt && n + 1 < size){
+			if(*fmt != '%'){
+				buf[n++] = *fmt++;
+				continue;
+			}
+			if(fmt[1] == '%'){
+				buf[n++] = '%';
+				fmt += 2;
+				continue;
+			}
+			// se copian flags, anchura y precisión. Las indicadas con '*' se toman de los argumentos
+			char spec[48];
+			int s = 0;
+			spec[s++] = *fmt++;
+			while(*fmt && strchr("-+ #0", *fmt) && s < 8){
+				spec[s++] = *fmt++;
+			}
+			for(int part = 0; part < 2; part++){
+				if(part == 1){
+					if(*fmt != '.'){
+						break;
+					}
+					spec[s++] = *fmt++;
+				}
+				if(*fmt == '*'){
+					int v = (next < nargs && args[next].type == ArgInt32)? args[next].v.i32 : 0;
+					next++;
+					fmt++;
+					s += snprintf(&spec[s], 12, "%d", v);
+				}
+				else{
+					while(*fmt >= '0' && *fmt <= '9' && s < 24){
+						spec[s++] = *fmt++;
+					}
+				}
+			}
+			// el modificador de longitud se sustituye por el del valor almacenado
+			while(*fmt && strchr("hlLqjzt", *fmt)){
+				fmt++;
+			}
+			char conv = *fmt;
+			if(!conv){
+				break;
+			}
+			fmt++;
+			const Arg_t* a = (next < nargs)? &args[next] : 0;
+			next++;
+			int w = -1;
+			switch(conv){
+				case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c':
+					if(a && a->type == ArgInt32){
+						spec[s++] = conv;
+						spec[s] = 0;
+						w = (conv == 'd' || conv == 'i' || conv == 'c')? snprintf(&buf[n], size - n, spec, (int)a->v.i32) :
+								snprintf(&buf[n], size - n, spec, (unsigned int)a->v.i32);
+					}
+					else if(a && a->type == ArgInt64 && conv != 'c'){
+						spec[s++] = 'l';
+						spec[s++] = 'l';
+						spec[s++] = conv;
+						spec[s] = 0;
+						w = (conv == 'd' || conv == 'i')? snprintf(&buf[n], size - n, spec, (long long)a->v.i64) :
+								snprintf(&buf[n], size - n, spec, (unsigned long long)a->v.i64);
+					}
+					break;
+				case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+					if(a && a->type == ArgDouble){
+						spec[s++] = conv;
+						spec[s] = 0;
+						w = snprintf(&buf[n], size - n, spec, a->v.d);
+					}
+					break;
+				case 's':
+					if(a && a->type == ArgString){
+						spec[s++] = 's';
+						spec[s] = 0;
+						w = snprintf(&buf[n], size - n, spec, (a->v.s)? a->v.s : "(null)");
+					}
+					break;
+				case 'p':
+					if(a && (a->type == ArgPointer || a->type == ArgString)){
+						spec[s++] = 'p';
+						spec[s] = 0;
+						w = snprintf(&buf[n], size - n, spec, a->v.p);
+					}
+					break;
+				default:
+					break;
+			}
+			if(w < 0){
+				buf[n++] = '?';
+				continue;
+			}
+			n += ((size_t)w < size - n)? (size_t)w : (size - n - 1);
+		}
+		buf[n] = 0;
+		return (int)n;
+	}
+
+private:
+	static inline uint32_t align4(uint32_t n) { return (n + 3) & ~3; }
+	static inline Arg_t int32(int32_t v) { Arg_t a; a.type = ArgInt32; a.v.i32 = v; return a; }
+	static inline Arg_t int64(int64_t v) { Arg_t a; a.type = ArgInt64; a.v.i64 = v; return a; }
+};
+
+
+#endif
+
+/** @}*/
@@ -0,0 +1,280 @@
+/*
+ * TraceLog.cpp
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ */
+
+#include "TraceLog.h"
+#include "Ticker_HAL.h"
+#include "Thread.h"
+#include "Mutex.h"
+#include <xtensa/hal.h>
+
+
+
+//------------------------------------------------------------------------------------
+//---- STATIC ------------------------------------------------------------------------
+//------------------------------------------------------------------------------------
+
+TraceLog::Ring_t TraceLog::_rings[portNUM_PROCESSORS];
+volatile uint32_t TraceLog::_busy_drops = 0;
+uint32_t TraceLog::_emitted = 0;
+Thread* TraceLog::_thread = NULL;
+Mutex* TraceLog::_mutex = NULL;
+volatile bool TraceLog::_starting = false;
+
+static_assert((TraceLog::RingSize & (TraceLog::RingSize - 1)) == 0, "MBED_TRACE_RING_SIZE debe ser potencia de 2");
+static_assert(TraceLog::RingSize <= UINT16_MAX, "MBED_TRACE_RING_SIZE no cabe en Record_t::size (máximo 32768)");
+
+
+//------------------------------------------------------------------------------------
+static inline uint32_t align8(uint32_t n){
+	return (n + 7) & ~7;
+}
+
+
+
+//------------------------------------------------------------------------------------
+//-- PUBLIC METHODS IMPLEMENTATION ---------------------------------------------------
+//------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------
+void TraceLog::start(){
+	MBED_ASSERT(!IS_ISR());
+	if(_thread){
+		return;
+	}
+	if(__atomic_exchange_n(&_starting, true, __ATOMIC_SEQ_CST)){
+		// lo está arrancando otro thread
+		while(!__atomic_load_n(&_thread, __ATOMIC_SEQ_CST)){
+			vTaskDelay(1);
+		}
+		return;
+	}
+	Ticker_HAL::start();
+	_mutex = new Mutex();
+	Thread* th = new Thread(ThreadPriority, ThreadStackSize, NULL, "trace_log");
+	MBED_ASSERT(_mutex && th);
+	__atomic_store_n(&_thread, th, __ATOMIC_SEQ_CST);
+	osStatus err = th->start(callback(&TraceLog::task));
+	MBED_ASSERT(err == osOK);
+}
+
+
+//------------------------------------------------------------------------------------
+void TraceLog::write(int level, const char* tag, const char* format, const TraceFormat::Arg_t* args, int nargs){
+	uint32_t cycles = xthal_get_ccount();
+	if(nargs > MaxArgs){
+		nargs = MaxArgs;
+	}
+	// el thread de emisión lo arranca el primer thread que registra una traza (las trazas que se generen durante
+	// el arranque sólo se registran)
+	if(!_starting && !IS_ISR() && xTaskGetSchedulerState() == taskSCHEDULER_RUNNING){
+		start();
+		cycles = xthal_get_ccount();
+	}
+
+	// el tamaño y la longitud de las cadenas se calculan antes de enmascarar las interrupciones
+	uint8_t lens[MaxArgs];
+	uint32_t truncated = 0;
+	uint32_t size = align8(sizeof(Record_t) + TraceFormat::encodedSize(args, nargs, lens));
+	for(int i = 0; i < nargs; i++){
+		if(args[i].type == TraceFormat::ArgString && lens[i] == TraceFormat::MaxStringCopy && args[i].v.s[lens[i]] != 0){
+			truncated++;
+		}
+	}
+	uint64_t timestamp = 0;
+
+	// el buffer de cada core sólo lo modifica su core: basta con enmascarar sus interrupciones
+	uint32_t state = portENTER_CRITICAL_NESTED();
+	Ring_t* ring = &_rings[xPortGetCoreID()];
+	uint32_t head = ring->head;
+	uint32_t off = head & (RingSize - 1);
+	uint32_t pad = (RingSize - off < size)? (RingSize - off) : 0;
+	uint32_t used = head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+	if(used + pad + size > RingSize){
+		ring->dropped++;
+		portEXIT_CRITICAL_NESTED(state);
+		return;
+	}
+	// los registros no se parten: si no cabe hasta el final del buffer, se rellena y se escribe desde el inicio
+	if(pad){
+		Record_t* padding = (Record_t*)&ring->buf[off];
+		padding->size = pad;
+		padding->level = PadLevel;
+		head += pad;
+		off = 0;
+	}
+	if(Ticker_HAL::isStarted()){
+		timestamp = Ticker_HAL::now_ticks();
+	}
+	Record_t* rec = (Record_t*)&ring->buf[off];
+	rec->size = size;
+	rec->level = level;
+	rec->nargs = nargs;
+	rec->tag = tag;
+	rec->format = format;
+	rec->timestamp = timestamp;
+	TraceFormat::encode((uint8_t*)(rec + 1), args, nargs, lens);
+	// se publica una vez completo
+	__atomic_store_n(&ring->head, head + size, __ATOMIC_RELEASE);
+
+	ring->pushed++;
+	ring->truncated += truncated;
+	if(used + pad + size > ring->max_used){
+		ring->max_used = used + pad + size;
+	}
+	cycles = xthal_get_ccount() - cycles;
+	ring->push_cycles_total += cycles;
+	if(cycles > ring->push_cycles_max){
+		ring->push_cycles_max = cycles;
+	}
+	portEXIT_CRITICAL_NESTED(state);
+}
+
+
+//------------------------------------------------------------------------------------
+int TraceLog::flush(){
+	start();
+	_mutex->lock();
+	// sólo se emiten los registros presentes al inicio, para que un productor continuo no bloquee al llamante
+	uint32_t end[portNUM_PROCESSORS];
+	for(int c = 0; c < portNUM_PROCESSORS; c++){
+		end[c] = __atomic_load_n(&_rings[c].head, __ATOMIC_ACQUIRE);
+	}
+	int count = 0;
+	for(;;){
+		// el registro más antiguo de ambos cores
+		Ring_t* ring = NULL;
+		Record_t* rec = NULL;
+		for(int c = 0; c < portNUM_PROCESSORS; c++){
+			Record_t* r = peek(&_rings[c], end[c]);
+			if(r && (!rec || (int64_t)(r->timestamp - rec->timestamp) < 0)){
+				rec = r;
+				ring = &_rings[c];
+			}
+		}
+		if(!rec){
+			break;
+		}
+		emit(rec);
+		// el espacio se libera una vez emitido (las cadenas se formatean desde el propio registro)
+		__atomic_store_n(&ring->tail, ring->tail + rec->size, __ATOMIC_RELEASE);
+		count++;
+	}
+	_emitted += count;
+	_mutex->unlock();
+	return count;
+}
+
+
+//------------------------------------------------------------------------------------
+void TraceLog::getStats(Stats_t* stats){
+	memset(stats, 0, sizeof(Stats_t));
+	for(int c = 0; c < portNUM_PROCESSORS; c++){
+		const Ring_t* ring = &_rings[c];
+		stats->pushed += ring->pushed;
+		stats->dropped += ring->dropped;
+		stats->truncated += ring->truncated;
+		stats->push_cycles_total += ring->push_cycles_total;
+		if(ring->max_used > stats->max_used){
+			stats->max_used = ring->max_used;
+		}
+		if(ring->push_cycles_max > stats->push_cycles_max){
+			stats->push_cycles_max = ring->push_cycles_max;
+		}
+	}
+	stats->emitted = _emitted;
+	stats->busy_drops = _busy_drops;
+}
+
+
+//------------------------------------------------------------------------------------
+void TraceLog::resetStats(){
+	for(int c = 0; c < portNUM_PROCESSORS; c++){
+		// cada core actualiza sus contadores con las interrupciones enmascaradas; desde el otro core el reinicio
+		// puede perder algún incremento concurrente
+		uint32_t state = portENTER_CRITICAL_NESTED();
+		Ring_t* ring = &_rings[c];
+		ring->pushed = 0;
+		ring->dropped = 0;
+		ring->truncated = 0;
+		ring->max_used = 0;
+		ring->push_cycles_max = 0;
+		ring->push_cycles_total = 0;
+		portEXIT_CRITICAL_NESTED(state);
+	}
+	_emitted = 0;
+	_busy_drops = 0;
+}
+
+
+
+//------------------------------------------------------------------------------------
+//-- PRIVATE METHODS IMPLEMENTATION --------------------------------------------------
+//------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------
+TraceLog::Record_t* TraceLog::peek(Ring_t* ring, uint32_t end){
+	for(;;){
+		uint32_t tail = ring->tail;
+		if(tail == end){
+			return NULL;
+		}
+		Record_t* rec = (Record_t*)&ring->buf[tail & (RingSize - 1)];
+		if(rec->level != PadLevel){
+			return rec;
+		}
+		__atomic_store_n(&ring->tail, tail + rec->size, __ATOMIC_RELEASE);
+	}
+}
+
+
+//------------------------------------------------------------------------------------
+void TraceLog::emit(const Record_t* rec){
+	TraceFormat::Arg_t args[MaxArgs];
+	char line[MaxLineLength];
+	TraceFormat::decode((const uint8_t*)(rec + 1), rec->nargs, args);
+	TraceFormat::format(line, sizeof(line), rec->format, args, rec->nargs);
+
+	// mismo formato que ESP_LOGx, con la marca de tiempo del registro
+	uint32_t ms = (uint32_t)Ticker_HAL::ticksToMs(rec->timestamp);
+	const char* level = "E";
+	switch(rec->level & ~LocalFlag){
+		case ESP_LOG_ERROR:
+			esp_log_write(ESP_LOG_ERROR, rec->tag, LOG_FORMAT(E, "%s"), ms, rec->tag, line);
+			break;
+		case ESP_LOG_WARN:
+			level = "W";
+			esp_log_write(ESP_LOG_WARN, rec->tag, LOG_FORMAT(W, "%s"), ms, rec->tag, line);
+			break;
+		case ESP_LOG_INFO:
+			level = "I";
+			esp_log_write(ESP_LOG_INFO, rec->tag, LOG_FORMAT(I, "%s"), ms, rec->tag, line);
+			break;
+		case ESP_LOG_DEBUG:
+			level = "D";
+			esp_log_write(ESP_LOG_DEBUG, rec->tag, LOG_FORMAT(D, "%s"), ms, rec->tag, line);
+			break;
+		default:
+			level = "V";
+			esp_log_write(ESP_LOG_VERBOSE, rec->tag, LOG_FORMAT(V, "%s"), ms, rec->tag, line);
+			break;
+	}
+	if(!(rec->level & LocalFlag) && syslog_print){
+		syslog_print(level, rec->tag, "%s", line);
+	}
+}
+
+
+//------------------------------------------------------------------------------------
+void TraceLog::task(){
+	for(;;){
+		flush();
+		Thread::wait(FlushPeriodMs);
+	}
+}
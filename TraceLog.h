@@ -0,0 +1,178 @@
+/*
+ * TraceLog.h
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ *	Backend diferido de las trazas DEBUG_TRACE_* (MBED_TRACE_DEFERRED=1). El punto de llamada no formatea: registra
+ *	el puntero al formato, el tag, una marca de tiempo y los argumentos en binario en un buffer circular de su core,
+ *	con sus interrupciones enmascaradas y sin spinlocks. Un thread de baja prioridad formatea y emite después los
+ *	registros de ambos cores, en orden de marca de tiempo, por esp_log y por 'syslog_print'.
+ *
+ *	Los formatos y los tags deben ser cadenas permanentes (literales). Los argumentos de tipo cadena se copian.
+ *
+ */
+
+#ifndef MBED_TRACELOG_H
+#define MBED_TRACELOG_H
+
+#include "mbed_api.h"
+#include "TraceFormat.h"
+
+
+/** Tamaño en bytes del buffer de registro de cada core (potencia de 2) */
+#if !defined(MBED_TRACE_RING_SIZE)
+#define MBED_TRACE_RING_SIZE		2048
+#endif
+
+
+class Thread;
+class Mutex;
+
+
+/** The TraceLog class keeps the per-core rings of deferred traces and the thread that emits them.
+ *
+ * With MBED_TRACE_DEFERRED=1 the DEBUG_TRACE_* macros call TraceLog::push(), which costs a copy of the arguments
+ * instead of a formatted write to the UART. Records are never lost silently: a full ring drops the new record and
+ * counts it, and getStats() reports the drops along with the cost of each push in cycles.
+ * @code
+ * TraceLog::start();
+ * DEBUG_TRACE_I(true, "[App]", "value=%d name=%s", value, name);
+ * ...
+ * TraceLog::Stats_t stats;
+ * TraceLog::getStats(&stats);
+ * @endcode
+ *
+ * @note Synchronization level: push() is interrupt safe. flush() must be called from a thread
+ */
+class TraceLog {
+public:
+
+	/** Tamaño del buffer de registro de cada core */
+	static const uint32_t RingSize = MBED_TRACE_RING_SIZE;
+
+	/** Número máximo de argumentos de una traza */
+	static const int MaxArgs = 8;
+
+	/** Longitud máxima de una traza formateada */
+	static const int MaxLineLength = 160;
+
+	/** Periodo de vaciado de los buffers en el thread de emisión */
+	static const uint32_t FlushPeriodMs = 20;
+
+	/** Prioridad y stack del thread de emisión */
+	static const int ThreadPriority = (osPriorityIdle + 1);
+	static const uint32_t ThreadStackSize = 3072;
+
+	/** Flag que se combina con el nivel en las trazas locales (DEBUG_LOCAL_TRACE_*): no se envían por syslog */
+	static const int LocalFlag = 0x80;
+
+
+	/** Estadísticas de registro y emisión, agregadas de ambos cores
+	 */
+	struct Stats_t {
+		uint32_t pushed;			/// Trazas registradas
+		uint32_t dropped;			/// Trazas descartadas por buffer lleno
+		uint32_t emitted;			/// Trazas emitidas
+		uint32_t truncated;			/// Argumentos de cadena truncados a TraceFormat::MaxStringCopy
+		uint32_t busy_drops;		/// Trazas síncronas descartadas por el flag '_busy' (sin MBED_TRACE_DEFERRED)
+		uint32_t max_used;			/// Máxima ocupación de un buffer (bytes)
+		uint32_t push_cycles_max;	/// Duración máxima de push() en ciclos
+		uint64_t push_cycles_total;	/// Duración acumulada de push() en ciclos
+	};
+
+
+	/** Arranca el thread de emisión (lo hace también la primera traza registrada desde un thread)
+	 */
+	static void start();
+
+
+	/** Registra una traza
+	 *  @param level Nivel (esp_log_level_t), opcionalmente con LocalFlag
+	 *  @param tag Tag (cadena permanente)
+	 *  @param format Formato printf (cadena permanente)
+	 *  @param args Argumentos
+	 */
+	template <typename... ArgTs>
+	static inline void push(int level, const char* tag, const char* format, ArgTs... args){
+		static_assert(sizeof...(ArgTs) <= MaxArgs, "Demasiados argumentos para una traza diferida");
+		TraceFormat::Arg_t list[sizeof...(ArgTs) + 1] = { TraceFormat::arg(args)... };
+		write(level, tag, format, list, sizeof...(ArgTs));
+	}
+
+
+	/** Registra una traza con sus argumentos ya capturados
+	 *  @param level Nivel
+	 *  @param tag Tag
+	 *  @param format Formato printf
+	 *  @param args Argumentos
+	 *  @param nargs Número de argumentos
+	 */
+	static void write(int level, const char* tag, const char* format, const TraceFormat::Arg_t* args, int nargs);
+
+
+	/** Emite las trazas pendientes en el thread llamante
+	 *  @return Trazas emitidas
+	 */
+	static int flush();
+
+
+	/** Obtiene las estadísticas
+	 *  @param stats Recibe las estadísticas
+	 */
+	static void getStats(Stats_t* stats);
+
+
+	/** Reinicia las estadísticas
+	 */
+	static void resetStats();
+
+
+	/** Contabiliza una traza síncrona descartada por el flag '_busy' */
+	static inline void busyDrop() { _busy_drops = _busy_drops + 1; }
+
+private:
+
+	/** Buffer de registro de un core. Sólo su core escribe en él (con sus interrupciones enmascaradas) y sólo
+	 *  el emisor avanza 'tail'
+	 */
+	struct Ring_t {
+		uint8_t buf[RingSize];
+		volatile uint32_t head;		/// Bytes escritos (índice monótono)
+		volatile uint32_t tail;		/// Bytes consumidos (índice monótono)
+		uint32_t pushed;
+		uint32_t dropped;
+		uint32_t truncated;
+		uint32_t max_used;
+		uint32_t push_cycles_max;
+		uint64_t push_cycles_total;
+	};
+
+	/** Cabecera de cada registro, seguida de sus argumentos codificados */
+	struct Record_t {
+		uint16_t size;				/// Tamaño total del registro (múltiplo de 8)
+		uint8_t level;				/// Nivel y flags. PadLevel marca un relleno hasta el final del buffer
+		uint8_t nargs;				/// Número de argumentos
+		const char* tag;
+		const char* format;
+		uint64_t timestamp;			/// Contador de Ticker_HAL
+	};
+
+	static const uint8_t PadLevel = 0xff;
+
+	static Ring_t _rings[portNUM_PROCESSORS];
+	static volatile uint32_t _busy_drops;
+	static uint32_t _emitted;
+	static Thread* _thread;
+	static Mutex* _mutex;				/// Exclusión entre emisores (thread y flush)
+	static volatile bool _starting;
+
+	static Record_t* peek(Ring_t* ring, uint32_t end);
+	static void emit(const Record_t* rec);
+	static void task();
+};
+
+
+#endif
+
+/** @}*/
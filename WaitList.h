@@ -0,0 +1,176 @@
+/*
+ * WaitList.h
+ *
+ *  Created on: Oct 2026
+ *      Author: raulMrello
+ *
+ *	Lista intrusiva de threads en espera para construir primitivas de sincronización sobre las task
+ *	notifications de FreeRTOS (osFlagsWakeup), sin colas ni reserva de memoria dinámica.
+ *
+ *	Los nodos viven en el stack del thread que espera. Todas las operaciones sobre la lista se realizan con el
+ *	spinlock de la primitiva tomado (WaitList::enter / WaitList::exit), de forma que quien despierta a un thread
+ *	nunca accede a su nodo una vez liberado el spinlock.
+ *
+ */
+
+#ifndef MBED_WAITLIST_H
+#define MBED_WAITLIST_H
+
+#include "mbed_api.h"
+
+
+class WaitList {
+public:
+
+	/** Nodo de espera. Las primitivas pueden derivar de él para añadir su propio estado */
+	struct Node {
+		Node* next;					/// Siguiente nodo en la lista
+		Node* prev;					/// Nodo previo en la lista
+		osThreadId tid;				/// Thread en espera
+		volatile bool signaled;		/// Flag de nodo despertado por la primitiva
+	};
+
+	/** Constructor */
+	WaitList() : _head(NULL), _tail(NULL) {}
+
+	/** Chequea si hay threads en espera
+	 * 	@return true si la lista está vacía
+	 */
+	bool empty() const { return (_head == NULL); }
+
+	/** Obtiene el primer nodo en espera (orden FIFO)
+	 * 	@return Nodo o NULL
+	 */
+	Node* first() const { return _head; }
+
+	/** Añade el thread en curso al final de la lista
+	 * 	@param node Nodo a añadir, ubicado en el stack del thread en curso
+	 */
+	void enqueue(Node* node){
+		node->tid = xTaskGetCurrentTaskHandle();
+		node->signaled = false;
+		node->next = NULL;
+		node->prev = _tail;
+		if(_tail){
+			_tail->next = node;
+		}
+		else{
+			_head = node;
+		}
+		_tail = node;
+	}
+
+	/** Extrae un nodo de la lista
+	 * 	@param node Nodo a extraer
+	 */
+	void remove(Node* node){
+		if(node->prev){
+			node->prev->next = node->next;
+		}
+		else{
+			_head = node->next;
+		}
+		if(node->next){
+			node->next->prev = node->prev;
+		}
+		else{
+			_tail = node->prev;
+		}
+		node->next = NULL;
+		node->prev = NULL;
+	}
+
+	/** Extrae un nodo, lo marca como despertado y notifica a su thread. Tras esta llamada el nodo no debe
+	 * 	volver a utilizarse por quien despierta.
+	 * 	@param node Nodo a despertar
+	 * 	@param woken Se activa si el thread despertado requiere un cambio de contexto
+	 */
+	void wake(Node* node, BaseType_t* woken){
+		osThreadId tid = node->tid;
+		remove(node);
+		node->signaled = true;
+		xTaskNotifyFromISR(tid, osFlagsWakeup, eSetBits, woken);
+	}
+
+	/** Toma el spinlock de la primitiva (contexto thread o ISR)
+	 * 	@param mux Spinlock
+	 */
+	static inline void enter(portMUX_TYPE* mux){
+		if(IS_ISR()){
+			portENTER_CRITICAL_ISR(mux);
+		}
+		else{
+			portENTER_CRITICAL(mux);
+		}
+	}
+
+	/** Libera el spinlock de la primitiva y cede la CPU si se ha despertado a un thread más prioritario
+	 * 	@param mux Spinlock
+	 * 	@param woken Resultado de las llamadas a wake()
+	 */
+	static inline void exit(portMUX_TYPE* mux, BaseType_t woken = pdFALSE){
+		if(IS_ISR()){
+			portEXIT_CRITICAL_ISR(mux);
+			if(woken == pdTRUE){
+				portYIELD_FROM_ISR();
+			}
+		}
+		else{
+			portEXIT_CRITICAL(mux);
+			if(woken == pdTRUE){
+				taskYIELD();
+			}
+		}
+	}
+
+	/** Bloquea el thread en curso hasta recibir osFlagsWakeup o vencer el timeout. Puede retornar por
+	 * 	notificaciones de otras primitivas, por lo que el llamante debe comprobar siempre Node::signaled.
+	 * 	Si la notificación recibida procede de Thread::signal_set (bits de señal en el valor), el estado de
+	 * 	notificación consumido debe restaurarse al terminar la espera con rearm(), o el siguiente
+	 * 	Thread::signal_wait se bloquearía con su señal ya activa.
+	 * 	@param ticks Tiempo máximo de espera en ticks
+	 * 	@param signals Se activa si se ha consumido una notificación con bits de señal pendientes
+	 * 	@return true si se ha recibido una notificación
+	 */
+	static inline bool block(TickType_t ticks, bool* signals){
+		uint32_t value = 0;
+		if(xTaskNotifyWait(0, osFlagsWakeup, &value, ticks) != pdPASS){
+			return false;
+		}
+		if((value & ~osFlagsWakeup) != 0){
+			*signals = true;
+		}
+		return true;
+	}
+
+	/** Restaura el estado de notificación consumido por block() para Thread::signal_wait. Se llama una única vez
+	 * 	al terminar la espera, no entre bloqueos: mientras se espera, un estado restaurado despertaría al
+	 * 	thread de inmediato.
+	 * 	@param signals Resultado acumulado de las llamadas a block()
+	 */
+	static inline void rearm(bool signals){
+		if(signals){
+			xTaskNotify(xTaskGetCurrentTaskHandle(), 0, eNoAction);
+		}
+	}
+
+	/** Calcula el tiempo restante de una espera
+	 * 	@param start Tick de inicio de la espera
+	 * 	@param timeout Timeout total en ticks (portMAX_DELAY para espera indefinida)
+	 * 	@return Ticks restantes
+	 */
+	static inline TickType_t remaining(TickType_t start, TickType_t timeout){
+		if(timeout == portMAX_DELAY){
+			return portMAX_DELAY;
+		}
+		TickType_t elapsed = xTaskGetTickCount() - start;
+		return (elapsed >= timeout)? 0 : (timeout - elapsed);
+	}
+
+private:
+	Node* _head;		/// Primer nodo en espera
+	Node* _tail;		/// Último nodo en espera
+};
+
+
+#endif
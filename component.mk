@@ -1,2 +1,14 @@
 COMPONENT_ADD_INCLUDEDIRS := ./
-CPPFLAGS := -fpermissive
\ No newline at end of file
+CPPFLAGS := -fpermissive
+# Histogramas de latencia de Ticker_HAL (ver Ticker_HAL.h)
+# CPPFLAGS += -DMBED_TICKER_HISTOGRAMS=1
+# Sondas de perfilado PROFILE_SCOPE (ver Profile.h)
+# CPPFLAGS += -DMBED_PROFILE=1
+# Timers de FreeRTOS de RtosTimer reservados estáticamente (ver RtosTimer.h)
+# CPPFLAGS += -DMBED_RTOSTIMER_STATIC=1
+# Trazas DEBUG_TRACE_* diferidas en buffer binario (ver TraceLog.h)
+# CPPFLAGS += -DMBED_TRACE_DEFERRED=1
+# Nivel de traza compilado, global y por módulo (ver mbed_api.h)
+# CPPFLAGS += -DMBED_TRACE_LEVEL=ESP_LOG_INFO -DMBED_TRACE_LEVEL_I2C=ESP_LOG_DEBUG
+# Tamaño y número de tramas del adaptador de syslog por lotes (ver SyslogBatch.h)
+# CPPFLAGS += -DMBED_SYSLOG_FRAME_SIZE=1024 -DMBED_SYSLOG_FRAMES=4
@@ -16,6 +16,11 @@
 #include "Ticker.h"
 #include "Timeout.h"
 #include "Timer.h"
+#include "HighResTimer.h"
+#include "Profile.h"
+#include "CallChain.h"
+#include "SyslogBatch.h"
+#include "TimingWheel.h"
 #include "List.h"
 #include "Heap.h"
 
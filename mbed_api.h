@@ -176,6 +176,7 @@ typedef SemaphoreHandle_t osSemaphoreId;	/// Conversi�n semaphoreid de mbed-os
 
 #define osFlagsError				0x80000000U
 #define osFlagsWaitAny				0x00000000U
+#define osFlagsWakeup				0x40000000U		/// Flag de notificación reservado para primitivas basadas en task notifications (distinto de osFlagsError)
 #define OS_STACK_SIZE				2048
 #define osWaitForever				portMAX_DELAY
 #define osThreadGetId()				xTaskGetCurrentTaskHandle()
@@ -204,10 +205,30 @@ void ENTER_ISR();
 void EXIT_ISR();
 int GET_ISR_NESTING();
 
+/// Secciones críticas con spinlock válidas tanto desde ISR como desde tarea
+static inline void enterCritical(portMUX_TYPE* mux){
+	if(IS_ISR()){
+		portENTER_CRITICAL_ISR(mux);
+	}
+	else{
+		portENTER_CRITICAL(mux);
+	}
+}
+
+static inline void exitCritical(portMUX_TYPE* mux){
+	if(IS_ISR()){
+		portEXIT_CRITICAL_ISR(mux);
+	}
+	else{
+		portEXIT_CRITICAL(mux);
+	}
+}
+
 /// wait common functions
 void wait(float s);
 void wait_ms(int ms);
 void wait_us(int us);
+void wait_until(uint64_t deadline);		/// deadline en ciclos de HighResTimer::cycles()
 #define HAL_GetTick()		Ticker_HAL::getTimestamp()
 
 
@@ -216,6 +237,7 @@ void wait_us(int us);
 //------------------------------------------------------------------------------------
 
 #include "Callback.h"		/// Cabecera para la implementaci�n de callbacks
+#include "FunctionRef.h"	/// Referencias a funciones y callbacks ligadas en compilación
 
 
 //------------------------------------------------------------------------------------
@@ -228,102 +250,215 @@ void wait_us(int us);
 extern void (*syslog_print)(const char* level, const char* tag, const char* format, ...);
 extern bool _busy;
 
+
+/** Nivel máximo de las trazas compiladas, por defecto el de esp_log (LOG_LOCAL_LEVEL). Las trazas de nivel superior
+ *  se eliminan en compilación, sin evaluar su expresión. Cada módulo puede fijar el suyo con _LEVEL_ (ver abajo)
+ */
+#if !defined(MBED_TRACE_LEVEL)
+#define MBED_TRACE_LEVEL		LOG_LOCAL_LEVEL
+#endif
+
+/** Nivel compilado del módulo. Un módulo lo redefine junto a _MODULE_ y _EXPR_, a partir de su propio flag, p.ej:
+ *  	#if !defined(MBED_TRACE_LEVEL_I2C)
+ *  	#define MBED_TRACE_LEVEL_I2C	MBED_TRACE_LEVEL
+ *  	#endif
+ *  	#define _LEVEL_		MBED_TRACE_LEVEL_I2C
+ *  y se activa su depuración con CPPFLAGS += -DMBED_TRACE_LEVEL_I2C=ESP_LOG_DEBUG. En ejecución, esp_log_level_set()
+ *  sólo filtra dentro de los niveles compilados. Los módulos que no lo redefinen usan esta constante
+ */
+static const int _LEVEL_ = MBED_TRACE_LEVEL;
+
+/** Comprueba en compilación si el nivel de traza está compilado en el módulo */
+#define DEBUG_TRACE_ENABLED(level)	(((level) & ~TraceLog::LocalFlag) <= _LEVEL_)
+
+
+/** Activa (1) el registro diferido de las trazas DEBUG_TRACE_* y DEBUG_LOCAL_TRACE_*: el punto de llamada copia los
+ *  argumentos en un buffer por core y un thread de baja prioridad las formatea y emite (ver TraceLog.h). Desactivado
+ *  por defecto. Se activa en la configuración del componente con CPPFLAGS += -DMBED_TRACE_DEFERRED=1
+ */
+#if !defined(MBED_TRACE_DEFERRED)
+#define MBED_TRACE_DEFERRED		0
+#endif
+
+#include "TraceLog.h"		/// Registro diferido de trazas
+
+#if MBED_TRACE_DEFERRED
+
+/** Niveles de las trazas diferidas. Se mantiene el filtro en compilación del módulo; el filtro por tag de esp_log se
+ *  aplica al emitirlas */
+#define DEBUG_TRACE_DEFERRED(expr, level, tag, format, ...)				\
+if(DEBUG_TRACE_ENABLED(level) && (expr)){								\
+	TraceLog::push(level, tag, format, ##__VA_ARGS__);					\
+}
+
+/** Macro para trazas ERROR */
+#define DEBUG_TRACE_E(expr, tag, format, ...)	DEBUG_TRACE_DEFERRED(expr, ESP_LOG_ERROR, tag, format, ##__VA_ARGS__)
+/** Macro para trazas WARNING */
+#define DEBUG_TRACE_W(expr, tag, format, ...)	DEBUG_TRACE_DEFERRED(expr, ESP_LOG_WARN, tag, format, ##__VA_ARGS__)
+/** Macro para trazas INFO */
+#define DEBUG_TRACE_I(expr, tag, format, ...)	DEBUG_TRACE_DEFERRED(expr, ESP_LOG_INFO, tag, format, ##__VA_ARGS__)
+/** Macro para trazas DEBUG */
+#define DEBUG_TRACE_D(expr, tag, format, ...)	DEBUG_TRACE_DEFERRED(expr, ESP_LOG_DEBUG, tag, format, ##__VA_ARGS__)
+/** Macro para trazas VERBOSE */
+#define DEBUG_TRACE_V(expr, tag, format, ...)	DEBUG_TRACE_DEFERRED(expr, ESP_LOG_VERBOSE, tag, format, ##__VA_ARGS__)
+
+/** Macros para trazas locales (no se envían por syslog) */
+#define DEBUG_LOCAL_TRACE_E(expr, tag, format, ...)	DEBUG_TRACE_DEFERRED(expr, ESP_LOG_ERROR | TraceLog::LocalFlag, tag, format, ##__VA_ARGS__)
+#define DEBUG_LOCAL_TRACE_W(expr, tag, format, ...)	DEBUG_TRACE_DEFERRED(expr, ESP_LOG_WARN | TraceLog::LocalFlag, tag, format, ##__VA_ARGS__)
+#define DEBUG_LOCAL_TRACE_I(expr, tag, format, ...)	DEBUG_TRACE_DEFERRED(expr, ESP_LOG_INFO | TraceLog::LocalFlag, tag, format, ##__VA_ARGS__)
+#define DEBUG_LOCAL_TRACE_D(expr, tag, format, ...)	DEBUG_TRACE_DEFERRED(expr, ESP_LOG_DEBUG | TraceLog::LocalFlag, tag, format, ##__VA_ARGS__)
+#define DEBUG_LOCAL_TRACE_V(expr, tag, format, ...)	DEBUG_TRACE_DEFERRED(expr, ESP_LOG_VERBOSE | TraceLog::LocalFlag, tag, format, ##__VA_ARGS__)
+
+#else
+
 /** Macro para trazas ERROR */
 #define DEBUG_TRACE_E(expr, tag, format, ...)			\
-if(expr && !_busy){										\
-	_busy = true;										\
-	ESP_LOGE(tag, format, ##__VA_ARGS__);				\
-	if(syslog_print){									\
-		syslog_print("E", tag, format, ##__VA_ARGS__);	\
+if(DEBUG_TRACE_ENABLED(ESP_LOG_ERROR) && (expr)){		\
+	if(!_busy){											\
+		_busy = true;									\
+		ESP_LOGE(tag, format, ##__VA_ARGS__);			\
+		if(syslog_print){								\
+			syslog_print("E", tag, format, ##__VA_ARGS__);	\
+		}												\
+		_busy = false;									\
+	}													\
+	else{												\
+		TraceLog::busyDrop();							\
 	}													\
-	_busy = false;										\
 }
 
 /** Macro para trazas WARNING */
 #define DEBUG_TRACE_W(expr, tag, format, ...)			\
-if(expr && !_busy){										\
-	_busy = true;										\
-	ESP_LOGW(tag, format, ##__VA_ARGS__);				\
-	if(syslog_print){									\
-		syslog_print("W", tag, format, ##__VA_ARGS__);	\
+if(DEBUG_TRACE_ENABLED(ESP_LOG_WARN) && (expr)){		\
+	if(!_busy){											\
+		_busy = true;									\
+		ESP_LOGW(tag, format, ##__VA_ARGS__);			\
+		if(syslog_print){								\
+			syslog_print("W", tag, format, ##__VA_ARGS__);	\
+		}												\
+		_busy = false;									\
+	}													\
+	else{												\
+		TraceLog::busyDrop();							\
 	}													\
-	_busy = false;										\
 }
 
 /** Macro para trazas INFO */
 #define DEBUG_TRACE_I(expr, tag, format, ...)			\
-if(expr && !_busy){										\
-	_busy = true;										\
-	ESP_LOGI(tag, format, ##__VA_ARGS__);				\
-	if(syslog_print){									\
-		syslog_print("I", tag, format, ##__VA_ARGS__);	\
+if(DEBUG_TRACE_ENABLED(ESP_LOG_INFO) && (expr)){		\
+	if(!_busy){											\
+		_busy = true;									\
+		ESP_LOGI(tag, format, ##__VA_ARGS__);			\
+		if(syslog_print){								\
+			syslog_print("I", tag, format, ##__VA_ARGS__);	\
+		}												\
+		_busy = false;									\
+	}													\
+	else{												\
+		TraceLog::busyDrop();							\
 	}													\
-	_busy = false;										\
 }
 
 /** Macro para trazas DEBUG */
 #define DEBUG_TRACE_D(expr, tag, format, ...)			\
-if(expr && !_busy){										\
-	_busy = true;										\
-	ESP_LOGD(tag, format, ##__VA_ARGS__);				\
-	if(syslog_print){									\
-		syslog_print("D", tag, format, ##__VA_ARGS__);	\
+if(DEBUG_TRACE_ENABLED(ESP_LOG_DEBUG) && (expr)){		\
+	if(!_busy){											\
+		_busy = true;									\
+		ESP_LOGD(tag, format, ##__VA_ARGS__);			\
+		if(syslog_print){								\
+			syslog_print("D", tag, format, ##__VA_ARGS__);	\
+		}												\
+		_busy = false;									\
+	}													\
+	else{												\
+		TraceLog::busyDrop();							\
 	}													\
-	_busy = false;										\
 }
 /** Macro para trazas VERBOSE */
 #define DEBUG_TRACE_V(expr, tag, format, ...)			\
-if(expr && !_busy){										\
-	_busy = true;										\
-	ESP_LOGV(tag, format, ##__VA_ARGS__);				\
-	if(syslog_print){									\
-		syslog_print("V", tag, format, ##__VA_ARGS__);	\
+if(DEBUG_TRACE_ENABLED(ESP_LOG_VERBOSE) && (expr)){		\
+	if(!_busy){											\
+		_busy = true;									\
+		ESP_LOGV(tag, format, ##__VA_ARGS__);			\
+		if(syslog_print){								\
+			syslog_print("V", tag, format, ##__VA_ARGS__);	\
+		}												\
+		_busy = false;									\
+	}													\
+	else{												\
+		TraceLog::busyDrop();							\
 	}													\
-	_busy = false;										\
 }
 
 /** Macro para trazas locales ERROR */
 #define DEBUG_LOCAL_TRACE_E(expr, tag, format, ...)		\
-if(expr && !_busy){										\
-	_busy = true;										\
-	ESP_LOGE(tag, format, ##__VA_ARGS__);				\
-	_busy = false;										\
+if(DEBUG_TRACE_ENABLED(ESP_LOG_ERROR) && (expr)){		\
+	if(!_busy){											\
+		_busy = true;									\
+		ESP_LOGE(tag, format, ##__VA_ARGS__);			\
+		_busy = false;									\
+	}													\
+	else{												\
+		TraceLog::busyDrop();							\
+	}													\
 }
 
 /** Macro para trazas locales WARNING */
 #define DEBUG_LOCAL_TRACE_W(expr, tag, format, ...)		\
-if(expr && !_busy){										\
-	_busy = true;										\
-	ESP_LOGW(tag, format, ##__VA_ARGS__);				\
-	_busy = false;										\
+if(DEBUG_TRACE_ENABLED(ESP_LOG_WARN) && (expr)){		\
+	if(!_busy){											\
+		_busy = true;									\
+		ESP_LOGW(tag, format, ##__VA_ARGS__);			\
+		_busy = false;									\
+	}													\
+	else{												\
+		TraceLog::busyDrop();							\
+	}													\
 }
 
 
 /** Macro para trazas locales INFO */
 #define DEBUG_LOCAL_TRACE_I(expr, tag, format, ...)		\
-if(expr && !_busy){										\
-	_busy = true;										\
-	ESP_LOGI(tag, format, ##__VA_ARGS__);				\
-	_busy = false;										\
+if(DEBUG_TRACE_ENABLED(ESP_LOG_INFO) && (expr)){		\
+	if(!_busy){											\
+		_busy = true;									\
+		ESP_LOGI(tag, format, ##__VA_ARGS__);			\
+		_busy = false;									\
+	}													\
+	else{												\
+		TraceLog::busyDrop();							\
+	}													\
 }
 
 
 /** Macro para trazas locales DEBUG */
 #define DEBUG_LOCAL_TRACE_D(expr, tag, format, ...)		\
-if(expr && !_busy){										\
-	_busy = true;										\
-	ESP_LOGD(tag, format, ##__VA_ARGS__);				\
-	_busy = false;										\
+if(DEBUG_TRACE_ENABLED(ESP_LOG_DEBUG) && (expr)){		\
+	if(!_busy){											\
+		_busy = true;									\
+		ESP_LOGD(tag, format, ##__VA_ARGS__);			\
+		_busy = false;									\
+	}													\
+	else{												\
+		TraceLog::busyDrop();							\
+	}													\
 }
 
 /** Macro para trazas locales VERBOSE */
 #define DEBUG_LOCAL_TRACE_V(expr, tag, format, ...)		\
-if(expr && !_busy){										\
-	_busy = true;										\
-	ESP_LOGV(tag, format, ##__VA_ARGS__);				\
-	_busy = false;										\
+if(DEBUG_TRACE_ENABLED(ESP_LOG_VERBOSE) && (expr)){		\
+	if(!_busy){											\
+		_busy = true;									\
+		ESP_LOGV(tag, format, ##__VA_ARGS__);			\
+		_busy = false;									\
+	}													\
+	else{												\
+		TraceLog::busyDrop();							\
+	}													\
 }
 
+#endif
+
 
 //------------------------------------------------------------------------------------
 //--- UTILIDADES DE PROP�SITO GENERAL ------------------------------------------------
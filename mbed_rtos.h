@@ -12,12 +12,16 @@
 #define MBED_RTOS_H
 
 #include "Mutex.h"
+#include "RWLock.h"
+#include "ConditionVariable.h"
 #include "Queue.h"
 #include "MemoryPool.h"
 #include "Mail.h"
 #include "RtosTimer.h"
 #include "Semaphore.h"
+#include "Notifier.h"
 #include "EventFlags.h"
+#include "TaskEventFlags.h"
 #include "Thread.h"
 
 
@@ -6,9 +6,72 @@
  *
  *	Implementa la portabilidad de temporizaciones basadas en wait
  *
+ *	Las esperas se resuelven contra un instante límite en ciclos de CPU (HighResTimer::cycles): la mayor parte del
+ *	tiempo la tarea duerme con vTaskDelay, la fracción de tick restante la espera bloqueada hasta un disparo de
+ *	Ticker_HAL y sólo los últimos microsegundos se completan en espera activa. Desde ISR, o con el planificador
+ *	detenido, la espera es completamente activa, por lo que sólo debe usarse para esperas cortas.
+ *
  */
 
 #include "mbed.h"
+#include "rom/ets_sys.h"
+
+
+
+//------------------------------------------------------------------------------------
+//---- STATIC ------------------------------------------------------------------------
+//------------------------------------------------------------------------------------
+
+/** Frecuencia de CPU en MHz (ciclos por us) */
+static const uint32_t CpuMHz = CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ;
+
+/** Ciclos de CPU por tick del sistema operativo */
+static const uint64_t CyclesPerOsTick = ((uint64_t)CpuMHz * 1000000) / configTICK_RATE_HZ;
+
+/** Margen final en espera activa (us): cubre la latencia del disparo de Ticker_HAL y del cambio de contexto */
+static const uint32_t SpinMarginUs = 50;
+
+
+//------------------------------------------------------------------------------------
+static void wakeup(Notifier* ntf){
+	ntf->give();
+}
+
+
+//------------------------------------------------------------------------------------
+/** Duerme la tarea hasta 'SpinMarginUs' antes del límite. vTaskDelay(n) despierta entre n-1 y n ticks después, por
+ *  lo que n = floor(restante / tick) nunca sobrepasa el límite. La fracción de tick restante se espera bloqueada en
+ *  un Notifier que despierta un disparo único de Ticker_HAL
+ */
+static inline void sleepUntil(uint64_t deadline){
+	if(IS_ISR() || xTaskGetSchedulerState() != taskSCHEDULER_RUNNING){
+		return;
+	}
+	uint64_t now = HighResTimer::cycles();
+	if(deadline <= now){
+		return;
+	}
+	uint64_t ticks = (deadline - now) / CyclesPerOsTick;
+	if(ticks > 0){
+		vTaskDelay((TickType_t)ticks);
+		now = HighResTimer::cycles();
+	}
+	uint64_t margin = (uint64_t)SpinMarginUs * CpuMHz;
+	if(deadline <= now + margin){
+		return;
+	}
+	uint64_t us = (deadline - now - margin) / CpuMHz;
+	if(us == 0){
+		return;
+	}
+	Notifier ntf(osThreadGetId());
+	Timeout tout;
+	tout.attach_us(callback(wakeup, &ntf), us);
+	// el límite de take() sólo protege frente a un disparo perdido: 'us' es menor que dos ticks
+	ntf.take((uint32_t)(us / 1000) + 2 * portTICK_PERIOD_MS);
+	tout.detach();
+}
+
 
 
 //------------------------------------------------------------------------------------
@@ -30,14 +93,25 @@ void wait_ms(int ms) {
 
 //------------------------------------------------------------------------------------
 void wait_us(int us) {
-	int ms = us / 1000;
-	if (MBED_MILLIS_TO_TICK(ms) > 1){
-		Thread::wait(ms);
+	if(us <= 0){
+		return;
 	}
-	else{
-		Timer tmr;
-		tmr.start();
-		while(tmr.read_us() < us);
+	// desde ISR no se puede arrancar la base de tiempos: si no está en marcha, espera activa con la rutina de la ROM
+	if(!Ticker_HAL::isStarted()){
+		if(IS_ISR()){
+			ets_delay_us(us);
+			return;
+		}
+		Ticker_HAL::start();
 	}
+	wait_until(HighResTimer::cycles() + ((uint64_t)us * CpuMHz));
 }
 
+
+//------------------------------------------------------------------------------------
+void wait_until(uint64_t deadline) {
+	MBED_ASSERT(Ticker_HAL::isStarted());
+	sleepUntil(deadline);
+	while(HighResTimer::cycles() < deadline){
+	}
+}
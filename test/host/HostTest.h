@@ -0,0 +1,28 @@
+/* HostTest
+
+   Minimal assertion helpers shared by the host tests (Linux). Same names as Unity, so that a test body reads the
+   same as its device counterpart. Failures are counted and reported at the end instead of aborting the test.
+   Each test defines _MODULE_ before including this header.
+*/
+
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+static int failures = 0;
+#define TEST_ASSERT(cond) do{ if(!(cond)){ printf("%s %s:%d: %s\n", _MODULE_, __FILE__, __LINE__, #cond); failures++; } }while(0)
+#define TEST_ASSERT_EQUAL(exp, act) TEST_ASSERT((uint64_t)(exp) == (uint64_t)(act))
+#define TEST_ASSERT_EQUAL_STRING(exp, act) do{ if(strcmp((exp), (act)) != 0){ printf("%s %s:%d: \"%s\" != \"%s\"\n", _MODULE_, __FILE__, __LINE__, (exp), (act)); failures++; } }while(0)
+
+/** Muestra el resultado de la prueba
+ *  @return Código de salida del proceso: 0 si no ha habido errores
+ */
+static inline int hostTestResult(){
+	printf("%s %s (%d errores)\n", _MODULE_, (failures == 0)? "OK" : "FAIL", failures);
+	return (failures == 0)? 0 : 1;
+}
+
+#endif
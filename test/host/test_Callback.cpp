@@ -0,0 +1,270 @@
+/* test_Callback
+
+   Host test and benchmark of the variadic Callback: API compatibility with the callback() helpers, inline storage of
+   capturing lambdas, move semantics, call overhead and construction cost. Also FunctionRef and BoundCallback.
+   Build and run on Linux with: make -C test/host
+*/
+
+//------------------------------------------------------------------------------------
+//-- REQUIRED HEADERS & COMPONENTS FOR TESTING ---------------------------------------
+//------------------------------------------------------------------------------------
+
+#include "Callback.h"
+#include "FunctionRef.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <utility>
+static const char* _MODULE_ = "[TEST_Callback]";
+#include "HostTest.h"
+
+
+//------------------------------------------------------------------------------------
+static int counter = 0;
+static void increment(){ counter++; }
+static int add(int a, int b){ return a + b; }
+static int sum6(int a, int b, int c, int d, int e, int f){ return a + b + c + d + e + f; }
+static int boundAdd(int* base, int a){ return *base + a; }
+static int constBoundAdd(const int* base, int a){ return *base + a; }
+
+struct Counter {
+	int value;
+	Counter() : value(0) {}
+	void inc(){ value++; }
+	int get() const { return value; }
+	int add(int a) volatile { return value += a; }
+};
+
+/** Functor que cuenta sus copias y destrucciones */
+struct Tracked {
+	static int alive;
+	int* target;
+	Tracked(int* t) : target(t) { alive++; }
+	Tracked(const Tracked& o) : target(o.target) { alive++; }
+	~Tracked(){ alive--; }
+	void operator()() const { (*target)++; }
+};
+int Tracked::alive = 0;
+
+
+//------------------------------------------------------------------------------------
+static void testCompatibility(){
+	counter = 0;
+	Callback<void()> cb = callback(increment);
+	cb();
+	cb.call();
+	TEST_ASSERT_EQUAL(2, counter);
+
+	Callback<int(int, int)> cadd = callback(add);
+	TEST_ASSERT_EQUAL(5, cadd(2, 3));
+	Callback<int(int, int, int, int, int, int)> c6 = callback(sum6);
+	TEST_ASSERT_EQUAL(21, c6(1, 2, 3, 4, 5, 6));
+
+	Counter obj;
+	callback(&obj, &Counter::inc)();
+	TEST_ASSERT_EQUAL(1, callback((const Counter*)&obj, &Counter::get)());
+	TEST_ASSERT_EQUAL(4, callback((volatile Counter*)&obj, &Counter::add)(3));
+
+	int base = 10;
+	TEST_ASSERT_EQUAL(15, callback(boundAdd, &base)(5));
+	TEST_ASSERT_EQUAL(16, callback(constBoundAdd, (const int*)&base)(6));
+
+	// NULL, comparaciones y thunk
+	Callback<void()> empty = (Callback<void()>)NULL;
+	TEST_ASSERT(!empty);
+	TEST_ASSERT(empty == (Callback<void()>)NULL);
+	TEST_ASSERT(cb != empty);
+	TEST_ASSERT(cb == callback(increment));
+	Callback<void()> copy = cb;
+	TEST_ASSERT(copy == cb);
+	Callback<void()>::thunk(&copy);
+	TEST_ASSERT_EQUAL(3, counter);
+	Callback<void(int)> ev;
+	event_callback_t ev2 = ev;
+	TEST_ASSERT(!ev2);
+}
+
+
+//------------------------------------------------------------------------------------
+static void testLambdas(){
+	// lambdas con captura de hasta MBED_CALLBACK_INLINE_WORDS punteros, sin reserva en heap
+	int a = 1, b = 2, c = 3;
+	int* pa = &a; int* pb = &b; int* pc = &c;
+	Callback<int()> l1 = [pa]() { return *pa; };
+	Callback<int()> l3 = [pa, pb, pc]() { return *pa + *pb + *pc; };
+	TEST_ASSERT_EQUAL(1, l1());
+	TEST_ASSERT_EQUAL(6, l3());
+	TEST_ASSERT(sizeof(Callback<int()>) == sizeof(void*) * ((MBED_CALLBACK_INLINE_WORDS > 3)? 5 : 4));
+#if MBED_CALLBACK_INLINE_WORDS >= 4
+	int d = 4;
+	int* pd = &d;
+	Callback<int()> l4 = [pa, pb, pc, pd]() { return *pa + *pb + *pc + *pd; };
+	TEST_ASSERT_EQUAL(10, l4());
+#endif
+#if MBED_CALLBACK_HEAP_FALLBACK
+	// no cabe en la reserva interna: se almacena en heap
+	char big[64];
+	memset(big, 7, sizeof(big));
+	Callback<int()> lbig = [big]() { return (int)big[63]; };
+	Callback<int()> lbig2 = lbig;
+	Callback<int()> lbig3 = std::move(lbig);
+	TEST_ASSERT(!lbig);
+	TEST_ASSERT_EQUAL(7, lbig2());
+	TEST_ASSERT_EQUAL(7, lbig3());
+	// las copias se comparan por el objeto, no por su dirección en heap
+	TEST_ASSERT(lbig2.heap_allocated());
+	TEST_ASSERT(lbig2 == lbig3);
+	big[0] = 1;
+	Callback<int()> lother = [big]() { return (int)big[63]; };
+	TEST_ASSERT(lother != lbig2);
+#endif
+	TEST_ASSERT(!l1.heap_allocated());
+
+	// deducción del tipo con callback()
+	int k = 5;
+	auto lk = callback([k](int x) { return k * x; });
+	TEST_ASSERT_EQUAL(15, lk(3));
+
+	// lambda mutable
+	Callback<int()> seq = [k]() mutable { return k++; };
+	TEST_ASSERT_EQUAL(5, seq());
+	TEST_ASSERT_EQUAL(6, seq());
+}
+
+
+//------------------------------------------------------------------------------------
+static void testMoveSemantics(){
+	int hits = 0;
+	Tracked::alive = 0;
+	{
+		Callback<void()> a = Tracked(&hits);
+		TEST_ASSERT_EQUAL(1, Tracked::alive);
+		Callback<void()> b = a;
+		TEST_ASSERT_EQUAL(2, Tracked::alive);
+		Callback<void()> c = std::move(a);
+		TEST_ASSERT(!a);
+		TEST_ASSERT_EQUAL(2, Tracked::alive);
+		c();
+		b();
+		TEST_ASSERT_EQUAL(2, hits);
+		b = std::move(c);
+		TEST_ASSERT(!c);
+		TEST_ASSERT_EQUAL(1, Tracked::alive);
+		b = callback(increment);
+		TEST_ASSERT_EQUAL(0, Tracked::alive);
+	}
+	TEST_ASSERT_EQUAL(0, Tracked::alive);
+}
+
+
+//------------------------------------------------------------------------------------
+/** Sobrecargas como las de Ticker e InterruptIn: cada argumento debe elegir la suya sin ambigüedad */
+static int takes(Callback<void()> cb){ return 1; }
+static int takes(FunctionRef<void()> ref){ return 2; }
+template <typename M, M Method>
+static int takes(const BoundCallback<M, Method>& bound){ return 3; }
+
+static void testFunctionRef(){
+	counter = 0;
+	FunctionRef<void()> empty;
+	TEST_ASSERT(!empty);
+	FunctionRef<void()> fref(increment);
+	TEST_ASSERT(fref);
+	fref();
+	TEST_ASSERT_EQUAL(1, counter);
+	TEST_ASSERT(fref == FunctionRef<void()>(increment));
+	TEST_ASSERT(fref != empty);
+
+	// referencia a funtores y a Callbacks, sin copiarlos
+	int hits = 0;
+	auto lambda = [&hits](int a) { hits += a; };
+	FunctionRef<void(int)> lref(lambda);
+	lref(3);
+	lref.call(4);
+	TEST_ASSERT_EQUAL(7, hits);
+	Callback<int(int, int)> cadd = callback(add);
+	FunctionRef<int(int, int)> cref(cadd);
+	TEST_ASSERT_EQUAL(9, cref(4, 5));
+
+	// métodos ligados en compilación, directos y a través de FunctionRef
+	Counter obj;
+	BoundCallback<void (Counter::*)(), &Counter::inc> bound(&obj);
+	bound();
+	FunctionRef<void()> bref = bound;
+	bref();
+	TEST_ASSERT_EQUAL(2, obj.value);
+	TEST_ASSERT(bound.object() == &obj);
+	const Counter& cobj = obj;
+	TEST_ASSERT_EQUAL(2, MBED_BOUND_CALLBACK(&cobj, &Counter::get)());
+	FunctionRef<int()> cget = MBED_BOUND_CALLBACK(&cobj, &Counter::get);
+	TEST_ASSERT_EQUAL(2, cget());
+
+	TEST_ASSERT_EQUAL(1, takes(increment));
+	TEST_ASSERT_EQUAL(1, takes([&hits]() { hits++; }));
+	TEST_ASSERT_EQUAL(1, takes(callback(&obj, &Counter::inc)));
+	TEST_ASSERT_EQUAL(2, takes(bref));
+	TEST_ASSERT_EQUAL(2, takes(FunctionRef<void()>(increment)));
+	TEST_ASSERT_EQUAL(3, takes(bound));
+}
+
+
+//------------------------------------------------------------------------------------
+static uint64_t nowNs(){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static volatile int sink = 0;
+static void benchTarget(){ sink++; }
+
+/** Coste medio de llamada y construcción+copia, en ns */
+static void benchmark(){
+	static const int Loops = 10000000;
+	Counter obj;
+	Callback<void()> cbs[3] = { callback(benchTarget), callback(&obj, &Counter::inc), [&obj]() { obj.value++; } };
+	const char* names[3] = {"function", "method", "lambda"};
+	for(int n = 0; n < 3; n++){
+		Callback<void()>* volatile pcb = &cbs[n];
+		uint64_t t0 = nowNs();
+		for(int i = 0; i < Loops; i++){
+			pcb->call();
+		}
+		uint64_t t1 = nowNs();
+		for(int i = 0; i < Loops; i++){
+			Callback<void()> copy(*pcb);
+			sink += (bool)copy;
+		}
+		uint64_t t2 = nowNs();
+		printf("%s %-8s call %.2f ns, copy %.2f ns\n", _MODULE_, names[n], (double)(t1 - t0) / Loops, (double)(t2 - t1) / Loops);
+	}
+	// referencias: sin tabla de operaciones, la copia son dos palabras
+	BoundCallback<void (Counter::*)(), &Counter::inc> bound(&obj);
+	FunctionRef<void()> refs[2] = { FunctionRef<void()>(benchTarget), bound };
+	const char* ref_names[2] = {"fref", "bound"};
+	for(int n = 0; n < 2; n++){
+		FunctionRef<void()>* volatile pref = &refs[n];
+		uint64_t t0 = nowNs();
+		for(int i = 0; i < Loops; i++){
+			pref->call();
+		}
+		uint64_t t1 = nowNs();
+		for(int i = 0; i < Loops; i++){
+			FunctionRef<void()> copy(*pref);
+			sink += (bool)copy;
+		}
+		uint64_t t2 = nowNs();
+		printf("%s %-8s call %.2f ns, copy %.2f ns\n", _MODULE_, ref_names[n], (double)(t1 - t0) / Loops, (double)(t2 - t1) / Loops);
+	}
+}
+
+
+//------------------------------------------------------------------------------------
+int main(){
+	testCompatibility();
+	testLambdas();
+	testMoveSemantics();
+	testFunctionRef();
+	benchmark();
+	return hostTestResult();
+}
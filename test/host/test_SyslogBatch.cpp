@@ -0,0 +1,221 @@
+/* test_SyslogBatch
+
+   Host test and benchmark of the batching syslog core: frames closed by size and by age, per-tag rate limiting,
+   drop reporting when every frame is pending, and throughput in messages per second through a local stand-in sink.
+   Build and run on Linux with: make -C test/host
+*/
+
+//------------------------------------------------------------------------------------
+//-- REQUIRED HEADERS & COMPONENTS FOR TESTING ---------------------------------------
+//------------------------------------------------------------------------------------
+
+#include "SyslogBatchCore.h"
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+static const char* _MODULE_ = "[TEST_SyslogBatch]";
+#include "HostTest.h"
+
+
+//------------------------------------------------------------------------------------
+/** Destino local en lugar de syslog remoto: cuenta tramas, bytes y líneas, y guarda la última trama */
+struct LocalSink {
+	uint32_t frames;
+	uint32_t bytes;
+	uint32_t lines;
+	char last[SyslogBatchCore::FrameSize + 1];
+	LocalSink() { reset(); }
+	void reset() { frames = 0; bytes = 0; lines = 0; last[0] = 0; }
+	void send(const char* data, uint32_t len){
+		frames++;
+		bytes += len;
+		for(uint32_t i = 0; i < len; i++){
+			lines += (data[i] == '\n');
+		}
+		memcpy(last, data, len);
+		last[len] = 0;
+	}
+};
+
+/** Entrega al destino todas las tramas disponibles, como el thread de SyslogBatch */
+static int drain(SyslogBatchCore& core, LocalSink& sink, uint32_t now){
+	int n = 0;
+	while(SyslogBatchCore::Frame_t* f = core.next(now)){
+		sink.send(f->data, f->len);
+		core.release(f);
+		n++;
+	}
+	return n;
+}
+
+/** Formatea y registra una traza, como SyslogBatch::print */
+static SyslogBatchCore::Result print(SyslogBatchCore& core, uint32_t now, const char* level, const char* tag, const char* format, ...){
+	SyslogBatchCore::Result res = core.admit(tag, now);
+	if(res != SyslogBatchCore::Accepted){
+		return res;
+	}
+	char line[160];
+	int n = snprintf(line, sizeof(line) - 1, "%s %s ", level, tag);
+	va_list args;
+	va_start(args, format);
+	int m = vsnprintf(&line[n], sizeof(line) - 1 - n, format, args);
+	va_end(args);
+	n += (m < (int)sizeof(line) - 1 - n)? m : (int)sizeof(line) - 2 - n;
+	line[n++] = '\n';
+	return core.append(line, n, now);
+}
+
+
+//------------------------------------------------------------------------------------
+static void testFraming(){
+	SyslogBatchCore core(0, 0, 100);
+	LocalSink sink;
+
+	// una traza no se envía hasta que la trama se llena o envejece
+	TEST_ASSERT_EQUAL(SyslogBatchCore::Accepted, print(core, 0, "I", "[A]", "hola %d", 1));
+	TEST_ASSERT_EQUAL(0, drain(core, sink, 50));
+	TEST_ASSERT_EQUAL(1, drain(core, sink, 100));
+	TEST_ASSERT(strcmp(sink.last, "I [A] hola 1\n") == 0);
+
+	// por tamaño: cada trama contiene sólo trazas completas
+	sink.reset();
+	int records = 0;
+	while(core.pending() == 0){
+		print(core, 200, "D", "[B]", "registro numero %04d con relleno", records++);
+	}
+	TEST_ASSERT_EQUAL(1, drain(core, sink, 200));
+	TEST_ASSERT(sink.bytes <= SyslogBatchCore::FrameSize);
+	TEST_ASSERT_EQUAL(records - 1, sink.lines);
+	TEST_ASSERT(sink.last[strlen(sink.last) - 1] == '\n');
+
+	// close() adelanta el envío de la trama en curso
+	core.close();
+	TEST_ASSERT_EQUAL(1, drain(core, sink, 200));
+	TEST_ASSERT_EQUAL(records, sink.lines);
+
+	SyslogBatchCore::Stats_t stats;
+	core.getStats(&stats);
+	TEST_ASSERT_EQUAL(records + 1, stats.accepted);
+	TEST_ASSERT_EQUAL(3, stats.frames);
+}
+
+
+//------------------------------------------------------------------------------------
+static void testRateLimit(){
+	// 10 trazas/s por tag, ráfaga de 5
+	SyslogBatchCore core(10, 5, 100);
+	int ok = 0;
+	for(int i = 0; i < 20; i++){
+		ok += (print(core, 1000, "I", "[Ruidoso]", "spam %d", i) == SyslogBatchCore::Accepted);
+	}
+	TEST_ASSERT_EQUAL(5, ok);
+	TEST_ASSERT_EQUAL(15, core.tagDrops("[Ruidoso]"));
+
+	// otro tag no se ve afectado (se compara por contenido)
+	char tag[] = "[Tranquilo]";
+	TEST_ASSERT_EQUAL(SyslogBatchCore::Accepted, print(core, 1000, "I", tag, "ok"));
+	TEST_ASSERT_EQUAL(SyslogBatchCore::Accepted, print(core, 1000, "I", "[Tranquilo]", "ok"));
+	TEST_ASSERT_EQUAL(0, core.tagDrops("[Tranquilo]"));
+
+	// la tasa repone una traza cada 100 ms
+	TEST_ASSERT_EQUAL(SyslogBatchCore::DroppedRate, print(core, 1050, "I", "[Ruidoso]", "x"));
+	TEST_ASSERT_EQUAL(SyslogBatchCore::Accepted, print(core, 1150, "I", "[Ruidoso]", "x"));
+	TEST_ASSERT_EQUAL(SyslogBatchCore::DroppedRate, print(core, 1150, "I", "[Ruidoso]", "x"));
+
+	// más tags de los que tienen bucket propio (quedan MaxTags - 2): los 5 siguientes agotan la ráfaga del común
+	char tags[SyslogBatchCore::MaxTags + 4][16];
+	for(int i = 0; i < SyslogBatchCore::MaxTags + 4; i++){
+		snprintf(tags[i], sizeof(tags[i]), "[T%d]", i);
+		TEST_ASSERT_EQUAL((i < SyslogBatchCore::MaxTags + 3)? SyslogBatchCore::Accepted : SyslogBatchCore::DroppedRate, core.admit(tags[i], 2000));
+	}
+	TEST_ASSERT_EQUAL(0, core.tagDrops(tags[SyslogBatchCore::MaxTags + 3]));
+}
+
+
+//------------------------------------------------------------------------------------
+static void testBackpressure(){
+	// un destino que no envía: se agotan las tramas y se descarta sin bloquear
+	SyslogBatchCore core(0, 0, 100);
+	LocalSink sink;
+	int dropped = 0;
+	for(int i = 0; i < 200; i++){
+		dropped += (print(core, 0, "W", "[Lento]", "registro %d ..............................", i) == SyslogBatchCore::DroppedFull);
+	}
+	TEST_ASSERT(dropped > 0);
+	TEST_ASSERT_EQUAL(SyslogBatchCore::FrameCount, core.pending());
+	SyslogBatchCore::Stats_t stats;
+	core.getStats(&stats);
+	TEST_ASSERT_EQUAL(dropped, stats.dropped_full);
+	TEST_ASSERT_EQUAL(SyslogBatchCore::FrameCount, stats.max_pending);
+
+	// al liberarse una trama, la siguiente empieza con la línea de descartes
+	drain(core, sink, 0);
+	print(core, 10, "I", "[Lento]", "recuperado");
+	core.close();
+	drain(core, sink, 10);
+	char expected[128];
+	snprintf(expected, sizeof(expected), "W [SyslogBatch] Descartadas 0 por tasa, %d por tramas llenas, 0 desde ISR\nI [Lento] recuperado\n", dropped);
+	TEST_ASSERT(strcmp(sink.last, expected) == 0);
+	core.getStats(&stats);
+	TEST_ASSERT_EQUAL(1, stats.reports);
+
+	// los descartes desde ISR se notifican igual que el resto
+	core.dropIsr(3);
+	print(core, 20, "I", "[Lento]", "tras ISR");
+	core.close();
+	drain(core, sink, 20);
+	TEST_ASSERT(strcmp(sink.last, "W [SyslogBatch] Descartadas 0 por tasa, 0 por tramas llenas, 3 desde ISR\nI [Lento] tras ISR\n") == 0);
+	core.getStats(&stats);
+	TEST_ASSERT_EQUAL(3, stats.dropped_isr);
+	TEST_ASSERT_EQUAL(2, stats.reports);
+}
+
+
+//------------------------------------------------------------------------------------
+static uint64_t nowNs(){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/** Mensajes por segundo a través del destino local: formateo, limitación de tasa, copia y entrega de tramas */
+static void benchmark(){
+	static const int Loops = 2000000;
+	static const char* tags[4] = {"[I2C]...........", "[Serial]........", "[RawSerial].....", "[RtosTimer]....."};
+	SyslogBatchCore core(0, 0, 100);
+	LocalSink sink;
+	uint64_t t0 = nowNs();
+	for(int i = 0; i < Loops; i++){
+		print(core, 0, "D", tags[i & 3], "Escribiendo %d bytes: result %d, ", i & 0xff, 0);
+		if(core.pending()){
+			drain(core, sink, 0);
+		}
+	}
+	uint64_t t1 = nowNs();
+	uint32_t frames = sink.frames;
+
+	SyslogBatchCore limited(1000, 100, 100);
+	uint64_t t2 = nowNs();
+	for(int i = 0; i < Loops; i++){
+		print(limited, i / 1000, "D", tags[i & 3], "Escribiendo %d bytes: result %d, ", i & 0xff, 0);
+		if(limited.pending()){
+			drain(limited, sink, i / 1000);
+		}
+	}
+	uint64_t t3 = nowNs();
+	SyslogBatchCore::Stats_t stats;
+	limited.getStats(&stats);
+	printf("%s %.0f msg/s (%d por trama), con limitación de tasa %.0f msg/s (%u descartadas)\n", _MODULE_,
+			Loops * 1e9 / (t1 - t0), (int)(Loops / (frames? frames : 1)), Loops * 1e9 / (t3 - t2), stats.dropped_rate);
+}
+
+
+//------------------------------------------------------------------------------------
+int main(){
+	testFraming();
+	testRateLimit();
+	testBackpressure();
+	benchmark();
+	return hostTestResult();
+}
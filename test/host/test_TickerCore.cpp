@@ -0,0 +1,256 @@
+/* test_TickerCore
+
+   Host test and benchmark of the Ticker_HAL scheduler core (TickerCore) driven by a virtual clock (TickerVirtual).
+   Build and run on Linux with: make -C test/host
+*/
+
+//------------------------------------------------------------------------------------
+//-- REQUIRED HEADERS & COMPONENTS FOR TESTING ---------------------------------------
+//------------------------------------------------------------------------------------
+
+#include "TickerVirtual.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+static const char* _MODULE_ = "[TEST_TickerCore]";
+#include "HostTest.h"
+
+/** Ticker de prueba con los campos requeridos por TickerCore */
+struct Node {
+	uint64_t next_event;
+	uint64_t timeout;
+	uint64_t slack;
+	int32_t heap_idx;
+	bool oneshot;
+	TickerCore::OverrunPolicy overrun;
+	uint32_t late_fires;
+	uint32_t max_lateness;
+	uint32_t skipped;
+	uint32_t fires;				/// Disparos recibidos
+	uint64_t expected;			/// Instante esperado del siguiente disparo
+	uint64_t work;				/// Duración simulada de la callback (en ticks)
+	uint32_t work_at;			/// Disparo en el que se simula la duración (0: todos)
+};
+
+typedef TickerVirtualTimer<0> Clock;
+static const int Capacity = 4096;
+typedef TickerVirtual<Node, Capacity, Clock> Scheduler;
+
+static void initNode(Node* n, uint64_t timeout, uint64_t slack = 0, bool oneshot = false){
+	memset(n, 0, sizeof(Node));
+	n->heap_idx = -1;
+	n->timeout = timeout;
+	n->slack = slack;
+	n->oneshot = oneshot;
+	n->overrun = TickerCore::OverrunSkip;
+	n->next_event = Clock::counter() + timeout;
+	n->expected = n->next_event;
+}
+
+static uint64_t last_fire = 0;
+static uint32_t order_errors = 0;
+static uint32_t time_errors = 0;
+static void onFire(Node* n){
+	// los disparos se producen en orden cronológico y, sin holgura ni carga, en su instante exacto
+	if(Clock::counter() < last_fire){
+		order_errors++;
+	}
+	if(n->slack == 0 && n->work == 0 && Clock::counter() != n->expected){
+		time_errors++;
+	}
+	last_fire = Clock::counter();
+	n->expected += n->timeout;
+	n->fires++;
+	if(n->work > 0 && (n->work_at == 0 || n->fires == n->work_at)){
+		Clock::set(Clock::counter() + n->work);
+	}
+}
+
+static uint32_t seed = 12345;
+static uint32_t rnd(uint32_t range){
+	seed = (seed * 1103515245) + 12345;
+	return (seed >> 8) % range;
+}
+
+
+//---------------------------------------------------------------------------
+static void TEST_TickerCore_ordering(){
+	static Node nodes[100];
+	Scheduler sched(&onFire);
+	last_fire = 0;
+	order_errors = 0;
+	time_errors = 0;
+	for(int i = 0; i < 100; i++){
+		initNode(&nodes[i], 100 + rnd(10000));
+		TEST_ASSERT(sched.attach(&nodes[i]));
+	}
+	sched.advance(1000000);
+	TEST_ASSERT_EQUAL(0, order_errors);
+	TEST_ASSERT_EQUAL(0, time_errors);
+	for(int i = 0; i < 100; i++){
+		TEST_ASSERT_EQUAL(1000000 / nodes[i].timeout, nodes[i].fires);
+	}
+	// desinstala la mitad: dejan de dispararse
+	for(int i = 0; i < 100; i += 2){
+		sched.detach(&nodes[i]);
+		nodes[i].fires = 0;
+	}
+	TEST_ASSERT_EQUAL(50, sched.count());
+	sched.advance(1000000);
+	for(int i = 0; i < 100; i += 2){
+		TEST_ASSERT_EQUAL(0, nodes[i].fires);
+	}
+	TEST_ASSERT_EQUAL(0, order_errors);
+}
+
+
+//---------------------------------------------------------------------------
+static void TEST_TickerCore_drift(){
+	// periodo de 1000 ticks con callbacks de 300 ticks: el siguiente evento se calcula desde el anterior
+	Node n;
+	Scheduler sched(&onFire);
+	initNode(&n, 1000);
+	n.work = 300;
+	sched.attach(&n);
+	sched.advance(1000000);
+	TEST_ASSERT_EQUAL(1000, n.fires);
+	TEST_ASSERT_EQUAL(1001000, n.next_event);
+	TEST_ASSERT_EQUAL(0, n.late_fires);
+	TEST_ASSERT_EQUAL(0, n.skipped);
+}
+
+
+//---------------------------------------------------------------------------
+static void runOverrun(TickerCore::OverrunPolicy policy, Node* n, uint64_t work = 3500){
+	// el quinto disparo (t=5000) dura 3500 ticks: el evento de 6000 se ejecuta con retraso en 8500 y los de 7000 y
+	// 8000 se descartan, se ejecutan también en 8500 o se sustituyen por uno a contar desde 8500, según la política
+	Scheduler sched(&onFire);
+	initNode(n, 1000);
+	n->overrun = policy;
+	n->work = work;
+	n->work_at = 5;
+	sched.attach(n);
+	sched.advance(10000);
+}
+
+static void TEST_TickerCore_overrun_policy(){
+	Node n;
+	runOverrun(TickerCore::OverrunSkip, &n);
+	TEST_ASSERT_EQUAL(8, n.fires);
+	TEST_ASSERT_EQUAL(2, n.skipped);
+	TEST_ASSERT_EQUAL(11000, n.next_event);
+
+	runOverrun(TickerCore::OverrunCatchUp, &n);
+	TEST_ASSERT_EQUAL(10, n.fires);
+	TEST_ASSERT_EQUAL(0, n.skipped);
+	TEST_ASSERT_EQUAL(3, n.late_fires);
+	TEST_ASSERT_EQUAL(2500, n.max_lateness);
+
+	runOverrun(TickerCore::OverrunFireOnce, &n);
+	TEST_ASSERT_EQUAL(7, n.fires);
+	TEST_ASSERT_EQUAL(10500, n.next_event);
+}
+
+
+//---------------------------------------------------------------------------
+static void TEST_TickerCore_overrun_on_deadline(){
+	// el quinto disparo (t=5000) termina exactamente en t=7000: el evento de 6000 se ejecuta con retraso y el de
+	// 7000 está en hora, por lo que ninguna política lo descarta ni lo desplaza
+	Node n;
+	runOverrun(TickerCore::OverrunSkip, &n, 2000);
+	TEST_ASSERT_EQUAL(10, n.fires);
+	TEST_ASSERT_EQUAL(0, n.skipped);
+	TEST_ASSERT_EQUAL(11000, n.next_event);
+
+	runOverrun(TickerCore::OverrunFireOnce, &n, 2000);
+	TEST_ASSERT_EQUAL(10, n.fires);
+	TEST_ASSERT_EQUAL(11000, n.next_event);
+}
+
+
+//---------------------------------------------------------------------------
+static uint32_t runSlack(uint64_t slack, uint32_t* fires){
+	static Node nodes[50];
+	Scheduler sched(&onFire);
+	for(int i = 0; i < 50; i++){
+		initNode(&nodes[i], 10000 + (i * 37), slack);
+		sched.attach(&nodes[i]);
+	}
+	sched.advance(10000000);
+	*fires = sched.fireCount();
+	return sched.isrCount();
+}
+
+static void TEST_TickerCore_slack(){
+	uint32_t exact_fires, slack_fires;
+	uint32_t exact_isr = runSlack(0, &exact_fires);
+	uint32_t slack_isr = runSlack(5000, &slack_fires);
+	printf("%s 50 tickers: sin holgura %u ISR (%u disparos), con holgura %u ISR (%u disparos)\n", _MODULE_, exact_isr, exact_fires, slack_isr, slack_fires);
+	TEST_ASSERT(slack_isr < exact_isr);
+	// la holgura retrasa los disparos dentro de su ventana, pero no los descarta
+	TEST_ASSERT(slack_fires + 50 >= exact_fires);
+}
+
+
+//---------------------------------------------------------------------------
+static void TEST_TickerCore_oneshot(){
+	Node n, p;
+	Scheduler sched(&onFire);
+	initNode(&n, 500, 0, true);
+	initNode(&p, 100);
+	sched.attach(&n);
+	sched.attach(&p);
+	sched.advance(2000);
+	TEST_ASSERT_EQUAL(1, n.fires);
+	TEST_ASSERT_EQUAL(-1, n.heap_idx);
+	TEST_ASSERT_EQUAL(1, sched.count());
+	// rearme tras vencer
+	n.next_event = Clock::counter() + 500;
+	n.expected = n.next_event;
+	sched.attach(&n);
+	sched.advance(2000);
+	TEST_ASSERT_EQUAL(2, n.fires);
+	TEST_ASSERT_EQUAL(40, p.fires);
+}
+
+
+//---------------------------------------------------------------------------
+/** Benchmark de escalabilidad: coste por disparo con distinto número de tickers instalados */
+static const int BenchTickers[] = {16, 256, 4096};
+
+static void nopFire(Node* n){
+	n->fires++;
+}
+
+static void TEST_TickerCore_benchmark(){
+	static Node nodes[Capacity];
+	for(unsigned b = 0; b < sizeof(BenchTickers)/sizeof(BenchTickers[0]); b++){
+		int count = BenchTickers[b];
+		Scheduler sched(&nopFire);
+		for(int i = 0; i < count; i++){
+			initNode(&nodes[i], 1000 + rnd(100000));
+			sched.attach(&nodes[i]);
+		}
+		struct timespec t0, t1;
+		clock_gettime(CLOCK_MONOTONIC, &t0);
+		sched.advance(100000000);
+		clock_gettime(CLOCK_MONOTONIC, &t1);
+		uint64_t ns = ((uint64_t)(t1.tv_sec - t0.tv_sec) * 1000000000) + t1.tv_nsec - t0.tv_nsec;
+		TEST_ASSERT(sched.fireCount() > 0);
+		printf("%s %d tickers: %u disparos, %u ISR, %llu ns/disparo\n", _MODULE_, count, sched.fireCount(), sched.isrCount(),
+				(unsigned long long)(ns / sched.fireCount()));
+	}
+}
+
+
+//---------------------------------------------------------------------------
+int main(){
+	TEST_TickerCore_ordering();
+	TEST_TickerCore_drift();
+	TEST_TickerCore_overrun_policy();
+	TEST_TickerCore_overrun_on_deadline();
+	TEST_TickerCore_slack();
+	TEST_TickerCore_oneshot();
+	TEST_TickerCore_benchmark();
+	return hostTestResult();
+}
@@ -0,0 +1,163 @@
+/* test_TraceFormat
+
+   Host test and benchmark of the deferred trace format core: encode -> decode -> format round trip compared against
+   snprintf, type-driven length modifiers, string truncation, and the cost of capturing a record versus formatting it.
+   Build and run on Linux with: make -C test/host
+*/
+
+//------------------------------------------------------------------------------------
+//-- REQUIRED HEADERS & COMPONENTS FOR TESTING ---------------------------------------
+//------------------------------------------------------------------------------------
+
+#include "TraceFormat.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+static const char* _MODULE_ = "[TEST_TraceFormat]";
+#include "HostTest.h"
+
+
+//------------------------------------------------------------------------------------
+/** Captura, codifica en un buffer, decodifica y formatea, como hace TraceLog */
+template <typename... ArgTs>
+static int roundTrip(char* out, size_t size, const char* fmt, ArgTs... args){
+	TraceFormat::Arg_t list[sizeof...(ArgTs) + 1] = { TraceFormat::arg(args)... };
+	const int nargs = sizeof...(ArgTs);
+	uint8_t lens[8];
+	uint8_t buf[256];
+	uint32_t len = TraceFormat::encodedSize(list, nargs, lens);
+	if(len > sizeof(buf)){
+		return -1;
+	}
+	TraceFormat::encode(buf, list, nargs, lens);
+	// se sobrescriben los originales para asegurar que nada apunta fuera del registro
+	TraceFormat::Arg_t decoded[8];
+	memset(decoded, 0xa5, sizeof(decoded));
+	TraceFormat::decode(buf, nargs, decoded);
+	return TraceFormat::format(out, size, fmt, decoded, nargs);
+}
+
+/** Compara con snprintf */
+#define CHECK_SAME(fmt, ...) do{ \
+	char exp[160], act[160]; \
+	snprintf(exp, sizeof(exp), fmt, ##__VA_ARGS__); \
+	roundTrip(act, sizeof(act), fmt, ##__VA_ARGS__); \
+	TEST_ASSERT_EQUAL_STRING(exp, act); \
+}while(0)
+
+
+//------------------------------------------------------------------------------------
+static void testPrintfCompatibility(){
+	CHECK_SAME("sin argumentos");
+	CHECK_SAME("100%% ok");
+	CHECK_SAME("d=%d i=%i u=%u x=%x X=%X o=%o", -5, 7, 4000000000u, 0xbeef, 0xcafe, 8);
+	CHECK_SAME("c=%c '%5d' '%-5d' '%05d' '%+d' '% d'", 'z', 42, 42, 42, 42, 42);
+	CHECK_SAME("h=%hhu %hd", (unsigned char)200, (short)-3);
+	CHECK_SAME("ll=%lld llu=%llu llx=%llx", -1234567890123LL, 18446744073709551615ULL, 0x123456789abcULL);
+	CHECK_SAME("f=%f %.2f %8.3f %e %g", 3.14159, 2.5f, -1.0, 12345.678, 0.0001);
+	CHECK_SAME("s='%s' '%10s' '%-6s|' '%.3s'", "hola", "der", "izq", "truncado");
+	CHECK_SAME("*: '%*d' '%-*d' '%.*f'", 6, 12, 4, 3, 2, 1.23456);
+	CHECK_SAME("mixto %s=%d (%.1f%%) %s", "rssi", -71, 87.5, "ok");
+	int v = 0;
+	CHECK_SAME("p=%p", (void*)&v);
+}
+
+
+//------------------------------------------------------------------------------------
+static void testTypeDriven(){
+	char out[160];
+	// un %d con un argumento de 64 bits no desalinea los siguientes
+	roundTrip(out, sizeof(out), "%d %d", (int64_t)5000000000LL, 7);
+	TEST_ASSERT_EQUAL_STRING("5000000000 7", out);
+	// un %lu con un argumento de 32 bits
+	roundTrip(out, sizeof(out), "%lu-%u", (uint32_t)9, 3u);
+	TEST_ASSERT_EQUAL_STRING("9-3", out);
+	// conversiones incompatibles o argumentos que faltan
+	roundTrip(out, sizeof(out), "%s %f %d", 3, "x");
+	TEST_ASSERT_EQUAL_STRING("? ? ?", out);
+	// cadena nula
+	roundTrip(out, sizeof(out), "[%s]", (const char*)0);
+	TEST_ASSERT_EQUAL_STRING("[]", out);
+	// formato acabado en '%'
+	roundTrip(out, sizeof(out), "fin %", 1);
+	TEST_ASSERT_EQUAL_STRING("fin ", out);
+}
+
+
+//------------------------------------------------------------------------------------
+static void testTruncation(){
+	char out[160];
+	// las cadenas se copian hasta MaxStringCopy caracteres
+	const char* longstr = "0123456789abcdefghijklmnopqrstuvwxyzABCDEF";
+	roundTrip(out, sizeof(out), "%s", longstr);
+	TEST_ASSERT(strlen(out) == TraceFormat::MaxStringCopy);
+	TEST_ASSERT(strncmp(out, longstr, TraceFormat::MaxStringCopy) == 0);
+
+	// el destino limita la salida, siempre terminada en '\0'
+	char small[8];
+	int n = roundTrip(small, sizeof(small), "valor=%d", 123456);
+	TEST_ASSERT(n == 7);
+	TEST_ASSERT_EQUAL_STRING("valor=1", small);
+	n = roundTrip(small, sizeof(small), "abcdefghij");
+	TEST_ASSERT(n == 7);
+	TEST_ASSERT_EQUAL_STRING("abcdefg", small);
+
+	// tamaño codificado: tipos alineados a 4, luego valores
+	TraceFormat::Arg_t list[3] = { TraceFormat::arg(1), TraceFormat::arg(2.0), TraceFormat::arg("abc") };
+	uint8_t lens[3];
+	TEST_ASSERT(TraceFormat::encodedSize(list, 3, lens) == 4 + 4 + 8 + 4 + 4);
+	TEST_ASSERT(lens[2] == 3);
+}
+
+
+//------------------------------------------------------------------------------------
+static uint64_t nowNs(){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static volatile uint32_t sink = 0;
+
+/** Coste de capturar y codificar una traza (punto de llamada) frente a formatearla (emisor o traza síncrona), en ns */
+static void benchmark(){
+	static const int Loops = 1000000;
+	static const char* fmt = "Evento %d en %s, valor=%.2f, cuenta=%u";
+	const char* volatile name = "sensor";
+	volatile int id = 17;
+	volatile double value = 3.25;
+	uint8_t buf[128];
+	char line[160];
+
+	uint64_t t0 = nowNs();
+	for(int i = 0; i < Loops; i++){
+		TraceFormat::Arg_t list[4] = { TraceFormat::arg((int)id), TraceFormat::arg((const char*)name), TraceFormat::arg((double)value), TraceFormat::arg((unsigned)i) };
+		uint8_t lens[4];
+		uint32_t len = TraceFormat::encodedSize(list, 4, lens);
+		TraceFormat::encode(buf, list, 4, lens);
+		sink += len + buf[0];
+	}
+	uint64_t t1 = nowNs();
+	for(int i = 0; i < Loops; i++){
+		TraceFormat::Arg_t list[4];
+		TraceFormat::decode(buf, 4, list);
+		sink += TraceFormat::format(line, sizeof(line), fmt, list, 4);
+	}
+	uint64_t t2 = nowNs();
+	for(int i = 0; i < Loops; i++){
+		sink += snprintf(line, sizeof(line), fmt, (int)id, (const char*)name, (double)value, (unsigned)i);
+	}
+	uint64_t t3 = nowNs();
+	printf("%s captura %.1f ns, formateo diferido %.1f ns, snprintf %.1f ns\n", _MODULE_,
+			(double)(t1 - t0) / Loops, (double)(t2 - t1) / Loops, (double)(t3 - t2) / Loops);
+}
+
+
+//------------------------------------------------------------------------------------
+int main(){
+	testPrintfCompatibility();
+	testTypeDriven();
+	testTruncation();
+	benchmark();
+	return hostTestResult();
+}
@@ -0,0 +1,155 @@
+/* test_CallChain
+
+   Unit test of CallChain: call order, add/remove semantics, and removal from threads on both cores while a
+   Ticker fires the chain from its ISR
+*/
+
+//------------------------------------------------------------------------------------
+//-- REQUIRED HEADERS & COMPONENTS FOR TESTING ---------------------------------------
+//------------------------------------------------------------------------------------
+
+#include "mbed.h"
+#include "unity.h"
+#include "AppConfig.h"
+#include <xtensa/hal.h>
+static const char* _MODULE_ = "[TEST_CallChain]";
+#define _EXPR_	(true)
+static bool _prerequisites_done=false;
+static void executePrerequisites(){
+	if(!_prerequisites_done){
+		_prerequisites_done=true;
+		esp_log_level_set(_MODULE_, ESP_LOG_DEBUG);
+		Ticker_HAL::start();
+	}
+}
+
+/** Observador que registra el orden de las llamadas y detecta las llamadas tras su eliminación */
+struct Observer {
+	static char order[8];
+	static volatile int pos;
+	static volatile uint32_t late_calls;
+	char id;
+	volatile bool removed;
+	volatile uint32_t calls;
+	CallChain::Link link;
+	Observer(char c) : id(c), removed(false), calls(0), link(callback(this, &Observer::onEvent)) {}
+	void onEvent(){
+		if(removed){
+			late_calls++;
+		}
+		calls++;
+		if(pos < (int)sizeof(order) - 1){
+			order[pos++] = id;
+		}
+	}
+};
+char Observer::order[8];
+volatile int Observer::pos = 0;
+volatile uint32_t Observer::late_calls = 0;
+
+
+//---------------------------------------------------------------------------
+TEST_CASE("TEST_CallChain_order", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    CallChain chain;
+    Observer a('a'), b('b'), c('c');
+    TEST_ASSERT_TRUE(chain.empty());
+    TEST_ASSERT_TRUE(chain.add(&a.link));
+    TEST_ASSERT_TRUE(chain.add(&b.link));
+    TEST_ASSERT_TRUE(chain.add(&c.link));
+    TEST_ASSERT_FALSE(chain.add(&b.link));
+    TEST_ASSERT_EQUAL(3, chain.size());
+
+    memset(Observer::order, 0, sizeof(Observer::order));
+    Observer::pos = 0;
+    chain.call();
+    TEST_ASSERT_EQUAL_STRING("abc", Observer::order);
+
+    TEST_ASSERT_TRUE(chain.remove(&b.link));
+    TEST_ASSERT_FALSE(chain.remove(&b.link));
+    TEST_ASSERT_TRUE(chain.add(&b.link));
+    chain();
+    TEST_ASSERT_EQUAL_STRING("abcacb", Observer::order);
+
+    // el destructor de la cadena desenlaza los que quedan
+    CallChain* tmp = new CallChain();
+    Observer d('d');
+    TEST_ASSERT_TRUE(tmp->add(&d.link));
+    delete(tmp);
+    TEST_ASSERT_NULL(d.link.chain);
+    TEST_ASSERT_TRUE(chain.remove(&a.link));
+    TEST_ASSERT_TRUE(chain.remove(&b.link));
+    TEST_ASSERT_TRUE(chain.remove(&c.link));
+}
+
+
+//---------------------------------------------------------------------------
+/** Hilos en ambos cores añaden y eliminan sus observadores mientras un Ticker dispara la cadena desde su ISR */
+static CallChain* stress_chain;
+static volatile int stress_done = 0;
+static void stressTask(void* arg){
+	Observer* obs = (Observer*)arg;
+	for(int i = 0; i < 200; i++){
+		obs->removed = false;
+		stress_chain->add(&obs->link);
+		Thread::wait(1);
+		stress_chain->remove(&obs->link);
+		// desde aquí no debe invocarse
+		obs->removed = true;
+		Thread::wait(1);
+	}
+	__atomic_add_fetch(&stress_done, 1, __ATOMIC_SEQ_CST);
+	vTaskDelete(NULL);
+}
+
+TEST_CASE("TEST_CallChain_isr_remove", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    static const int Observers = 4;
+    Observer* obs[Observers];
+    CallChain chain;
+    Observer fixed('f');
+    stress_chain = &chain;
+    stress_done = 0;
+    Observer::late_calls = 0;
+    chain.add(&fixed.link);
+
+    Ticker tick;
+    tick.attach_us(chain, 100);
+    for(int i = 0; i < Observers; i++){
+    	obs[i] = new Observer('0' + i);
+    	TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(stressTask, "chain", OS_STACK_SIZE, obs[i], osPriorityNormal, NULL, i % portNUM_PROCESSORS));
+    }
+    while(stress_done < Observers){
+    	Thread::wait(10);
+    }
+    tick.detach();
+    chain.remove(&fixed.link);
+
+    uint32_t calls = 0;
+    for(int i = 0; i < Observers; i++){
+    	calls += obs[i]->calls;
+    	delete(obs[i]);
+    }
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Disparos %d, llamadas a observadores %d, esperas en remove %d", fixed.calls, calls, chain.waits());
+    TEST_ASSERT_EQUAL(0, Observer::late_calls);
+    TEST_ASSERT_TRUE(fixed.calls > 0);
+    TEST_ASSERT_TRUE(calls > 0);
+}
+
+
+//---------------------------------------------------------------------------
+/** Varios observadores de un mismo flanco: se notifican tras la callback principal */
+TEST_CASE("TEST_CallChain_interruptin", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    InterruptIn in(GPIO_NUM_0);
+    Observer a('a'), b('b');
+    TEST_ASSERT_TRUE(in.fall_add(&a.link));
+    TEST_ASSERT_TRUE(in.fall_add(&b.link));
+    TEST_ASSERT_FALSE(in.rise_add(&a.link));
+    TEST_ASSERT_TRUE(in.fall_remove(&a.link));
+    TEST_ASSERT_FALSE(in.fall_remove(&a.link));
+    TEST_ASSERT_TRUE(in.fall_remove(&b.link));
+}
@@ -0,0 +1,104 @@
+/* test_FunctionRef
+
+   Unit test and benchmark of FunctionRef and BoundCallback: dispatch cost in cycles compared with Callback, and
+   Ticker attachment through a compile-time bound method
+*/
+
+//------------------------------------------------------------------------------------
+//-- REQUIRED HEADERS & COMPONENTS FOR TESTING ---------------------------------------
+//------------------------------------------------------------------------------------
+
+#include "mbed.h"
+#include "unity.h"
+#include "AppConfig.h"
+#include <xtensa/hal.h>
+static const char* _MODULE_ = "[TEST_FunctionRef]";
+#define _EXPR_	(true)
+static bool _prerequisites_done=false;
+static void executePrerequisites(){
+	if(!_prerequisites_done){
+		_prerequisites_done=true;
+		esp_log_level_set(_MODULE_, ESP_LOG_DEBUG);
+		Ticker_HAL::start();
+	}
+}
+
+static volatile uint32_t sink = 0;
+static void target(){ sink++; }
+
+/** Objeto con un método a ligar */
+struct Handler {
+	volatile uint32_t value;
+	Handler() : value(0) {}
+	void handle(){ value++; }
+};
+
+/** Coste medio de una llamada, en ciclos de CPU */
+template <typename F>
+static uint32_t callCycles(F* volatile f){
+	static const int Calls = 1000;
+	uint32_t state = portENTER_CRITICAL_NESTED();
+	uint32_t cycles = xthal_get_ccount();
+	for(int i = 0; i < Calls; i++){
+		f->call();
+	}
+	cycles = xthal_get_ccount() - cycles;
+	portEXIT_CRITICAL_NESTED(state);
+	return cycles / Calls;
+}
+
+
+//---------------------------------------------------------------------------
+TEST_CASE("TEST_FunctionRef_dispatch_cost", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    Handler h;
+    Callback<void()> cb_func = callback(target);
+    Callback<void()> cb_method = callback(&h, &Handler::handle);
+    Callback<void()> cb_lambda = [&h]() { h.value++; };
+    FunctionRef<void()> fref(target);
+    BoundCallback<void (Handler::*)(), &Handler::handle> bound(&h);
+    FunctionRef<void()> bref = bound;
+
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Callback: función %d ciclos, método %d ciclos, lambda %d ciclos",
+    		callCycles(&cb_func), callCycles(&cb_method), callCycles(&cb_lambda));
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "FunctionRef: función %d ciclos, BoundCallback %d ciclos (directa %d ciclos)",
+    		callCycles(&fref), callCycles(&bref), callCycles(&bound));
+    TEST_ASSERT_EQUAL(&h, bound.object());
+    TEST_ASSERT_TRUE(h.value > 0);
+}
+
+
+//---------------------------------------------------------------------------
+/** Ticker con un método ligado: la ISR lo invoca a través de la referencia */
+TEST_CASE("TEST_FunctionRef_ticker", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    Handler h;
+    Ticker tick;
+    tick.attach_us(MBED_BOUND_CALLBACK(&h, &Handler::handle), 1000);
+    Thread::wait(100);
+    tick.detach();
+    uint32_t fired = h.value;
+    TEST_ASSERT_UINT32_WITHIN(10, 100, fired);
+    Thread::wait(10);
+    TEST_ASSERT_EQUAL(fired, h.value);
+
+    // también en el thread de servicio y con FunctionRef a una función
+    sink = 0;
+    tick.set_dispatch(Ticker_HAL::DispatchThread);
+    tick.attach_us(FunctionRef<void()>(target), 1000);
+    Thread::wait(100);
+    tick.detach();
+    TEST_ASSERT_UINT32_WITHIN(10, 100, sink);
+
+    // una Callback posterior sustituye a la referencia
+    h.value = 0;
+    tick.set_dispatch(Ticker_HAL::DispatchISR);
+    tick.attach_us(callback(&h, &Handler::handle), 1000);
+    uint32_t refs = sink;
+    Thread::wait(50);
+    tick.detach();
+    TEST_ASSERT_EQUAL(refs, sink);
+    TEST_ASSERT_TRUE(h.value > 0);
+}
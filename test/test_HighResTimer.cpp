@@ -0,0 +1,162 @@
+/* test_HighResTimer
+
+   Unit test and benchmark of HighResTimer
+*/
+
+//------------------------------------------------------------------------------------
+//-- REQUIRED HEADERS & COMPONENTS FOR TESTING ---------------------------------------
+//------------------------------------------------------------------------------------
+
+#include "mbed.h"
+#include "HighResTimer.h"
+#include "unity.h"
+#include "AppConfig.h"
+#include <xtensa/hal.h>
+static const char* _MODULE_ = "[TEST_HighResTimer]";
+#define _EXPR_	(true)
+static bool _prerequisites_done=false;
+static void executePrerequisites(){
+	if(!_prerequisites_done){
+		_prerequisites_done=true;
+		esp_log_level_set(_MODULE_, ESP_LOG_DEBUG);
+		Ticker_HAL::start();
+	}
+}
+
+
+//---------------------------------------------------------------------------
+TEST_CASE("TEST_HighResTimer_lap_split", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    HighResTimer t(HighResTimer::SourceTimer);
+    TEST_ASSERT_EQUAL(Ticker_HAL::TimerScale, t.frequency());
+    TEST_ASSERT_EQUAL(0, t.elapsed_ticks());
+    t.start();
+    Thread::wait(20);
+    uint64_t lap1 = t.lap();
+    Thread::wait(40);
+    uint64_t split = t.split();
+    uint64_t lap2 = t.lap();
+    TEST_ASSERT_EQUAL(2, t.laps());
+    TEST_ASSERT_TRUE(lap2 >= (split - lap1));
+    TEST_ASSERT_UINT32_WITHIN(2000, 20000, (uint32_t)t.ticks_to_us(lap1));
+    TEST_ASSERT_UINT32_WITHIN(2000, 40000, (uint32_t)t.ticks_to_us(lap2));
+
+    // detenido no avanza, y al reanudar descuenta la parada
+    t.stop();
+    uint64_t stopped = t.elapsed_ticks();
+    Thread::wait(20);
+    TEST_ASSERT_EQUAL(stopped, t.elapsed_ticks());
+    t.start();
+    TEST_ASSERT_TRUE(t.elapsed_ticks() - stopped < (Ticker_HAL::TimerScale / 1000));
+    t.reset();
+    TEST_ASSERT_EQUAL(0, t.laps());
+}
+
+
+//---------------------------------------------------------------------------
+TEST_CASE("TEST_HighResTimer_conversions", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    HighResTimer cyc(HighResTimer::SourceCycles);
+    HighResTimer tim(HighResTimer::SourceTimer);
+    TEST_ASSERT_EQUAL(CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ * 1000000, cyc.frequency());
+    uint64_t sec = (uint64_t)CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ * 1000000;
+    TEST_ASSERT_TRUE(cyc.ticks_to_ns(sec) == 1000000000ULL);
+    TEST_ASSERT_TRUE(cyc.ticks_to_us(sec * 3600) == 3600000000ULL);
+    TEST_ASSERT_TRUE(tim.ticks_to_ns(Ticker_HAL::TimerScale) == 1000000000ULL);
+
+    // ambas fuentes miden lo mismo
+    cyc.start();
+    tim.start();
+    Thread::wait(100);
+    uint64_t cyc_us = cyc.elapsed_us();
+    uint64_t tim_us = tim.elapsed_us();
+    TEST_ASSERT_UINT32_WITHIN(10, (uint32_t)tim_us, (uint32_t)cyc_us);
+}
+
+
+//---------------------------------------------------------------------------
+/** Lecturas desde los dos cores: la marca de tiempo de un core debe ser posterior a la publicada por el otro */
+static portMUX_TYPE cross_mux = portMUX_INITIALIZER_UNLOCKED;
+static uint64_t published = 0;
+static volatile uint32_t cross_errors = 0;
+static volatile int cross_done = 0;
+static void crossCoreTask(void* arg){
+	for(int i = 0; i < 100000; i++){
+		portENTER_CRITICAL(&cross_mux);
+		uint64_t now = HighResTimer::cycles();
+		// tolerancia: error de calibración entre cores (cuantificación de la base común más la lectura)
+		if(now + 200 < published){
+			cross_errors++;
+		}
+		published = now;
+		portEXIT_CRITICAL(&cross_mux);
+	}
+	__atomic_add_fetch(&cross_done, 1, __ATOMIC_SEQ_CST);
+	vTaskDelete(NULL);
+}
+
+TEST_CASE("TEST_HighResTimer_cross_core", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    cross_errors = 0;
+    cross_done = 0;
+    for(int i = 0; i < portNUM_PROCESSORS; i++){
+    	TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(crossCoreTask, "hrt", OS_STACK_SIZE, NULL, osPriorityIdle + 1, NULL, i));
+    }
+    while(cross_done < portNUM_PROCESSORS){
+    	Thread::wait(10);
+    }
+    TEST_ASSERT_EQUAL(0, cross_errors);
+}
+
+
+//---------------------------------------------------------------------------
+TEST_CASE("TEST_HighResTimer_read_cost", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    static const int Reads = 1000;
+    HighResTimer cyc(HighResTimer::SourceCycles);
+    HighResTimer tim(HighResTimer::SourceTimer);
+    Timer timer;
+    cyc.start();
+    tim.start();
+    timer.start();
+    volatile uint64_t sink = 0;
+
+    uint32_t cycles = xthal_get_ccount();
+    for(int i = 0; i < Reads; i++){
+    	sink += cyc.elapsed_ticks();
+    }
+    uint32_t cyc_cost = (xthal_get_ccount() - cycles) / Reads;
+    cycles = xthal_get_ccount();
+    for(int i = 0; i < Reads; i++){
+    	sink += tim.elapsed_ticks();
+    }
+    uint32_t tim_cost = (xthal_get_ccount() - cycles) / Reads;
+    cycles = xthal_get_ccount();
+    for(int i = 0; i < Reads; i++){
+    	sink += timer.read_us();
+    }
+    uint32_t timer_cost = (xthal_get_ccount() - cycles) / Reads;
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Lectura: SourceCycles %d ciclos, SourceTimer %d ciclos, Timer::read_us %d ciclos", cyc_cost, tim_cost, timer_cost);
+    // CCOUNT sólo consulta la base común al desbordar
+    TEST_ASSERT_TRUE(cyc_cost < tim_cost);
+}
+
+
+//---------------------------------------------------------------------------
+/** Sin lecturas durante más de un desbordamiento completo de CCOUNT, la extensión a 64 bits sigue a la base común */
+TEST_CASE("TEST_HighResTimer_ccount_wrap", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    uint64_t cyc0 = HighResTimer::cycles();
+    uint64_t tim0 = Ticker_HAL::now_ticks();
+    Thread::wait((uint32_t)((1ULL << 32) / (CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ * 1000)) + 1000);
+    uint64_t cyc = HighResTimer::cycles() - cyc0;
+    uint64_t tim = (Ticker_HAL::now_ticks() - tim0) * Ticker_HAL::CyclesPerTick;
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Tras %d ms: diferencia %d ciclos", (int)(tim / (CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ * 1000)), (int)(cyc - tim));
+    TEST_ASSERT_TRUE(cyc > (1ULL << 32));
+    TEST_ASSERT_UINT32_WITHIN(1000, 0, (uint32_t)((cyc > tim)? (cyc - tim) : (tim - cyc)));
+}
@@ -0,0 +1,154 @@
+/* test_Notifier
+
+   Unit test and benchmark of MBED-API Notifier ESP32 porting
+*/
+
+//------------------------------------------------------------------------------------
+//-- REQUIRED HEADERS & COMPONENTS FOR TESTING ---------------------------------------
+//------------------------------------------------------------------------------------
+
+#include "mbed.h"
+#include "unity.h"
+#include "AppConfig.h"
+static const char* _MODULE_ = "[TEST_Notifier]..";
+#define _EXPR_	(true)
+static bool _prerequisites_done=false;
+static void executePrerequisites(){
+	if(!_prerequisites_done){
+		_prerequisites_done=true;
+		esp_log_level_set(_MODULE_, ESP_LOG_DEBUG);
+		DEBUG_TRACE_I(_EXPR_, _MODULE_, "Iniciando Ticker_HAL");
+		Ticker_HAL::start();
+	}
+}
+
+/** Número de muestras por benchmark */
+static const int NumSamples = 200;
+
+static Notifier* ntf;
+static Semaphore* sem;
+static volatile uint64_t give_time = 0;
+static volatile uint64_t lat_min, lat_max, lat_sum;
+static volatile int samples = 0;
+
+static void resetStats(){
+	lat_min = UINT64_MAX;
+	lat_max = 0;
+	lat_sum = 0;
+	samples = 0;
+}
+
+static void addSample(){
+	uint64_t lat = Ticker_HAL::getRawCounter() - give_time;
+	lat_min = (lat < lat_min)? lat : lat_min;
+	lat_max = (lat > lat_max)? lat : lat_max;
+	lat_sum += lat;
+	samples++;
+}
+
+static void printStats(const char* name){
+	uint64_t mulfactor = 1000000;
+	DEBUG_TRACE_I(_EXPR_, _MODULE_, "%s signal-to-wake: min=%dus, avg=%dus, max=%dus (%d muestras)", name,
+			(int)((lat_min * mulfactor)/Ticker_HAL::TimerScale),
+			(int)(((lat_sum/samples) * mulfactor)/Ticker_HAL::TimerScale),
+			(int)((lat_max * mulfactor)/Ticker_HAL::TimerScale), samples);
+}
+
+static void notifierWaiter(){
+	for(;;){
+		if(ntf->take()){
+			addSample();
+		}
+	}
+}
+
+static void semaphoreWaiter(){
+	for(;;){
+		if(sem->wait() > 0){
+			addSample();
+		}
+	}
+}
+
+
+//---------------------------------------------------------------------------
+TEST_CASE("TEST_Notifier_give_take", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    Notifier n(Thread::gettid());
+    TEST_ASSERT_FALSE(n.take(0));
+    TEST_ASSERT_EQUAL(osOK, n.give());
+    TEST_ASSERT_EQUAL(osErrorResource, n.give());
+    TEST_ASSERT_TRUE(n.pending());
+    TEST_ASSERT_TRUE(n.take(0));
+    TEST_ASSERT_FALSE(n.take(20));
+
+    // las señales del thread no se pierden ni despiertan a Notifier
+    osSignalSet(Thread::gettid(), 0x01);
+    TEST_ASSERT_FALSE(n.take(20));
+    osEvent evt = Thread::signal_wait(0x01, 0);
+    TEST_ASSERT_EQUAL(osEventSignal, evt.status);
+}
+
+
+//---------------------------------------------------------------------------
+/** Una señal que llega mientras el thread espera en Notifier no debe perderse para el siguiente signal_wait */
+static osThreadId signal_target;
+static void signalSetter(void*){
+	vTaskDelay(pdMS_TO_TICKS(5));
+	osSignalSet(signal_target, 0x02);
+	vTaskDelete(NULL);
+}
+
+TEST_CASE("TEST_Notifier_signal_during_take", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    Notifier n(Thread::gettid());
+    signal_target = Thread::gettid();
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(signalSetter, "setter", OS_STACK_SIZE, NULL, osPriorityNormal, NULL, xPortGetCoreID() ^ 1));
+    TEST_ASSERT_FALSE(n.take(30));
+    uint32_t t0 = xTaskGetTickCount();
+    osEvent evt = Thread::signal_wait(0x02, 100);
+    TEST_ASSERT_EQUAL(osEventSignal, evt.status);
+    TEST_ASSERT_TRUE((xTaskGetTickCount() - t0) <= 1);
+}
+
+
+//---------------------------------------------------------------------------
+TEST_CASE("TEST_Notifier_vs_Semaphore_latency", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    Thread* th = new Thread(osPriorityAboveNormal(2), OS_STACK_SIZE, NULL, "ntf_wait");
+    TEST_ASSERT_NOT_NULL(th);
+    ntf = new Notifier(th);
+    TEST_ASSERT_NOT_NULL(ntf);
+    resetStats();
+    TEST_ASSERT_EQUAL(osOK, th->start(callback(&notifierWaiter)));
+    Thread::wait(10);
+    for(int i=0; i<NumSamples; i++){
+    	give_time = Ticker_HAL::getRawCounter();
+    	ntf->give();
+    	Thread::wait(10);
+    }
+    TEST_ASSERT_EQUAL(NumSamples, samples);
+    printStats("Notifier");
+    delete(th);
+    delete(ntf);
+
+    th = new Thread(osPriorityAboveNormal(2), OS_STACK_SIZE, NULL, "sem_wait");
+    TEST_ASSERT_NOT_NULL(th);
+    sem = new Semaphore(0, 1);
+    TEST_ASSERT_NOT_NULL(sem);
+    resetStats();
+    TEST_ASSERT_EQUAL(osOK, th->start(callback(&semaphoreWaiter)));
+    Thread::wait(10);
+    for(int i=0; i<NumSamples; i++){
+    	give_time = Ticker_HAL::getRawCounter();
+    	sem->release();
+    	Thread::wait(10);
+    }
+    TEST_ASSERT_EQUAL(NumSamples, samples);
+    printStats("Semaphore");
+    delete(th);
+    delete(sem);
+}
@@ -0,0 +1,93 @@
+/* test_Profile
+
+   Unit test of PROFILE_SCOPE probes
+*/
+
+//------------------------------------------------------------------------------------
+//-- REQUIRED HEADERS & COMPONENTS FOR TESTING ---------------------------------------
+//------------------------------------------------------------------------------------
+
+#include "mbed.h"
+#include "Profile.h"
+#include "unity.h"
+#include "AppConfig.h"
+static const char* _MODULE_ = "[TEST_Profile]";
+#define _EXPR_	(true)
+static bool _prerequisites_done=false;
+static void executePrerequisites(){
+	if(!_prerequisites_done){
+		_prerequisites_done=true;
+		esp_log_level_set(_MODULE_, ESP_LOG_DEBUG);
+		Ticker_HAL::start();
+	}
+}
+
+
+//---------------------------------------------------------------------------
+static void busyWait(uint32_t us){
+	uint64_t until = HighResTimer::cycles() + ((uint64_t)us * CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ);
+	while(HighResTimer::cycles() < until){
+	}
+}
+
+static void profiledCall(uint32_t us){
+	PROFILE_SCOPE("test::profiledCall");
+	busyWait(us);
+}
+
+
+//---------------------------------------------------------------------------
+TEST_CASE("TEST_Profile_scope", "[mbed_api_esp32]") {
+    executePrerequisites();
+#if MBED_PROFILE == 0
+    TEST_IGNORE_MESSAGE("MBED_PROFILE desactivado");
+#else
+    for(int i = 0; i < 10; i++){
+    	profiledCall(100);
+    }
+    profiledCall(1000);
+
+    // mismo nombre, misma sonda
+    Profile::Probe_t* probe = Profile::probe("test::profiledCall");
+    TEST_ASSERT_NOT_NULL(probe);
+    int idx = -1;
+    Profile::Stats_t stats;
+    for(int i = 0; i < Profile::count(); i++){
+    	const char* name = Profile::snapshot(i, &stats);
+    	if(strcmp(name, "test::profiledCall") == 0){
+    		idx = i;
+    		break;
+    	}
+    }
+    TEST_ASSERT_TRUE(idx >= 0);
+    TEST_ASSERT_EQUAL(11, stats.hist.count);
+    uint32_t mhz = CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ;
+    TEST_ASSERT_UINT32_WITHIN(20 * mhz, 100 * mhz, stats.min);
+    TEST_ASSERT_UINT32_WITHIN(50 * mhz, 1000 * mhz, stats.hist.max);
+    TEST_ASSERT_TRUE(stats.total >= (uint64_t)2000 * mhz);
+    Profile::dump();
+
+    Profile::reset();
+    Profile::snapshot(idx, &stats);
+    TEST_ASSERT_EQUAL(0, stats.hist.count);
+    TEST_ASSERT_EQUAL(0, stats.total);
+#endif
+}
+
+
+//---------------------------------------------------------------------------
+TEST_CASE("TEST_Profile_overhead", "[mbed_api_esp32]") {
+    executePrerequisites();
+#if MBED_PROFILE == 0
+    TEST_IGNORE_MESSAGE("MBED_PROFILE desactivado");
+#else
+    static const int Calls = 1000;
+    uint64_t start = HighResTimer::cycles();
+    for(int i = 0; i < Calls; i++){
+    	profiledCall(0);
+    }
+    uint32_t cost = (uint32_t)((HighResTimer::cycles() - start) / Calls);
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Coste de PROFILE_SCOPE: %d ciclos por llamada", cost);
+    Profile::reset();
+#endif
+}
@@ -0,0 +1,187 @@
+/* test_RWLock
+
+   Unit test and benchmark of MBED-API RWLock and ConditionVariable ESP32 porting
+*/
+
+//------------------------------------------------------------------------------------
+//-- REQUIRED HEADERS & COMPONENTS FOR TESTING ---------------------------------------
+//------------------------------------------------------------------------------------
+
+#include "mbed.h"
+#include "unity.h"
+#include "AppConfig.h"
+static const char* _MODULE_ = "[TEST_RWLock]....";
+#define _EXPR_	(true)
+static bool _prerequisites_done=false;
+static void executePrerequisites(){
+	if(!_prerequisites_done){
+		_prerequisites_done=true;
+		esp_log_level_set(_MODULE_, ESP_LOG_DEBUG);
+	}
+}
+
+/** Parámetros del benchmark: lectores (repartidos entre los dos cores y con prioridad mínima para que el escritor
+ *  no quede bloqueado), duración y periodo de escritura */
+static const int NumReaders = 6;
+static const int TableSize = 32;
+static const uint32_t BenchTimeMs = 2000;
+static const uint32_t WritePeriodMs = 50;
+
+static RWLock* rwlock;
+static Mutex* mutex;
+static volatile bool running = false;
+static volatile uint32_t table[TableSize];
+static volatile uint32_t reads[NumReaders];
+static volatile uint32_t errors = 0;
+static volatile int finished = 0;
+
+static void readTable(){
+	uint32_t first = table[0];
+	for(int i=1; i<TableSize; i++){
+		if(table[i] != first){
+			errors++;
+		}
+	}
+}
+
+static void writeTable(uint32_t value){
+	for(int i=0; i<TableSize; i++){
+		table[i] = value;
+	}
+}
+
+static void rwReaderTask(void* arg){
+	int id = (int)arg;
+	while(running){
+		rwlock->read_lock();
+		readTable();
+		rwlock->read_unlock();
+		reads[id]++;
+	}
+	__atomic_add_fetch(&finished, 1, __ATOMIC_SEQ_CST);
+	vTaskDelete(NULL);
+}
+
+static void mtxReaderTask(void* arg){
+	int id = (int)arg;
+	while(running){
+		mutex->lock();
+		readTable();
+		mutex->unlock();
+		reads[id]++;
+	}
+	__atomic_add_fetch(&finished, 1, __ATOMIC_SEQ_CST);
+	vTaskDelete(NULL);
+}
+
+/** Ejecuta el benchmark con los lectores indicados, escribiendo la tabla periódicamente con 'writer' */
+static uint32_t runBenchmark(TaskFunction_t reader, Callback<void(uint32_t)> writer){
+	memset((void*)reads, 0, sizeof(reads));
+	errors = 0;
+	finished = 0;
+	running = true;
+	for(int i=0; i<NumReaders; i++){
+		TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(reader, "reader", OS_STACK_SIZE, (void*)i, osPriorityIdle + 1, NULL, i % portNUM_PROCESSORS));
+	}
+	for(uint32_t t=0; t<BenchTimeMs; t+=WritePeriodMs){
+		Thread::wait(WritePeriodMs);
+		writer.call(t);
+	}
+	running = false;
+	while(finished < NumReaders){
+		Thread::wait(10);
+	}
+	uint32_t total = 0;
+	for(int i=0; i<NumReaders; i++){
+		total += reads[i];
+	}
+	TEST_ASSERT_EQUAL(0, errors);
+	return total;
+}
+
+static void rwWriter(uint32_t value){
+	rwlock->write_lock();
+	writeTable(value);
+	rwlock->write_unlock();
+}
+
+static void mtxWriter(uint32_t value){
+	mutex->lock();
+	writeTable(value);
+	mutex->unlock();
+}
+
+
+//---------------------------------------------------------------------------
+TEST_CASE("TEST_RWLock_semantics", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    RWLock lock;
+    TEST_ASSERT_EQUAL(osOK, lock.read_lock());
+    TEST_ASSERT_TRUE(lock.try_read_lock());
+    TEST_ASSERT_EQUAL(2, lock.readers());
+    TEST_ASSERT_FALSE(lock.try_write_lock());
+    TEST_ASSERT_EQUAL(osErrorTimeoutResource, lock.write_lock(20));
+    lock.read_unlock();
+    lock.read_unlock();
+    TEST_ASSERT_TRUE(lock.try_write_lock());
+    TEST_ASSERT_TRUE(lock.write_locked());
+    TEST_ASSERT_FALSE(lock.try_read_lock());
+    lock.write_unlock();
+    TEST_ASSERT_TRUE(lock.try_read_lock());
+    lock.read_unlock();
+}
+
+
+//---------------------------------------------------------------------------
+static Mutex cv_mutex;
+static ConditionVariable cv(cv_mutex);
+static volatile int cv_items = 0;
+static void cvProducer(){
+	for(int i=0; i<10; i++){
+		Thread::wait(10);
+		cv_mutex.lock();
+		cv_items++;
+		cv.notify_one();
+		cv_mutex.unlock();
+	}
+}
+
+TEST_CASE("TEST_ConditionVariable_producer_consumer", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    Thread th(osPriorityNormal, OS_STACK_SIZE, NULL, "cv_prod");
+    int consumed = 0;
+    cv_items = 0;
+    TEST_ASSERT_EQUAL(osOK, th.start(callback(&cvProducer)));
+    cv_mutex.lock();
+    while(consumed < 10){
+    	while(cv_items == 0){
+    		TEST_ASSERT_FALSE(cv.wait_for(1000));
+    	}
+    	cv_items--;
+    	consumed++;
+    }
+    TEST_ASSERT_TRUE(cv.wait_for(20));
+    cv_mutex.unlock();
+}
+
+
+//---------------------------------------------------------------------------
+TEST_CASE("TEST_RWLock_vs_Mutex_read_mostly", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    rwlock = new RWLock("bench");
+    TEST_ASSERT_NOT_NULL(rwlock);
+    uint32_t rw_reads = runBenchmark(rwReaderTask, callback(&rwWriter));
+    delete(rwlock);
+
+    mutex = new Mutex("bench");
+    TEST_ASSERT_NOT_NULL(mutex);
+    uint32_t mtx_reads = runBenchmark(mtxReaderTask, callback(&mtxWriter));
+    delete(mutex);
+
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "%d lectores en %d cores, %dms, escritura cada %dms", NumReaders, portNUM_PROCESSORS, BenchTimeMs, WritePeriodMs);
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "RWLock: %d lecturas/s", (rw_reads * 1000) / BenchTimeMs);
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Mutex:  %d lecturas/s", (mtx_reads * 1000) / BenchTimeMs);
+}
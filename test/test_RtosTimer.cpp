@@ -0,0 +1,157 @@
+/* test_RtosTimer
+
+   Unit test of RtosTimer lifetime handling
+*/
+
+//------------------------------------------------------------------------------------
+//-- REQUIRED HEADERS & COMPONENTS FOR TESTING ---------------------------------------
+//------------------------------------------------------------------------------------
+
+#include "mbed.h"
+#include "unity.h"
+#include "AppConfig.h"
+static const char* _MODULE_ = "[TEST_RtosTimer]";
+#define _EXPR_	(true)
+static bool _prerequisites_done=false;
+static void executePrerequisites(){
+	if(!_prerequisites_done){
+		_prerequisites_done=true;
+		esp_log_level_set(_MODULE_, ESP_LOG_DEBUG);
+		Ticker_HAL::start();
+	}
+}
+
+
+//---------------------------------------------------------------------------
+static volatile bool slow_running = false;
+static volatile int fast_count = 0;
+static void slowCallback(){
+	slow_running = true;
+	wait_us(200000);
+	slow_running = false;
+}
+static void fastCallback(){
+	fast_count++;
+}
+
+/** La destrucción de un timer no espera a la callback lenta de otro timer */
+TEST_CASE("TEST_RtosTimer_independent_delete", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    RtosTimer slow(callback(slowCallback), osTimerOnce, "slow");
+    TEST_ASSERT_EQUAL(osOK, slow.start(10));
+    while(!slow_running){
+    	Thread::wait(1);
+    }
+    // cada timer encola dos comandos (inicio y borrado) que el daemon no atiende hasta terminar la callback lenta,
+    // por lo que se usan pocos timers para no llenar su cola de comandos
+    Timer t;
+    t.start();
+    for(int i = 0; i < 4; i++){
+    	RtosTimer* fast = new RtosTimer(callback(fastCallback), osTimerPeriodic, "fast");
+    	TEST_ASSERT_EQUAL(osOK, fast->start(5));
+    	delete fast;
+    }
+    int elapsed = t.read_us();
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "4 timers creados y destruidos en %d us durante una callback lenta", elapsed);
+    TEST_ASSERT_TRUE(slow_running);
+    TEST_ASSERT_TRUE(elapsed < 20000);
+    while(slow_running){
+    	Thread::wait(10);
+    }
+    // los timers destruidos no llegan a ejecutar su callback
+    Thread::wait(50);
+    TEST_ASSERT_EQUAL(0, fast_count);
+}
+
+
+//---------------------------------------------------------------------------
+static volatile int self_count = 0;
+static RtosTimer* self_timer = NULL;
+static void selfDeleteCallback(){
+	self_count++;
+	RtosTimer* tmr = self_timer;
+	self_timer = NULL;
+	delete tmr;
+}
+
+/** Un timer puede destruirse desde su propia callback */
+TEST_CASE("TEST_RtosTimer_self_delete", "[mbed_api_esp32]") {
+    executePrerequisites();
+#if MBED_RTOSTIMER_STATIC
+    TEST_IGNORE_MESSAGE("Con MBED_RTOSTIMER_STATIC un timer no puede destruirse desde su callback");
+#else
+
+    self_count = 0;
+    self_timer = new RtosTimer(callback(selfDeleteCallback), osTimerPeriodic, "self");
+    TEST_ASSERT_EQUAL(osOK, self_timer->start(5));
+    Thread::wait(100);
+    TEST_ASSERT_EQUAL(1, self_count);
+    TEST_ASSERT_NULL(self_timer);
+#endif
+}
+
+
+//---------------------------------------------------------------------------
+static volatile int busy_count = 0;
+static void busyCallback(){
+	busy_count++;
+	wait_us(2000);
+}
+
+/** Destruir un timer con su callback en curso espera a que termine, y después no vuelve a ejecutarse */
+TEST_CASE("TEST_RtosTimer_delete_while_running", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    for(int i = 0; i < 20; i++){
+    	busy_count = 0;
+    	RtosTimer* tmr = new RtosTimer(callback(busyCallback), osTimerPeriodic, "busy");
+    	TEST_ASSERT_EQUAL(osOK, tmr->start(10));
+    	Thread::wait(10 + (i % 5));
+    	delete tmr;
+    	int count = busy_count;
+    	Thread::wait(30);
+    	TEST_ASSERT_EQUAL(count, busy_count);
+    }
+}
+
+
+//---------------------------------------------------------------------------
+static volatile int group_count = 0;
+static void groupCallback(){
+	group_count++;
+}
+
+/** Arranque y parada de un grupo de timers, con estadísticas de comandos y latencia del daemon */
+TEST_CASE("TEST_RtosTimer_group_stats", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    static const int Timers = 8;
+    RtosTimer* group[Timers];
+    for(int i = 0; i < Timers; i++){
+    	group[i] = new RtosTimer(callback(groupCallback), osTimerPeriodic, "group");
+    }
+    RtosTimer::resetStats();
+    group_count = 0;
+    TEST_ASSERT_EQUAL(Timers, RtosTimer::startGroup(group, Timers, 10));
+    Thread::wait(55);
+    TEST_ASSERT_EQUAL(Timers, RtosTimer::stopGroup(group, Timers));
+    int count = group_count;
+    TEST_ASSERT_INT_WITHIN(Timers, 5 * Timers, count);
+    Thread::wait(30);
+    TEST_ASSERT_EQUAL(count, group_count);
+
+    int32_t latency = RtosTimer::measureDaemonLatency(100);
+    TEST_ASSERT_TRUE(latency >= 0);
+
+    RtosTimer::Stats_t stats;
+    RtosTimer::getStats(&stats);
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Comandos=%d, fallos=%d, bloqueo max=%d us, latencia daemon=%d us", stats.commands, stats.failures, stats.send_max_us, stats.daemon_latency_us);
+    TEST_ASSERT_EQUAL(2 * Timers + 1, stats.commands);
+    TEST_ASSERT_EQUAL(0, stats.failures);
+    TEST_ASSERT_EQUAL(latency, stats.daemon_latency_us);
+
+    for(int i = 0; i < Timers; i++){
+    	delete group[i];
+    }
+}
@@ -0,0 +1,139 @@
+/* test_SyslogBatch
+
+   Unit test of the batching syslog adapter with a local stand-in sink that blocks like a remote syslog: caller
+   latency against a synchronous sink, throughput in messages per second, and drop reporting under overload
+*/
+
+//------------------------------------------------------------------------------------
+//-- REQUIRED HEADERS & COMPONENTS FOR TESTING ---------------------------------------
+//------------------------------------------------------------------------------------
+
+#include "mbed.h"
+#include "SyslogBatch.h"
+#include "unity.h"
+#include "AppConfig.h"
+#include <xtensa/hal.h>
+static const char* _MODULE_ = "[TEST_SyslogBatch]";
+#define _EXPR_	(true)
+
+/** Duración simulada del envío de una trama o de una traza al syslog remoto */
+static const uint32_t SinkDelayMs = 5;
+
+/** Destino local: bloquea como un envío por red y cuenta tramas y líneas */
+static volatile uint32_t sink_frames = 0;
+static volatile uint32_t sink_lines = 0;
+static void localSink(const char* data, uint32_t len){
+	for(uint32_t i = 0; i < len; i++){
+		sink_lines = sink_lines + (data[i] == '\n');
+	}
+	sink_frames = sink_frames + 1;
+	Thread::wait(SinkDelayMs);
+}
+
+/** Destino síncrono equivalente, como el 'syslog_print' sin adaptador */
+static void syncPrint(const char* level, const char* tag, const char* format, ...){
+	char line[SyslogBatch::MaxRecordLength];
+	va_list args;
+	va_start(args, format);
+	int n = vsnprintf(line, sizeof(line), format, args);
+	va_end(args);
+	localSink(line, (n < (int)sizeof(line))? n : sizeof(line) - 1);
+}
+
+static bool _prerequisites_done=false;
+static void executePrerequisites(){
+	if(!_prerequisites_done){
+		_prerequisites_done=true;
+		esp_log_level_set(_MODULE_, ESP_LOG_DEBUG);
+		// sin limitación de tasa (se prueba en test/host)
+		SyslogBatch::start(callback(localSink), 0);
+	}
+}
+
+static uint32_t maxCost(void (*print)(const char*, const char*, const char*, ...), int calls){
+	uint32_t max = 0;
+	for(int i = 0; i < calls; i++){
+		uint32_t t0 = xthal_get_ccount();
+		print("D", "[I2C]...........", "Escribiendo %d bytes: result %d, ", i, 0);
+		uint32_t t = xthal_get_ccount() - t0;
+		max = (t > max)? t : max;
+		Thread::wait(1);
+	}
+	return max;
+}
+
+
+//---------------------------------------------------------------------------
+TEST_CASE("TEST_SyslogBatch_latency", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    uint32_t sync = maxCost(syncPrint, 20);
+    SyslogBatch::resetStats();
+    uint32_t batched = maxCost(SyslogBatch::print, 20);
+    SyslogBatch::flush();
+    Thread::wait(SinkDelayMs * 4);
+
+    SyslogBatchCore::Stats_t stats;
+    SyslogBatch::getStats(&stats);
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Ciclos máximos por traza: síncrona %d, por lotes %d (%d tramas)", sync, batched, stats.frames);
+    TEST_ASSERT_EQUAL(20, stats.accepted);
+    TEST_ASSERT_EQUAL(0, stats.dropped_full);
+    TEST_ASSERT_TRUE(stats.frames < 20);
+    TEST_ASSERT_TRUE(batched * 10 < sync);
+}
+
+
+//---------------------------------------------------------------------------
+TEST_CASE("TEST_SyslogBatch_throughput", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    // el productor no cede el procesador: mide el coste del registro y el descarte sin bloqueo cuando el destino
+    // no da abasto
+    static const int Calls = 2000;
+    SyslogBatch::flush();
+    Thread::wait(SinkDelayMs * 4 * SyslogBatchCore::FrameCount);
+    SyslogBatch::resetStats();
+    sink_lines = 0;
+    uint64_t t0 = HighResTimer::cycles();
+    for(int i = 0; i < Calls; i++){
+    	SyslogBatch::print("D", "[Serial]........", "Recibidos %d bytes", i);
+    }
+    uint64_t cycles = HighResTimer::cycles() - t0;
+    SyslogBatch::flush();
+    Thread::wait(SinkDelayMs * 4 * SyslogBatchCore::FrameCount);
+    // la siguiente trama incluye la línea con los descartes que queden por notificar
+    SyslogBatch::print("I", _MODULE_, "fin");
+    SyslogBatch::flush();
+    Thread::wait(SinkDelayMs * 4);
+
+    SyslogBatchCore::Stats_t stats;
+    SyslogBatch::getStats(&stats);
+    uint32_t rate = (uint32_t)(((uint64_t)Calls * CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ * 1000000) / cycles);
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "%d msg/s en el llamante. Aceptadas %d, descartadas %d, tramas %d, líneas recibidas %d",
+    		rate, stats.accepted, stats.dropped_full, stats.frames, sink_lines);
+    TEST_ASSERT_EQUAL(Calls + 1, stats.accepted + stats.dropped_full);
+    TEST_ASSERT_TRUE(stats.dropped_full > 0);
+    // todas las aceptadas llegan, y además la línea de descartes
+    TEST_ASSERT_EQUAL(stats.accepted + stats.reports, sink_lines);
+    TEST_ASSERT_TRUE(stats.reports > 0);
+}
+
+
+//---------------------------------------------------------------------------
+static void isrPrint(){
+	SyslogBatch::print("I", _MODULE_, "desde ISR");
+}
+
+TEST_CASE("TEST_SyslogBatch_isr_drops", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    // desde ISR la traza no se registra, pero se contabiliza
+    SyslogBatch::resetStats();
+    Timeout tout;
+    tout.attach_us(callback(isrPrint), 1000);
+    Thread::wait(10);
+    SyslogBatchCore::Stats_t stats;
+    SyslogBatch::getStats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.dropped_isr);
+    TEST_ASSERT_EQUAL(0, stats.accepted);
+}
@@ -0,0 +1,119 @@
+/* test_TaskEventFlags
+
+   Unit test and benchmark of MBED-API TaskEventFlags ESP32 porting
+*/
+
+//------------------------------------------------------------------------------------
+//-- REQUIRED HEADERS & COMPONENTS FOR TESTING ---------------------------------------
+//------------------------------------------------------------------------------------
+
+#include "mbed.h"
+#include "unity.h"
+#include "AppConfig.h"
+static const char* _MODULE_ = "[TEST_TaskEvFlg].";
+#define _EXPR_	(true)
+static bool _prerequisites_done=false;
+static void executePrerequisites(){
+	if(!_prerequisites_done){
+		_prerequisites_done=true;
+		esp_log_level_set(_MODULE_, ESP_LOG_DEBUG);
+		DEBUG_TRACE_I(_EXPR_, _MODULE_, "Iniciando Ticker_HAL");
+		Ticker_HAL::start();
+	}
+}
+
+/** Número de muestras y de intervalos log2 del histograma (en us) */
+static const int NumSamples = 200;
+static const int NumBuckets = 12;
+
+static EventFlags* evf;
+static EventFlags64* evf64;
+static volatile uint64_t set_time = 0;
+static volatile int samples = 0;
+static uint32_t histogram[NumBuckets];
+
+static void resetHistogram(){
+	memset(histogram, 0, sizeof(histogram));
+	samples = 0;
+}
+
+static void addSample(){
+	uint64_t mulfactor = 1000000;
+	uint32_t us = (uint32_t)(((Ticker_HAL::getRawCounter() - set_time) * mulfactor) / Ticker_HAL::TimerScale);
+	int bucket = 0;
+	while(us > 1 && bucket < (NumBuckets - 1)){
+		us >>= 1;
+		bucket++;
+	}
+	histogram[bucket]++;
+	samples++;
+}
+
+static void printHistogram(const char* name){
+	DEBUG_TRACE_I(_EXPR_, _MODULE_, "%s ISR set-to-wake (%d muestras):", name, samples);
+	for(int i=0; i<NumBuckets; i++){
+		DEBUG_TRACE_I(_EXPR_, _MODULE_, "  [%5d, %5d) us: %d", (i==0)? 0 : (1<<i), (2<<i), histogram[i]);
+	}
+}
+
+static void isrSetEventFlags(){
+	set_time = Ticker_HAL::getRawCounter();
+	evf->set(1);
+}
+
+static void isrSetEventFlags64(){
+	set_time = Ticker_HAL::getRawCounter();
+	evf64->set(1ULL << 40);
+}
+
+
+//---------------------------------------------------------------------------
+TEST_CASE("TEST_TaskEventFlags_semantics", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    EventFlags64 flags;
+    TEST_ASSERT_EQUAL_UINT64((1ULL << 63), flags.set(1ULL << 63));
+    TEST_ASSERT_EQUAL_UINT64(0, flags.wait_all((1ULL << 63) | 1, 20) & 1);
+    flags.set(1);
+    TEST_ASSERT_EQUAL_UINT64((1ULL << 63) | 1, flags.wait_all((1ULL << 63) | 1, 0));
+    TEST_ASSERT_EQUAL_UINT64(0, flags.get());
+    flags.set(0x0F);
+    TEST_ASSERT_EQUAL_UINT64(0x0F, flags.wait_any(0x03, 0, false));
+    TEST_ASSERT_EQUAL_UINT64(0x0F, flags.wait_any(0x03, 0));
+    TEST_ASSERT_EQUAL_UINT64(0x0C, flags.clear());
+    TEST_ASSERT_EQUAL_UINT64(0, flags.get());
+}
+
+
+//---------------------------------------------------------------------------
+TEST_CASE("TEST_TaskEventFlags_vs_EventFlags_latency", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    Ticker* tick = new Ticker();
+    TEST_ASSERT_NOT_NULL(tick);
+
+    evf = new EventFlags();
+    TEST_ASSERT_NOT_NULL(evf);
+    resetHistogram();
+    tick->attach_us(callback(&isrSetEventFlags), 5000);
+    while(samples < NumSamples){
+    	evf->wait_any(1);
+    	addSample();
+    }
+    tick->detach();
+    printHistogram("EventFlags");
+    delete(evf);
+
+    evf64 = new EventFlags64();
+    TEST_ASSERT_NOT_NULL(evf64);
+    resetHistogram();
+    tick->attach_us(callback(&isrSetEventFlags64), 5000);
+    while(samples < NumSamples){
+    	evf64->wait_any(1ULL << 40);
+    	addSample();
+    }
+    tick->detach();
+    printHistogram("EventFlags64");
+    delete(evf64);
+    delete(tick);
+}
@@ -10,6 +10,7 @@
 #include "mbed.h"
 #include "unity.h"
 #include "AppConfig.h"
+#include <xtensa/hal.h>
 static const char* _MODULE_ = "[TEST_Ticker]....";
 #define _EXPR_	(true)
 Ticker* tick;
@@ -26,112 +27,440 @@ static void executePrerequisites(){
 static uint64_t curr_time = 0;
 static uint64_t elapsed_time = 0;
 static bool event_done=false;
+static volatile uint32_t fires = 0;
+static uint32_t fires_target = 0;
 static void ticker_callback(){
-	elapsed_time = Ticker_HAL::getTimestamp();
-	tick->detach();
-	event_done=true;
+	if(++fires >= fires_target){
+		elapsed_time = Ticker_HAL::getTimestamp();
+		tick->detach();
+		event_done=true;
+	}
 }
 
+static void printHistogram(const char* name, const Ticker_HAL::Histogram_t* h){
+	DEBUG_TRACE_I(_EXPR_, _MODULE_, "%s: %d muestras, p50 %d ciclos, p99 %d ciclos, max %d ciclos", name, h->count,
+			Ticker_HAL::histPercentile(h, 50), Ticker_HAL::histPercentile(h, 99), h->max);
+}
 
-//---------------------------------------------------------------------------
-TEST_CASE("TEST_Ticker_0.01ms", "[mbed_api_esp32]") {
-    executePrerequisites();
-
+/** Ejecuta un ticker periódico durante 'count' disparos y muestra sus histogramas de retraso y de duración de la
+ *  callback, junto con el de duración de la ISR. Sin MBED_TICKER_HISTOGRAMS únicamente muestra el tiempo total */
+static void runTicker(uint64_t period_us, uint32_t count){
     DEBUG_TRACE_I(_EXPR_, _MODULE_, "Creando Ticker");
     tick = new Ticker();
     TEST_ASSERT_NOT_NULL(tick);
 
-    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Iniciando 10us Ticker");
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Iniciando Ticker de %dus, %d disparos", (uint32_t)period_us, count);
     Thread::wait(100);
+    fires = 0;
+    fires_target = count;
     event_done=false;
+    tick->reset_histograms();
     curr_time = Ticker_HAL::getTimestamp();
-    tick->attach_us(callback(&ticker_callback), 10);
+    tick->attach_us(callback(&ticker_callback), period_us);
     while(!event_done){
     	Thread::wait(10);
     }
+    TEST_ASSERT_EQUAL(count, fires);
+    TEST_ASSERT_TRUE((elapsed_time - curr_time) >= (period_us * count));
     DEBUG_TRACE_I(_EXPR_, _MODULE_, "Tiempo transcurrido %fus", (double)(elapsed_time - curr_time));
+
+#if MBED_TICKER_HISTOGRAMS
+    Ticker_HAL::TickerHist_t hist;
+    Ticker_HAL::HistSnapshot_t snap;
+    tick->get_histograms(&hist);
+    Ticker_HAL::getHistograms(&snap);
+    TEST_ASSERT_EQUAL(count, hist.lateness.count);
+    TEST_ASSERT_EQUAL(count, hist.callback.count);
+    TEST_ASSERT_TRUE(snap.isr.count > 0);
+    printHistogram("Retraso", &hist.lateness);
+    printHistogram("Callback", &hist.callback);
+    printHistogram("ISR", &snap.isr);
+#endif
     delete(tick);
 }
 
 
 //---------------------------------------------------------------------------
-TEST_CASE("TEST_Ticker_0.1ms", "[mbed_api_esp32]") {
+TEST_CASE("TEST_Ticker_0.01ms", "[mbed_api_esp32]") {
     executePrerequisites();
+    runTicker(10, 1000);
+}
 
-    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Creando Ticker");
-    tick = new Ticker();
-    TEST_ASSERT_NOT_NULL(tick);
 
-    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Iniciando 100us Ticker");
-    Thread::wait(100);
-    event_done=false;
-    curr_time = Ticker_HAL::getTimestamp();
-    tick->attach_us(callback(&ticker_callback), 100);
-    while(!event_done){
-    	Thread::wait(10);
-    }
-    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Tiempo transcurrido %fus", (double)(elapsed_time - curr_time));
-    delete(tick);
+//---------------------------------------------------------------------------
+TEST_CASE("TEST_Ticker_0.1ms", "[mbed_api_esp32]") {
+    executePrerequisites();
+    runTicker(100, 1000);
 }
+
+
 //---------------------------------------------------------------------------
 TEST_CASE("TEST_Ticker_1ms", "[mbed_api_esp32]") {
     executePrerequisites();
+    runTicker(1000, 1000);
+}
 
-    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Creando Ticker");
-    tick = new Ticker();
-    TEST_ASSERT_NOT_NULL(tick);
 
-    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Iniciando 1ms Ticker");
-    Thread::wait(100);
-    event_done=false;
-    curr_time = Ticker_HAL::getTimestamp();
-    tick->attach_us(callback(&ticker_callback), 1000);
-    while(!event_done){
-    	Thread::wait(10);
+//---------------------------------------------------------------------------
+TEST_CASE("TEST_Ticker_1sec", "[mbed_api_esp32]") {
+    executePrerequisites();
+    runTicker(1000000, 3);
+}
+
+
+//---------------------------------------------------------------------------
+TEST_CASE("TEST_Ticker_10sec", "[mbed_api_esp32]") {
+    executePrerequisites();
+    runTicker(10000000, 1);
+}
+
+
+
+//---------------------------------------------------------------------------
+/** Benchmark de duración de la ISR con distinto número de tickers instalados. Los tickers de fondo tienen un
+ *  periodo largo (no llegan a dispararse) y sólo ocupan la cola de prioridad, mientras que el ticker de medida
+ *  genera una interrupción cada milisegundo
+ */
+static const int BenchTickers[] = {1, 16, 64, 256};
+static volatile uint32_t probe_events = 0;
+static void background_callback(){
+}
+static void probe_callback(){
+	probe_events++;
+}
+
+TEST_CASE("TEST_Ticker_isr_duration", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    for(int b = 0; b < sizeof(BenchTickers)/sizeof(BenchTickers[0]); b++){
+    	int n = BenchTickers[b];
+    	Ticker* background = (n > 1)? new Ticker[n - 1] : NULL;
+    	for(int i = 0; i < n - 1; i++){
+    		background[i].attach_us(callback(&background_callback), 60000000 + (i * 1000));
+    	}
+    	Ticker* probe = new Ticker();
+    	TEST_ASSERT_NOT_NULL(probe);
+    	probe_events = 0;
+    	Ticker_HAL::resetIsrStats();
+    	probe->attach_us(callback(&probe_callback), 1000);
+    	TEST_ASSERT_TRUE(Ticker_HAL::getTickerCount() >= n);
+    	Thread::wait(500);
+    	probe->detach();
+
+    	Ticker_HAL::IsrStats_t stats;
+    	Ticker_HAL::getIsrStats(&stats);
+    	delete(probe);
+    	delete [] background;
+    	TEST_ASSERT_TRUE(probe_events > 0);
+    	TEST_ASSERT_TRUE(stats.count > 0);
+    	// en ciclos, para comparar builds con distinta frecuencia de CPU
+    	uint32_t mean_cycles = (uint32_t)(stats.sum_cycles / stats.count);
+    	DEBUG_TRACE_I(_EXPR_, _MODULE_, "%d tickers: %d ISR, media %d ciclos (%dns), max %d ciclos (%dns)", n, stats.count,
+    			mean_cycles, (int)((mean_cycles * 1000) / CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ),
+    			stats.max_cycles, (int)((stats.max_cycles * 1000) / CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ));
     }
-    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Tiempo transcurrido %fus", (double)(elapsed_time - curr_time));
-    delete(tick);
 }
 
 
 //---------------------------------------------------------------------------
-TEST_CASE("TEST_Ticker_1sec", "[mbed_api_esp32]") {
+/** Compara la duración de la ISR y la latencia añadida con la callback ejecutada en la ISR o diferida al thread
+ *  de servicio. La callback consume 'work_us' en espera activa
+ */
+static volatile uint32_t work_us = 0;
+static volatile uint32_t work_calls = 0;
+static void work_callback(){
+	uint64_t end = Ticker_HAL::getRawCounter() + ((uint64_t)work_us * Ticker_HAL::TimerScale) / 1000000;
+	while(Ticker_HAL::getRawCounter() < end){
+	}
+	work_calls++;
+}
+
+static void runDispatch(Ticker_HAL::DispatchMode mode, uint32_t period_us, Ticker_HAL::IsrStats_t* isr, Ticker_HAL::DispatchStats_t* dsp, uint32_t* overruns){
+	Ticker* t = new Ticker();
+	TEST_ASSERT_NOT_NULL(t);
+	t->set_dispatch(mode);
+	work_calls = 0;
+	Ticker_HAL::resetIsrStats();
+	Ticker_HAL::resetDispatchStats();
+	t->attach_us(callback(&work_callback), period_us);
+	Thread::wait(500);
+	t->detach();
+	Ticker_HAL::getIsrStats(isr);
+	Ticker_HAL::getDispatchStats(dsp);
+	*overruns = t->overruns();
+	delete(t);
+	TEST_ASSERT_TRUE(work_calls > 0);
+}
+
+TEST_CASE("TEST_Ticker_dispatch_thread", "[mbed_api_esp32]") {
     executePrerequisites();
 
-    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Creando Ticker");
-    tick = new Ticker();
-    TEST_ASSERT_NOT_NULL(tick);
+    Ticker_HAL::IsrStats_t isr;
+    Ticker_HAL::DispatchStats_t dsp;
+    uint32_t overruns;
+    uint64_t mulfactor = 1000000;
 
-    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Iniciando 1sec Ticker");
-    Thread::wait(100);
-    event_done=false;
-    curr_time = Ticker_HAL::getTimestamp();
-    tick->attach_us(callback(&ticker_callback), 1000000);
-    while(!event_done){
-    	Thread::wait(10);
+    work_us = 100;
+    runDispatch(Ticker_HAL::DispatchISR, 1000, &isr, &dsp, &overruns);
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "ISR: callback %dus, ISR media %dns, max %dns", work_us,
+    		(int)(((isr.sum_cycles / isr.count) * 1000) / CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ),
+    		(int)((isr.max_cycles * 1000) / CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ));
+
+    runDispatch(Ticker_HAL::DispatchThread, 1000, &isr, &dsp, &overruns);
+    TEST_ASSERT_TRUE(dsp.count > 0);
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Thread: callback %dus, ISR media %dns, max %dns, latencia media %dus, max %dus", work_us,
+    		(int)(((isr.sum_cycles / isr.count) * 1000) / CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ),
+    		(int)((isr.max_cycles * 1000) / CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ),
+    		(int)(((dsp.sum_latency / dsp.count) * mulfactor) / Ticker_HAL::TimerScale),
+    		(int)((dsp.max_latency * mulfactor) / Ticker_HAL::TimerScale));
+
+    // la callback tarda más que el periodo: los eventos se agrupan
+    work_us = 1500;
+    runDispatch(Ticker_HAL::DispatchThread, 1000, &isr, &dsp, &overruns);
+    TEST_ASSERT_TRUE(overruns > 0);
+    TEST_ASSERT_EQUAL(0, dsp.dropped);
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Thread sobrecargado: %d callbacks, %d eventos agrupados", work_calls, overruns);
+}
+
+
+//---------------------------------------------------------------------------
+/** Un ticker de 1kHz durante 2s debe ejecutar tantas callbacks como periodos completos, sin deriva acumulada
+ */
+static volatile uint32_t drift_calls = 0;
+static void drift_callback(){
+	drift_calls++;
+}
+
+TEST_CASE("TEST_Ticker_drift_1kHz", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    Ticker* t = new Ticker();
+    TEST_ASSERT_NOT_NULL(t);
+    drift_calls = 0;
+    uint64_t t0 = Ticker_HAL::getRawCounter();
+    t->attach_us(callback(&drift_callback), 1000);
+    Thread::wait(2000);
+    t->detach();
+    uint64_t elapsed_us = ((Ticker_HAL::getRawCounter() - t0) * 1000000) / Ticker_HAL::TimerScale;
+    uint32_t expected = (uint32_t)(elapsed_us / 1000);
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "1kHz: %d callbacks, %d esperadas, %d tardías, retraso max %dus", drift_calls, expected, t->late_fires(), t->max_lateness_us());
+    TEST_ASSERT_UINT32_WITHIN(2, expected, drift_calls);
+    delete(t);
+}
+
+
+//---------------------------------------------------------------------------
+/** Una callback que bloquea 3.5ms una única vez en un ticker de 1ms: con OverrunSkip se descartan los periodos
+ *  perdidos y con OverrunCatchUp se recuperan todos
+ */
+static volatile uint32_t stall_calls = 0;
+static void stall_callback(){
+	if(++stall_calls == 10){
+		uint64_t end = Ticker_HAL::getRawCounter() + (3500 * Ticker_HAL::TimerScale) / 1000000;
+		while(Ticker_HAL::getRawCounter() < end){
+		}
+	}
+}
+
+static uint32_t runStall(Ticker_HAL::OverrunPolicy policy, uint32_t* skipped){
+	Ticker* t = new Ticker();
+	TEST_ASSERT_NOT_NULL(t);
+	t->set_overrun_policy(policy);
+	stall_calls = 0;
+	t->attach_us(callback(&stall_callback), 1000);
+	Thread::wait(100);
+	t->detach();
+	uint32_t calls = stall_calls;
+	TEST_ASSERT_TRUE(t->late_fires() > 0);
+	*skipped = t->skipped();
+	delete(t);
+	return calls;
+}
+
+TEST_CASE("TEST_Ticker_overrun_policy", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    uint32_t skipped;
+    uint32_t skip_calls = runStall(Ticker_HAL::OverrunSkip, &skipped);
+    TEST_ASSERT_TRUE(skipped >= 2);
+    uint32_t catchup_calls = runStall(Ticker_HAL::OverrunCatchUp, &skipped);
+    TEST_ASSERT_EQUAL(0, skipped);
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Skip: %d callbacks, CatchUp: %d callbacks", skip_calls, catchup_calls);
+    TEST_ASSERT_TRUE(catchup_calls > skip_calls);
+}
+
+
+//---------------------------------------------------------------------------
+/** Ciclos por lectura de tiempo: camino a través del driver con división de 64 bits frente a la lectura directa
+ *  de registros con conversión en coma fija
+ */
+static const int TimeReads = 1000;
+
+static uint64_t legacyTimestamp(){
+	uint64_t now = 0;
+	timer_get_counter_value(Ticker_HAL::TimerGroup, Ticker_HAL::TimerIdx, &now);
+	uint64_t mulfactor = 1000000;
+	return ((now * mulfactor)/Ticker_HAL::TimerScale);
+}
+
+TEST_CASE("TEST_Ticker_time_read_cycles", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    volatile uint64_t sink = 0;
+    uint32_t cycles = xthal_get_ccount();
+    for(int i = 0; i < TimeReads; i++){
+    	sink = legacyTimestamp();
     }
-    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Tiempo transcurrido %fus", (double)(elapsed_time - curr_time));
-    delete(tick);
+    uint32_t legacy_cycles = (xthal_get_ccount() - cycles) / TimeReads;
+
+    cycles = xthal_get_ccount();
+    for(int i = 0; i < TimeReads; i++){
+    	sink = Ticker_HAL::now_us();
+    }
+    uint32_t fast_cycles = (xthal_get_ccount() - cycles) / TimeReads;
+
+    cycles = xthal_get_ccount();
+    for(int i = 0; i < TimeReads; i++){
+    	sink = Ticker_HAL::now_ticks();
+    }
+    uint32_t ticks_cycles = (xthal_get_ccount() - cycles) / TimeReads;
+
+    // ambos caminos deben dar el mismo tiempo
+    uint64_t a = legacyTimestamp();
+    uint64_t b = Ticker_HAL::now_us();
+    TEST_ASSERT_TRUE((b - a) < 100);
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Ciclos por lectura: driver+div %d, now_us %d, now_ticks %d", legacy_cycles, fast_cycles, ticks_cycles);
+    (void)sink;
 }
 
 
 //---------------------------------------------------------------------------
-TEST_CASE("TEST_Ticker_10sec", "[mbed_api_esp32]") {
+/** Reparte tickers de 1ms entre los timers de cada core y muestra la carga de ISR de cada uno
+ */
+static const int TickersPerCore = 8;
+static void load_callback(){
+}
+
+TEST_CASE("TEST_Ticker_per_core_load", "[mbed_api_esp32]") {
     executePrerequisites();
 
-    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Creando Ticker");
-    tick = new Ticker();
-    TEST_ASSERT_NOT_NULL(tick);
+    Ticker* tickers = new Ticker[TickersPerCore * Ticker_HAL::NumShards];
+    TEST_ASSERT_NOT_NULL(tickers);
+    for(int i = 0; i < TickersPerCore * Ticker_HAL::NumShards; i++){
+    	tickers[i].set_affinity(i % Ticker_HAL::NumShards);
+    	tickers[i].attach_us(callback(&load_callback), 1000 + i);
+    }
+    Ticker_HAL::resetIsrStats();
+    Thread::wait(1000);
+    for(int s = 0; s < Ticker_HAL::NumShards; s++){
+    	Ticker_HAL::IsrStats_t stats;
+    	Ticker_HAL::getIsrStats(&stats, s);
+    	TEST_ASSERT_TRUE(Ticker_HAL::getTickerCount(s) >= TickersPerCore);
+    	TEST_ASSERT_TRUE(stats.count > 0);
+    	DEBUG_TRACE_I(_EXPR_, _MODULE_, "Core %d: %d tickers, %d ISR/s, media %dns, carga %d/10000", s, Ticker_HAL::getTickerCount(s), stats.count,
+    			(int)(((stats.sum_cycles / stats.count) * 1000) / CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ),
+    			(int)((stats.sum_cycles * 10000) / ((uint64_t)CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ * 1000000)));
+    }
+    delete [] tickers;
+}
 
-    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Iniciando 10sec Ticker");
-    Thread::wait(100);
-    event_done=false;
-    curr_time = Ticker_HAL::getTimestamp();
-    tick->attach_us(callback(&ticker_callback), 10000000);
-    while(!event_done){
-    	Thread::wait(10);
+
+//---------------------------------------------------------------------------
+/** 50 tickers de mantenimiento con periodos próximos a 10ms: sin holgura cada uno genera su propia interrupción,
+ *  con 5ms de holgura las ventanas solapadas comparten alarma
+ */
+static const int SlackTickers = 50;
+static volatile uint32_t slack_calls = 0;
+static void slack_callback(){
+	slack_calls++;
+}
+
+static uint32_t runSlack(uint64_t slack_us, uint32_t* calls){
+	Ticker* tickers = new Ticker[SlackTickers];
+	TEST_ASSERT_NOT_NULL(tickers);
+	slack_calls = 0;
+	for(int i = 0; i < SlackTickers; i++){
+		tickers[i].set_affinity(0);
+		tickers[i].attach_us(callback(&slack_callback), 10000 + (i * 37), slack_us);
+	}
+	Ticker_HAL::resetIsrStats();
+	Thread::wait(1000);
+	Ticker_HAL::IsrStats_t stats;
+	Ticker_HAL::getIsrStats(&stats);
+	*calls = slack_calls;
+	delete [] tickers;
+	return stats.count;
+}
+
+TEST_CASE("TEST_Ticker_slack_coalescing", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    uint32_t exact_calls, batched_calls;
+    uint32_t exact_isr = runSlack(0, &exact_calls);
+    uint32_t slack_isr = runSlack(5000, &batched_calls);
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "%d tickers: sin holgura %d ISR/s (%d callbacks), con 5ms %d ISR/s (%d callbacks), reducción %d%%",
+    		SlackTickers, exact_isr, exact_calls, slack_isr, batched_calls, (int)(100 - ((slack_isr * 100) / exact_isr)));
+    TEST_ASSERT_TRUE(slack_isr < exact_isr);
+}
+
+
+//---------------------------------------------------------------------------
+static volatile uint32_t timeout_calls = 0;
+static void timeout_callback(){
+	timeout_calls++;
+}
+
+TEST_CASE("TEST_Timeout_oneshot_restart", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    // dispara una única vez y deja de estar instalado, sin interrupciones adicionales
+    Timeout to;
+    timeout_calls = 0;
+    int installed = Ticker_HAL::getTickerCount();
+    Ticker_HAL::resetIsrStats();
+    to.attach_us(callback(&timeout_callback), 1000);
+    TEST_ASSERT_TRUE(to.pending());
+    Thread::wait(50);
+    TEST_ASSERT_EQUAL(1, timeout_calls);
+    TEST_ASSERT_FALSE(to.pending());
+    TEST_ASSERT_EQUAL(installed, Ticker_HAL::getTickerCount());
+    Ticker_HAL::IsrStats_t stats;
+    Ticker_HAL::getIsrStats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.count);
+
+    // watchdog de 20ms reiniciado cada 5ms: no vence hasta que deja de reiniciarse
+    timeout_calls = 0;
+    to.attach_us(callback(&timeout_callback), 20000);
+    for(int i = 0; i < 20; i++){
+    	Thread::wait(5);
+    	to.restart();
     }
-    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Tiempo transcurrido %fus", (double)(elapsed_time - curr_time));
-    delete(tick);
+    TEST_ASSERT_EQUAL(0, timeout_calls);
+    Thread::wait(50);
+    TEST_ASSERT_EQUAL(1, timeout_calls);
+
+    // se puede rearmar tras vencer
+    to.restart();
+    Thread::wait(50);
+    TEST_ASSERT_EQUAL(2, timeout_calls);
 }
 
+
+//---------------------------------------------------------------------------
+#if MBED_CALLBACK_HEAP_FALLBACK
+TEST_CASE("TEST_Ticker_heap_callback_rejected", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    // una callback almacenada en heap no se instala, en ninguna compilación, y deja el Ticker desinstalado
+    Ticker t;
+    int installed = Ticker_HAL::getTickerCount();
+    t.attach_us(callback(&timeout_callback), 1000);
+    TEST_ASSERT_EQUAL(installed + 1, Ticker_HAL::getTickerCount());
+    char big[64];
+    memset(big, 7, sizeof(big));
+    Callback<void()> lbig = [big]() { timeout_calls += big[0]; };
+    TEST_ASSERT_TRUE(lbig.heap_allocated());
+    t.attach_us(lbig, 1000);
+    TEST_ASSERT_EQUAL(installed, Ticker_HAL::getTickerCount());
+}
+#endif
@@ -0,0 +1,145 @@
+/* test_TimingWheel
+
+   Unit test and benchmark of TimingWheel
+*/
+
+//------------------------------------------------------------------------------------
+//-- REQUIRED HEADERS & COMPONENTS FOR TESTING ---------------------------------------
+//------------------------------------------------------------------------------------
+
+#include "mbed.h"
+#include "TimingWheel.h"
+#include "unity.h"
+#include "AppConfig.h"
+#include <xtensa/hal.h>
+static const char* _MODULE_ = "[TEST_TimingWheel]";
+#define _EXPR_	(true)
+static bool _prerequisites_done=false;
+static void executePrerequisites(){
+	if(!_prerequisites_done){
+		_prerequisites_done=true;
+		esp_log_level_set(_MODULE_, ESP_LOG_DEBUG);
+	}
+}
+
+static TimingWheel* wheel;
+static volatile uint32_t expired = 0;
+static volatile uint32_t errors = 0;
+static void expiredHandler(TimingWheel::Entry* entry){
+	// cada entrada debe expirar exactamente en su tick
+	if(entry->expires != wheel->now()){
+		errors++;
+	}
+	expired++;
+}
+
+
+//---------------------------------------------------------------------------
+TEST_CASE("TEST_TimingWheel_semantics", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    // 3 niveles de 16 buckets: rango de 4096 ticks de 1ms
+    wheel = new TimingWheel(callback(&expiredHandler), 1000, 3, 4);
+    TEST_ASSERT_NOT_NULL(wheel);
+    TimingWheel::Entry e[5];
+    expired = 0;
+    errors = 0;
+    wheel->start(&e[0], 0);
+    wheel->start(&e[1], 15000);
+    wheel->start(&e[2], 16000);
+    wheel->start(&e[3], 300000);
+    wheel->start(&e[4], 100000000);
+    TEST_ASSERT_EQUAL(5, wheel->count());
+    TEST_ASSERT_EQUAL(4095, e[4].expires);
+
+    wheel->tick();
+    TEST_ASSERT_EQUAL(1, expired);
+    TEST_ASSERT_FALSE(wheel->active(&e[0]));
+    TEST_ASSERT_TRUE(wheel->cancel(&e[2]));
+    TEST_ASSERT_FALSE(wheel->cancel(&e[2]));
+    wheel->start(&e[1], 20000);
+    while(wheel->count() > 0){
+    	wheel->tick();
+    }
+    TEST_ASSERT_EQUAL(4, expired);
+    TEST_ASSERT_EQUAL(0, errors);
+    TEST_ASSERT_EQUAL(4095, wheel->now());
+    delete(wheel);
+}
+
+
+//---------------------------------------------------------------------------
+TEST_CASE("TEST_TimingWheel_rtostimer", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    wheel = new TimingWheel(callback(&expiredHandler), portTICK_PERIOD_MS * 1000);
+    TEST_ASSERT_NOT_NULL(wheel);
+    TimingWheel::Entry e;
+    expired = 0;
+    errors = 0;
+    wheel->attach();
+    wheel->start(&e, 200000);
+    Thread::wait(100);
+    TEST_ASSERT_EQUAL(0, expired);
+    Thread::wait(200);
+    TEST_ASSERT_EQUAL(1, expired);
+    TEST_ASSERT_EQUAL(0, errors);
+    delete(wheel);
+}
+
+
+//---------------------------------------------------------------------------
+/** Benchmark con 10k temporizaciones entre 1ms y 60s. Se arrancan todas, se cancela una de cada cuatro y se
+ *  avanza la rueda manualmente hasta que expiran las restantes
+ */
+static const int NumEntries = 10000;
+static const uint32_t MaxTimeoutMs = 60000;
+
+TEST_CASE("TEST_TimingWheel_10k_benchmark", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    wheel = new TimingWheel(callback(&expiredHandler), 1000, 4, 6);
+    TEST_ASSERT_NOT_NULL(wheel);
+    TimingWheel::Entry* entries = new TimingWheel::Entry[NumEntries];
+    TEST_ASSERT_NOT_NULL(entries);
+    expired = 0;
+    errors = 0;
+
+    uint32_t seed = 12345;
+    uint32_t cycles = xthal_get_ccount();
+    for(int i = 0; i < NumEntries; i++){
+    	seed = (seed * 1103515245) + 12345;
+    	wheel->start(&entries[i], (uint64_t)(1 + ((seed >> 8) % MaxTimeoutMs)) * 1000);
+    }
+    uint32_t start_cycles = xthal_get_ccount() - cycles;
+    TEST_ASSERT_EQUAL(NumEntries, wheel->count());
+
+    int cancelled = 0;
+    cycles = xthal_get_ccount();
+    for(int i = 0; i < NumEntries; i += 4){
+    	wheel->cancel(&entries[i]);
+    	cancelled++;
+    }
+    uint32_t cancel_cycles = xthal_get_ccount() - cycles;
+
+    uint32_t ticks = 0;
+    uint32_t tick_max = 0;
+    uint64_t tick_sum = 0;
+    while(wheel->count() > 0){
+    	cycles = xthal_get_ccount();
+    	wheel->tick();
+    	cycles = xthal_get_ccount() - cycles;
+    	tick_sum += cycles;
+    	if(cycles > tick_max){
+    		tick_max = cycles;
+    	}
+    	ticks++;
+    }
+    delete [] entries;
+    delete(wheel);
+
+    TEST_ASSERT_EQUAL(NumEntries - cancelled, expired);
+    TEST_ASSERT_EQUAL(0, errors);
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "%d timers: start %d ciclos, cancel %d ciclos", NumEntries, start_cycles / NumEntries, cancel_cycles / cancelled);
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "tick: %d ticks, media %d ciclos, max %d ciclos", ticks, (uint32_t)(tick_sum / ticks), tick_max);
+}
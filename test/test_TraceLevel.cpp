@@ -0,0 +1,112 @@
+/* test_TraceLevel
+
+   Unit test of the compile-time trace levels: cost of the DEBUG_TRACE_D sequence of I2C::write when the debug level
+   is compiled in (with the debug flag off and on) and when the module level removes it
+*/
+
+//------------------------------------------------------------------------------------
+//-- REQUIRED HEADERS & COMPONENTS FOR TESTING ---------------------------------------
+//------------------------------------------------------------------------------------
+
+#include "mbed.h"
+#include "unity.h"
+#include "AppConfig.h"
+#include <xtensa/hal.h>
+static const char* _MODULE_ = "[TEST_TraceLevel]";
+static volatile bool _debug = false;
+#define _EXPR_	(_debug && !IS_ISR())
+static bool _prerequisites_done=false;
+static void executePrerequisites(){
+	if(!_prerequisites_done){
+		_prerequisites_done=true;
+		esp_log_level_set(_MODULE_, ESP_LOG_INFO);
+	}
+}
+
+
+//---------------------------------------------------------------------------
+/** Las 11 trazas de I2C::write, sin el acceso al bus */
+#define I2C_WRITE_TRACES(length, ret)								\
+	DEBUG_TRACE_D(_EXPR_, _MODULE_, "Escribiendo %d bytes: ", length);	\
+	DEBUG_TRACE_D(_EXPR_, _MODULE_, "creando comando, ");			\
+	DEBUG_TRACE_D(_EXPR_, _MODULE_, "start|");						\
+	DEBUG_TRACE_D(_EXPR_, _MODULE_, "addr|");						\
+	DEBUG_TRACE_D(_EXPR_, _MODULE_, "data|");						\
+	DEBUG_TRACE_D(_EXPR_, _MODULE_, "stop");						\
+	DEBUG_TRACE_D(_EXPR_, _MODULE_, "(starting...)");				\
+	DEBUG_TRACE_D(_EXPR_, _MODULE_, "result %d, ", ret);			\
+	DEBUG_TRACE_D(_EXPR_, _MODULE_, "OK!");							\
+	DEBUG_TRACE_D(_EXPR_, _MODULE_, "%d", length);					\
+	DEBUG_TRACE_D(_EXPR_, _MODULE_, "%d", ret);
+
+#define _LEVEL_	ESP_LOG_VERBOSE
+static void __attribute__((noinline)) tracesCompiled(int length){
+	I2C_WRITE_TRACES(length, 0);
+}
+#undef _LEVEL_
+
+#define _LEVEL_	ESP_LOG_INFO
+static void __attribute__((noinline)) tracesRemoved(int length){
+	I2C_WRITE_TRACES(length, 0);
+}
+#undef _LEVEL_
+
+static uint32_t measure(void (*func)(int)){
+	static const int Calls = 100;
+	uint32_t t0 = xthal_get_ccount();
+	for(int i = 0; i < Calls; i++){
+		func(i);
+	}
+	return (xthal_get_ccount() - t0) / Calls;
+}
+
+
+//---------------------------------------------------------------------------
+TEST_CASE("TEST_TraceLevel_i2c_write", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    TEST_ASSERT_TRUE(DEBUG_TRACE_ENABLED(ESP_LOG_ERROR));
+    TEST_ASSERT_TRUE(DEBUG_TRACE_ENABLED(ESP_LOG_INFO | TraceLog::LocalFlag) == (ESP_LOG_INFO <= MBED_TRACE_LEVEL));
+
+    // configuración por defecto: flag de depuración desactivado
+    _debug = false;
+    uint32_t removed = measure(tracesRemoved);
+    uint32_t compiled = measure(tracesCompiled);
+    // depuración activada en ejecución, filtrada por el nivel de esp_log del tag
+    _debug = true;
+    uint32_t removed_dbg = measure(tracesRemoved);
+    uint32_t compiled_dbg = measure(tracesCompiled);
+    _debug = false;
+
+    DEBUG_TRACE_I(true, _MODULE_, "Ciclos de las trazas de I2C::write. Flag off: compiladas %d, eliminadas %d. Flag on: compiladas %d, eliminadas %d",
+    		compiled, removed, compiled_dbg, removed_dbg);
+    TEST_ASSERT_TRUE(removed <= compiled);
+    TEST_ASSERT_TRUE(removed_dbg < compiled_dbg);
+}
+
+
+//---------------------------------------------------------------------------
+/** La expresión de la traza se evalúa una única vez, también mientras otra traza está en curso ('_busy') */
+static int evaluations = 0;
+static bool countEvaluation(){
+	evaluations++;
+	return true;
+}
+
+TEST_CASE("TEST_TraceLevel_single_evaluation", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    evaluations = 0;
+    DEBUG_TRACE_E(countEvaluation(), _MODULE_, "evaluación %d", evaluations);
+    TEST_ASSERT_EQUAL(1, evaluations);
+#if !MBED_TRACE_DEFERRED
+    TraceLog::Stats_t stats;
+    TraceLog::resetStats();
+    _busy = true;
+    DEBUG_TRACE_E(countEvaluation(), _MODULE_, "descartada");
+    _busy = false;
+    TEST_ASSERT_EQUAL(2, evaluations);
+    TraceLog::getStats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.busy_drops);
+#endif
+}
@@ -0,0 +1,146 @@
+/* test_TraceLog
+
+   Unit test of the deferred trace backend: push cost against a synchronous ESP_LOGI, drop accounting when the ring
+   is full, and timestamp ordering of the records pushed from both cores
+*/
+
+//------------------------------------------------------------------------------------
+//-- REQUIRED HEADERS & COMPONENTS FOR TESTING ---------------------------------------
+//------------------------------------------------------------------------------------
+
+#include "mbed.h"
+#include "TraceLog.h"
+#include "unity.h"
+#include "AppConfig.h"
+#include <xtensa/hal.h>
+static const char* _MODULE_ = "[TEST_TraceLog]";
+#define _EXPR_	(true)
+static bool _prerequisites_done=false;
+static void executePrerequisites(){
+	if(!_prerequisites_done){
+		_prerequisites_done=true;
+		esp_log_level_set(_MODULE_, ESP_LOG_DEBUG);
+		Ticker_HAL::start();
+		TraceLog::start();
+	}
+}
+
+static const char* _TAG_ = "[TraceLogSeq]";
+
+
+//---------------------------------------------------------------------------
+/** Captura la salida de esp_log y comprueba el orden de las trazas de _TAG_ */
+static volatile int captured = 0;
+static volatile int unordered = 0;
+static int last_seq = -1;
+static int captureLog(const char* fmt, va_list args){
+	char line[TraceLog::MaxLineLength + 64];
+	vsnprintf(line, sizeof(line), fmt, args);
+	const char* p = strstr(line, "seq=");
+	if(!strstr(line, _TAG_) || !p){
+		return 0;
+	}
+	int seq = atoi(p + 4);
+	if(seq <= last_seq){
+		unordered++;
+	}
+	last_seq = seq;
+	captured++;
+	return 0;
+}
+
+
+//---------------------------------------------------------------------------
+TEST_CASE("TEST_TraceLog_push_cost", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    static const int Calls = 20;
+    TraceLog::flush();
+    TraceLog::resetStats();
+    uint32_t t0 = xthal_get_ccount();
+    for(int i = 0; i < Calls; i++){
+    	TraceLog::push(ESP_LOG_INFO, _MODULE_, "push %d de %s, valor=%.2f", i, "test", 1.5);
+    }
+    uint32_t deferred = (xthal_get_ccount() - t0) / Calls;
+    TraceLog::flush();
+
+    t0 = xthal_get_ccount();
+    for(int i = 0; i < Calls; i++){
+    	ESP_LOGI(_MODULE_, "sync %d de %s, valor=%.2f", i, "test", 1.5);
+    }
+    uint32_t sync = (xthal_get_ccount() - t0) / Calls;
+
+    TraceLog::Stats_t stats;
+    TraceLog::getStats(&stats);
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Ciclos por traza: diferida %d (max %d), ESP_LOGI %d", deferred, stats.push_cycles_max, sync);
+    TEST_ASSERT_EQUAL(Calls, stats.pushed);
+    TEST_ASSERT_EQUAL(0, stats.dropped);
+    TEST_ASSERT_TRUE(stats.emitted >= Calls);
+    TEST_ASSERT_TRUE(deferred < sync);
+}
+
+
+//---------------------------------------------------------------------------
+TEST_CASE("TEST_TraceLog_drops", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    // muchas más trazas de las que caben en el buffer, sin ceder el procesador al emisor
+    static const int Calls = 4 * TraceLog::RingSize / 32;
+    TraceLog::flush();
+    TraceLog::resetStats();
+    for(int i = 0; i < Calls; i++){
+    	TraceLog::push(ESP_LOG_DEBUG | TraceLog::LocalFlag, _MODULE_, "relleno %d %s", i, "0123456789abcdefghijklmnopqrstuvwxyz");
+    }
+    TraceLog::Stats_t stats;
+    TraceLog::getStats(&stats);
+    TEST_ASSERT_EQUAL(Calls, stats.pushed + stats.dropped);
+    TEST_ASSERT_TRUE(stats.dropped > 0);
+    TEST_ASSERT_EQUAL(Calls, stats.truncated + stats.dropped);
+    TEST_ASSERT_TRUE(stats.max_used <= TraceLog::RingSize);
+    TraceLog::flush();
+    TraceLog::getStats(&stats);
+    TEST_ASSERT_EQUAL(stats.pushed, stats.emitted);
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Registradas %d, descartadas %d, ocupación máxima %d bytes", stats.pushed, stats.dropped, stats.max_used);
+}
+
+
+//---------------------------------------------------------------------------
+/** Trazas numeradas desde ambos cores: se emiten en el orden en que se registraron */
+static volatile int seq_next = 0;
+static volatile int seq_done = 0;
+static void seqTask(void*){
+	for(int i = 0; i < 50; i++){
+		// el número y el registro se toman con las interrupciones enmascaradas, para que el orden de la numeración
+		// sea el de las marcas de tiempo
+		uint32_t state = portENTER_CRITICAL_NESTED();
+		int seq = __atomic_fetch_add(&seq_next, 1, __ATOMIC_SEQ_CST);
+		TraceLog::push(ESP_LOG_INFO | TraceLog::LocalFlag, _TAG_, "seq=%d", seq);
+		portEXIT_CRITICAL_NESTED(state);
+		Thread::wait(1);
+	}
+	__atomic_add_fetch(&seq_done, 1, __ATOMIC_SEQ_CST);
+	vTaskDelete(NULL);
+}
+
+TEST_CASE("TEST_TraceLog_order", "[mbed_api_esp32]") {
+    executePrerequisites();
+
+    TraceLog::flush();
+    captured = 0;
+    unordered = 0;
+    last_seq = -1;
+    seq_next = 0;
+    seq_done = 0;
+    vprintf_like_t prev = esp_log_set_vprintf(captureLog);
+    for(int i = 0; i < portNUM_PROCESSORS; i++){
+    	TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(seqTask, "seq", OS_STACK_SIZE, NULL, osPriorityNormal, NULL, i));
+    }
+    while(seq_done < portNUM_PROCESSORS){
+    	Thread::wait(10);
+    }
+    TraceLog::flush();
+    esp_log_set_vprintf(prev);
+    DEBUG_TRACE_I(_EXPR_, _MODULE_, "Capturadas %d de %d trazas", captured, seq_next);
+    TEST_ASSERT_EQUAL(seq_next, captured);
+    TEST_ASSERT_EQUAL(0, unordered);
+}